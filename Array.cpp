@@ -1,11 +1,20 @@
+#pragma once
+
 #include <memory>
 
+#include "Check.hpp"
 #include "Exception.hpp"
+#include "Find.hpp"
+#include "Serialize.hpp"
+#include "Stats.hpp"
+#include "Storage.hpp"
 
 
 namespace siilib {
-template<typename T>
-class Array {
+// Storage - стратегия выделения памяти под элементы (Storage.hpp, HugePageStorage.hpp),
+// CheckPolicy - проверки индексов (Check.hpp)
+template<typename T, typename Storage = HeapStorage, typename CheckPolicy = Checked>
+class Array : public _Stats {
     T* data{nullptr};
     size_t length{0};
 
@@ -13,7 +22,8 @@ class Array {
     template <typename U>
     T& _insert(int index, U&& x) {
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        this->_stat_moved(length - 1 - index);
         for(size_t i = length-1; i > static_cast<size_t>(index); --i) {
             data[i] = std::move(data[i-1]);
         }
@@ -22,35 +32,42 @@ class Array {
 
 
 public:
+    static constexpr int npos = -1;
+
     Array(size_t length) {
         try{ 
-            data = new T[length];
+            data = Storage::template allocate<T>(length);
             this->length = length;
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(length * sizeof(T));
     }
     Array(T ar[], size_t len, size_t length=0) {
         try {
             size_t tmp_length = length ? length : len;
-            data = new T[tmp_length];
+            data = Storage::template allocate<T>(tmp_length);
             this->length = tmp_length;
             for(size_t i = 0; i < len && i < tmp_length; ++i) {
                 data[i] = ar[i];
             }
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(this->length * sizeof(T));
+        this->_stat_copied(len < this->length ? len : this->length);
     }
-    Array(const Array<T>& right) {
+    Array(const Array& right) : _Stats() {
         try {
-            this->data = new T[right.length];
+            this->data = Storage::template allocate<T>(right.length);
             this->length = right.length;
             for(size_t i = 0; i < length; ++i) {
                 this->data[i] = right.data[i];
             }
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(length * sizeof(T));
+        this->_stat_copied(length);
     }
-    Array(Array<T>&& right) noexcept {
+    Array(Array&& right) noexcept {
         this->length = right.length;
         this->data = right.data;
         right.length = 0;
@@ -59,7 +76,7 @@ public:
     Array(std::initializer_list<T> ar, size_t length=0) {
         try {
             size_t tmp_length = length ? length : ar.size();
-            data = new T[tmp_length];
+            data = Storage::template allocate<T>(tmp_length);
             this->length = tmp_length;
             size_t i = 0;
             for (const T& val : ar) {
@@ -68,9 +85,12 @@ public:
             }
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(this->length * sizeof(T));
+        this->_stat_copied(ar.size() < this->length ? ar.size() : this->length);
     }
     ~Array() {
-        delete[] data;
+        if(data) this->_stat_free(length * sizeof(T));
+        Storage::deallocate(data, length);
         data = nullptr;
         length = 0;
     }
@@ -88,8 +108,9 @@ public:
     }
     T erase(int index) {
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         T tmp = std::move(data[index]);
+        this->_stat_moved(length - 1 - index);
         for(size_t i = index; i < length - 1; ++i) {
             data[i] = std::move(data[i+1]);
         }
@@ -100,6 +121,7 @@ public:
     void remove(const T& key) {
         for(size_t i = 0; i < length; ++i) {
             if(data[i] == key) {
+                this->_stat_moved(length - 1 - i);
                 for(size_t j = i; j < length - 1; ++j) {
                     data[j] = std::move(data[j+1]);
                 }
@@ -109,47 +131,83 @@ public:
         throw KeyError();
     }
 
-    int find(const T& key) {
-        for(size_t i = 0; i < length; ++i) {
-            if(data[i] == key) return i;
-        }
-        throw KeyError();
+    int find(const T& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
     }
-    int rfind(const T& key) {
-        for(int i = static_cast<int>(length)-1; i >= 0; --i) {
-            if(data[i] == key) return i;
-        }
-        throw KeyError();
+    int rfind(const T& key) const {
+        int index = try_rfind(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const T& key) const {
+        const T* pos = _find(data, data + length, key);
+        return pos == data + length ? npos : static_cast<int>(pos - data);
+    }
+    int try_rfind(const T& key) const {
+        const T* pos = _rfind(data, data + length, key);
+        return pos == data + length ? npos : static_cast<int>(pos - data);
     }
 
     T& operator[](int index) {
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         return data[index];
     }
     const T& operator[](int index) const { 
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         return data[index];
     }
+    T* begin() { return data; }
+    T* end() { return data + length; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + length; }
+
+    T* get(int index) {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return data + index;
+    }
+    const T* get(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return data + index;
+    }
+
+    // Двоичное сохранение (Serialize.hpp): в поток или файловый дескриптор, тривиально копируемые элементы - одним блоком
+    void save(Writer out) const {
+        out.write_header<T>(length);
+        out.write_elements(data, length);
+        out.flush();
+    }
+    static Array load(Reader in) {
+        size_t len = in.read_header<T>();
+        Array res(len);
+        in.read_elements(res.data, len);
+        return res;
+    }
 
-    Array<T>& operator=(const Array<T>& right) {
+    Array& operator=(const Array& right) {
         if(&right == this) return *this;
+        this->_stat_copied(length < right.length ? length : right.length);
         for(size_t i = 0; i < length && i < right.length; ++i) {
             this->data[i] = right.data[i];
         }
         return *this;
     }
-    Array<T>& operator=(Array<T>&& right) noexcept {
+    Array& operator=(Array&& right) noexcept {
         if(&right == this) return *this;
-        delete[] data;
+        if(data) this->_stat_free(length * sizeof(T));
+        Storage::deallocate(data, length);
         this->data = right.data;
         this->length = right.length;
         right.length = 0;
         right.data = nullptr;
         return *this;
     }
-    Array<T>& operator=(std::initializer_list<T> ar) {
+    Array& operator=(std::initializer_list<T> ar) {
         size_t i = 0;
         for (const T& val : ar) {
             if(i == length) break;
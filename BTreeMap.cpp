@@ -0,0 +1,743 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <utility>
+
+#include "Exception.hpp"
+#include "Stats.hpp"
+
+
+#define BTREE_NODE_BYTES 256
+
+
+namespace siilib {
+// B+-дерево: ключи и значения хранятся только в листьях, листья связаны в список для обхода по порядку.
+// Внутренние узлы хранят число элементов в каждом поддереве, что дает доступ по позиции за O(log n).
+template <typename K, typename V, typename Compare = std::less<K>>
+class BTreeMap : public _Stats {
+    static constexpr int NODE_SLOTS = BTREE_NODE_BYTES / sizeof(K) > 8 ? BTREE_NODE_BYTES / sizeof(K) : 8;
+    static constexpr int LEAF_SLOTS = NODE_SLOTS;
+    static constexpr int INNER_SLOTS = NODE_SLOTS;
+    static constexpr int LEAF_MIN = LEAF_SLOTS / 2;
+    static constexpr int INNER_MIN = (INNER_SLOTS + 1) / 2 - 1;
+
+    struct Node {
+        bool leaf;
+        int length{0};
+
+        Node(bool leaf) : leaf(leaf) { }
+    };
+
+    struct Leaf : Node {
+        K keys[LEAF_SLOTS];
+        V values[LEAF_SLOTS];
+        Leaf* prev{nullptr};
+        Leaf* next{nullptr};
+
+        Leaf() : Node(true) { }
+    };
+
+    // keys[i] разделяет children[i] и children[i+1]: ключи слева меньше keys[i], справа - не меньше
+    struct Inner : Node {
+        K keys[INNER_SLOTS];
+        Node* children[INNER_SLOTS + 1];
+        size_t counts[INNER_SLOTS + 1];
+
+        Inner() : Node(false) { }
+    };
+
+    Node* root{nullptr};
+    Leaf* first{nullptr};
+    Leaf* last{nullptr};
+    size_t length{0};
+    Compare comp;
+
+
+    static Leaf* _leaf(Node* node) { return static_cast<Leaf*>(node); }
+    static Inner* _inner(Node* node) { return static_cast<Inner*>(node); }
+
+    int _lower(const K* keys, int n, const K& key) const {
+        int lo = 0;
+        while(n > 0) {
+            int half = n / 2;
+            if(comp(keys[lo + half], key)) {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else n = half;
+        }
+        return lo;
+    }
+    int _upper(const K* keys, int n, const K& key) const {
+        int lo = 0;
+        while(n > 0) {
+            int half = n / 2;
+            if(!comp(key, keys[lo + half])) {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else n = half;
+        }
+        return lo;
+    }
+
+    static size_t _count(Node* node) {
+        if(node->leaf) return node->length;
+        size_t res = 0;
+        for(int i = 0; i <= node->length; ++i) res += _inner(node)->counts[i];
+        return res;
+    }
+
+    Leaf* _new_leaf() {
+        Leaf* leaf = new Leaf();
+        this->_stat_alloc(sizeof(Leaf));
+        return leaf;
+    }
+    Inner* _new_inner() {
+        Inner* inner = new Inner();
+        this->_stat_alloc(sizeof(Inner));
+        return inner;
+    }
+    void _free(Node* node) {
+        if(node->leaf) {
+            this->_stat_free(sizeof(Leaf));
+            delete _leaf(node);
+        }
+        else {
+            this->_stat_free(sizeof(Inner));
+            delete _inner(node);
+        }
+    }
+
+    void _destroy(Node* node) {
+        if(!node) return;
+        if(!node->leaf) {
+            for(int i = 0; i <= node->length; ++i) _destroy(_inner(node)->children[i]);
+        }
+        _free(node);
+    }
+
+    // Копия поддерева; при исключении (память, копирование ключа или значения) уже созданные узлы копии освобождаются
+    Node* _clone(Node* node, Leaf*& prev) {
+        Node* res = nullptr;
+        int cloned = 0;
+        auto undo = [&]() {
+            for(int i = 0; i < cloned; ++i) _destroy(_inner(res)->children[i]);
+            if(res) _free(res);
+        };
+        try {
+            if(node->leaf) {
+                Leaf* src = _leaf(node);
+                Leaf* leaf = _new_leaf();
+                res = leaf;
+                for(int i = 0; i < src->length; ++i) {
+                    leaf->keys[i] = src->keys[i];
+                    leaf->values[i] = src->values[i];
+                }
+                leaf->length = src->length;
+                leaf->prev = prev;
+                if(prev) prev->next = leaf;
+                else first = leaf;
+                prev = leaf;
+                return leaf;
+            }
+            Inner* src = _inner(node);
+            Inner* inner = _new_inner();
+            res = inner;
+            for(int i = 0; i <= src->length; ++i) {
+                if(i < src->length) inner->keys[i] = src->keys[i];
+                inner->children[i] = _clone(src->children[i], prev);
+                cloned++;
+                inner->counts[i] = src->counts[i];
+                inner->length = i;
+            }
+            return inner;
+        }
+        catch(std::bad_alloc&) { undo(); throw AllocError(); }
+        catch(...) { undo(); throw; }
+    }
+
+    // Копия right строится рядом и заменяет дерево только целиком: при исключении старое дерево остается
+    void _copy_from(const BTreeMap& right) {
+        Node* old_root = root;
+        Leaf* old_first = first;
+        Leaf* prev = nullptr;
+        try { root = _clone(right.root, prev); }
+        catch(...) {
+            root = old_root;
+            first = old_first;
+            throw;
+        }
+        _destroy(old_root);
+        last = prev;
+        length = right.length;
+    }
+
+    // Лист и позиция первого ключа не меньше key
+    void _lower_bound(const K& key, Leaf*& leaf, int& index) const {
+        Node* node = root;
+        while(!node->leaf) node = _inner(node)->children[_upper(_inner(node)->keys, node->length, key)];
+        leaf = _leaf(node);
+        index = _lower(leaf->keys, leaf->length, key);
+        if(index == leaf->length && leaf->next) {
+            leaf = leaf->next;
+            index = 0;
+        }
+    }
+
+    void _at_index(size_t index, Leaf*& leaf, int& pos) const {
+        Node* node = root;
+        while(!node->leaf) {
+            Inner* inner = _inner(node);
+            int c = 0;
+            while(index >= inner->counts[c]) index -= inner->counts[c++];
+            node = inner->children[c];
+        }
+        leaf = _leaf(node);
+        pos = static_cast<int>(index);
+    }
+
+    size_t _normalize(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        return index;
+    }
+
+    template <typename KK, typename VV>
+    void _leaf_insert(Leaf* leaf, int i, KK&& key, VV&& value) {
+        for(int j = leaf->length; j > i; --j) {
+            leaf->keys[j] = std::move(leaf->keys[j-1]);
+            leaf->values[j] = std::move(leaf->values[j-1]);
+        }
+        leaf->keys[i] = std::forward<KK>(key);
+        leaf->values[i] = std::forward<VV>(value);
+        leaf->length++;
+    }
+
+    static void _inner_insert(Inner* inner, int i, const K& key, Node* child) {
+        for(int j = inner->length; j > i; --j) {
+            inner->keys[j] = std::move(inner->keys[j-1]);
+            inner->children[j+1] = inner->children[j];
+            inner->counts[j+1] = inner->counts[j];
+        }
+        inner->keys[i] = key;
+        inner->children[i+1] = child;
+        inner->counts[i+1] = _count(child);
+        inner->length++;
+    }
+
+    // Вставляет пару в поддерево node. При переполнении node делится, правая половина и ее
+    // минимальный ключ возвращаются через split и split_key. Возвращает false, если ключ уже был.
+    template <typename KK, typename VV>
+    bool _insert(Node* node, KK&& key, VV&& value, bool assign, K& split_key, Node*& split) {
+        split = nullptr;
+        if(node->leaf) {
+            Leaf* leaf = _leaf(node);
+            int i = _lower(leaf->keys, leaf->length, key);
+            if(i < leaf->length && !comp(key, leaf->keys[i])) {
+                if(assign) leaf->values[i] = std::forward<VV>(value);
+                return false;
+            }
+            if(leaf->length < LEAF_SLOTS) {
+                _leaf_insert(leaf, i, std::forward<KK>(key), std::forward<VV>(value));
+                return true;
+            }
+            Leaf* right;
+            try { right = _new_leaf(); }
+            catch(std::bad_alloc&) { throw AllocError(); }
+            int mid = LEAF_SLOTS / 2;
+            for(int j = mid; j < LEAF_SLOTS; ++j) {
+                right->keys[j - mid] = std::move(leaf->keys[j]);
+                right->values[j - mid] = std::move(leaf->values[j]);
+            }
+            right->length = LEAF_SLOTS - mid;
+            leaf->length = mid;
+            right->next = leaf->next;
+            right->prev = leaf;
+            if(leaf->next) leaf->next->prev = right;
+            else last = right;
+            leaf->next = right;
+            if(i <= mid) _leaf_insert(leaf, i, std::forward<KK>(key), std::forward<VV>(value));
+            else _leaf_insert(right, i - mid, std::forward<KK>(key), std::forward<VV>(value));
+            split = right;
+            split_key = right->keys[0];
+            return true;
+        }
+
+        Inner* inner = _inner(node);
+        int c = _upper(inner->keys, inner->length, key);
+        K child_key;
+        Node* child_split;
+        if(!_insert(inner->children[c], std::forward<KK>(key), std::forward<VV>(value), assign, child_key, child_split)) return false;
+        if(!child_split) {
+            inner->counts[c]++;
+            return true;
+        }
+        inner->counts[c] = _count(inner->children[c]);
+        if(inner->length < INNER_SLOTS) {
+            _inner_insert(inner, c, child_key, child_split);
+            return true;
+        }
+        Inner* right;
+        try { right = _new_inner(); }
+        catch(std::bad_alloc&) { throw AllocError(); }
+        int mid = INNER_SLOTS / 2;
+        split_key = std::move(inner->keys[mid]);
+        for(int j = mid + 1; j < INNER_SLOTS; ++j) right->keys[j - mid - 1] = std::move(inner->keys[j]);
+        for(int j = mid + 1; j <= INNER_SLOTS; ++j) {
+            right->children[j - mid - 1] = inner->children[j];
+            right->counts[j - mid - 1] = inner->counts[j];
+        }
+        right->length = INNER_SLOTS - mid - 1;
+        inner->length = mid;
+        if(c <= mid) _inner_insert(inner, c, child_key, child_split);
+        else _inner_insert(right, c - mid - 1, child_key, child_split);
+        split = right;
+        return true;
+    }
+
+    template <typename KK, typename VV>
+    bool _insert_root(KK&& key, VV&& value, bool assign) {
+        K split_key;
+        Node* split;
+        if(!_insert(root, std::forward<KK>(key), std::forward<VV>(value), assign, split_key, split)) return false;
+        length++;
+        if(split) {
+            Inner* new_root;
+            try { new_root = _new_inner(); }
+            catch(std::bad_alloc&) { throw AllocError(); }
+            new_root->keys[0] = std::move(split_key);
+            new_root->children[0] = root;
+            new_root->children[1] = split;
+            new_root->counts[0] = _count(root);
+            new_root->counts[1] = _count(split);
+            new_root->length = 1;
+            root = new_root;
+        }
+        return true;
+    }
+
+    bool _underflow(Node* node) const {
+        return node->leaf ? node->length < LEAF_MIN : node->length < INNER_MIN;
+    }
+
+    void _merge(Inner* parent, int i) {
+        Node* left = parent->children[i];
+        Node* right = parent->children[i+1];
+        if(left->leaf) {
+            Leaf* l = _leaf(left);
+            Leaf* r = _leaf(right);
+            for(int j = 0; j < r->length; ++j) {
+                l->keys[l->length + j] = std::move(r->keys[j]);
+                l->values[l->length + j] = std::move(r->values[j]);
+            }
+            l->length += r->length;
+            l->next = r->next;
+            if(r->next) r->next->prev = l;
+            else last = l;
+            _free(r);
+        }
+        else {
+            Inner* l = _inner(left);
+            Inner* r = _inner(right);
+            l->keys[l->length] = std::move(parent->keys[i]);
+            for(int j = 0; j < r->length; ++j) l->keys[l->length + 1 + j] = std::move(r->keys[j]);
+            for(int j = 0; j <= r->length; ++j) {
+                l->children[l->length + 1 + j] = r->children[j];
+                l->counts[l->length + 1 + j] = r->counts[j];
+            }
+            l->length += r->length + 1;
+            _free(r);
+        }
+        parent->counts[i] += parent->counts[i+1];
+        for(int j = i; j < parent->length - 1; ++j) {
+            parent->keys[j] = std::move(parent->keys[j+1]);
+            parent->children[j+1] = parent->children[j+2];
+            parent->counts[j+1] = parent->counts[j+2];
+        }
+        parent->length--;
+    }
+
+    // Переносит один элемент из children[i] в children[i+1] (to_right) или обратно
+    void _rotate(Inner* parent, int i, bool to_right) {
+        Node* left = parent->children[i];
+        Node* right = parent->children[i+1];
+        size_t moved = 1;
+        if(left->leaf) {
+            Leaf* l = _leaf(left);
+            Leaf* r = _leaf(right);
+            if(to_right) {
+                _leaf_insert(r, 0, std::move(l->keys[l->length-1]), std::move(l->values[l->length-1]));
+                l->length--;
+            }
+            else {
+                _leaf_insert(l, l->length, std::move(r->keys[0]), std::move(r->values[0]));
+                for(int j = 0; j < r->length - 1; ++j) {
+                    r->keys[j] = std::move(r->keys[j+1]);
+                    r->values[j] = std::move(r->values[j+1]);
+                }
+                r->length--;
+            }
+            parent->keys[i] = r->keys[0];
+        }
+        else {
+            Inner* l = _inner(left);
+            Inner* r = _inner(right);
+            if(to_right) {
+                moved = l->counts[l->length];
+                for(int j = r->length; j > 0; --j) r->keys[j] = std::move(r->keys[j-1]);
+                for(int j = r->length + 1; j > 0; --j) {
+                    r->children[j] = r->children[j-1];
+                    r->counts[j] = r->counts[j-1];
+                }
+                r->keys[0] = std::move(parent->keys[i]);
+                r->children[0] = l->children[l->length];
+                r->counts[0] = moved;
+                r->length++;
+                parent->keys[i] = std::move(l->keys[l->length-1]);
+                l->length--;
+            }
+            else {
+                moved = r->counts[0];
+                l->keys[l->length] = std::move(parent->keys[i]);
+                l->children[l->length+1] = r->children[0];
+                l->counts[l->length+1] = moved;
+                l->length++;
+                parent->keys[i] = std::move(r->keys[0]);
+                for(int j = 0; j < r->length - 1; ++j) r->keys[j] = std::move(r->keys[j+1]);
+                for(int j = 0; j < r->length; ++j) {
+                    r->children[j] = r->children[j+1];
+                    r->counts[j] = r->counts[j+1];
+                }
+                r->length--;
+            }
+        }
+        if(to_right) {
+            parent->counts[i] -= moved;
+            parent->counts[i+1] += moved;
+        }
+        else {
+            parent->counts[i] += moved;
+            parent->counts[i+1] -= moved;
+        }
+    }
+
+    void _rebalance(Inner* parent, int c) {
+        if(c > 0 && !_underflow_after_take(parent->children[c-1])) _rotate(parent, c - 1, true);
+        else if(c < parent->length && !_underflow_after_take(parent->children[c+1])) _rotate(parent, c, false);
+        else if(c > 0) _merge(parent, c - 1);
+        else _merge(parent, c);
+    }
+
+    bool _underflow_after_take(Node* node) const {
+        return node->leaf ? node->length - 1 < LEAF_MIN : node->length - 1 < INNER_MIN;
+    }
+
+    bool _erase(Node* node, const K& key) {
+        if(node->leaf) {
+            Leaf* leaf = _leaf(node);
+            int i = _lower(leaf->keys, leaf->length, key);
+            if(i == leaf->length || comp(key, leaf->keys[i])) return false;
+            for(int j = i; j < leaf->length - 1; ++j) {
+                leaf->keys[j] = std::move(leaf->keys[j+1]);
+                leaf->values[j] = std::move(leaf->values[j+1]);
+            }
+            leaf->keys[leaf->length-1] = K();
+            leaf->values[leaf->length-1] = V();
+            leaf->length--;
+            return true;
+        }
+        Inner* inner = _inner(node);
+        int c = _upper(inner->keys, inner->length, key);
+        if(!_erase(inner->children[c], key)) return false;
+        inner->counts[c]--;
+        if(_underflow(inner->children[c])) _rebalance(inner, c);
+        return true;
+    }
+
+    bool _erase_root(const K& key) {
+        if(!_erase(root, key)) return false;
+        length--;
+        if(!root->leaf && root->length == 0) {
+            Inner* old = _inner(root);
+            root = old->children[0];
+            _free(old);
+        }
+        return true;
+    }
+
+
+    template <typename E, typename L>
+    class _Iterator {
+        L* leaf;
+        int index;
+    public:
+        _Iterator(L* leaf, int index) : leaf(leaf), index(index) { }
+
+        E operator*() const { return E{leaf->keys[index], leaf->values[index]}; }
+        const K& key() const { return leaf->keys[index]; }
+        decltype(std::declval<E>().value) value() const { return leaf->values[index]; }
+
+        _Iterator& operator++() {
+            if(++index == leaf->length && leaf->next) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+        bool operator==(const _Iterator& right) const { return leaf == right.leaf && index == right.index; }
+        bool operator!=(const _Iterator& right) const { return !(*this == right); }
+    };
+
+    template <typename It>
+    class _Range {
+        It b, e;
+    public:
+        _Range(It b, It e) : b(b), e(e) { }
+        It begin() const { return b; }
+        It end() const { return e; }
+    };
+
+
+public:
+    struct Entry {
+        const K& key;
+        V& value;
+    };
+    struct ConstEntry {
+        const K& key;
+        const V& value;
+    };
+
+    using Iterator = _Iterator<Entry, Leaf>;
+    using ConstIterator = _Iterator<ConstEntry, const Leaf>;
+
+    static constexpr int npos = -1;
+
+    BTreeMap(const Compare& comp=Compare()) : comp(comp) {
+        try { root = first = last = _new_leaf(); }
+        catch(std::bad_alloc&) { throw AllocError(); }
+    }
+    BTreeMap(const K* keys, const V* values, size_t len, const Compare& comp=Compare()) : BTreeMap(comp) {
+        this->bulk_load(keys, values, len);
+    }
+    BTreeMap(const BTreeMap& right) : _Stats(), comp(right.comp) {
+        _copy_from(right);
+    }
+    BTreeMap(BTreeMap&& right) : BTreeMap(right.comp) {
+        std::swap(root, right.root);
+        std::swap(first, right.first);
+        std::swap(last, right.last);
+        std::swap(length, right.length);
+    }
+    BTreeMap(std::initializer_list<std::pair<K, V>> ar, const Compare& comp=Compare()) : BTreeMap(comp) {
+        for(const auto& x : ar) this->insert(x.first, x.second);
+    }
+    ~BTreeMap() {
+        _destroy(root);
+    }
+
+    void clear() {
+        _destroy(root);
+        try { root = first = last = _new_leaf(); }
+        catch(std::bad_alloc&) { root = first = last = nullptr; throw AllocError(); }
+        length = 0;
+    }
+
+    // Построение за O(n) из строго возрастающих ключей; узлы заполняются равномерно
+    void bulk_load(const K* keys, const V* values, size_t len) {
+        for(size_t i = 1; i < len; ++i) {
+            if(!comp(keys[i-1], keys[i])) throw ValueError();
+        }
+        this->clear();
+        if(len == 0) return;
+        size_t count = (len + LEAF_SLOTS - 1) / LEAF_SLOTS;
+        Node** level = nullptr;
+        K* mins = nullptr;
+        try {
+            level = new Node*[count];
+            mins = new K[count];
+            _free(root);
+            root = nullptr;
+            Leaf* prev = nullptr;
+            for(size_t n = 0, pos = 0; n < count; ++n) {
+                Leaf* leaf = _new_leaf();
+                size_t take = len / count + (n < len % count);
+                for(size_t j = 0; j < take; ++j, ++pos) {
+                    leaf->keys[j] = keys[pos];
+                    leaf->values[j] = values[pos];
+                }
+                leaf->length = static_cast<int>(take);
+                leaf->prev = prev;
+                if(prev) prev->next = leaf;
+                else first = leaf;
+                prev = leaf;
+                level[n] = leaf;
+                mins[n] = leaf->keys[0];
+            }
+            last = prev;
+            while(count > 1) {
+                size_t parents = (count + INNER_SLOTS) / (INNER_SLOTS + 1);
+                for(size_t n = 0, pos = 0; n < parents; ++n) {
+                    Inner* inner = _new_inner();
+                    size_t take = count / parents + (n < count % parents);
+                    K min = mins[pos];
+                    for(size_t j = 0; j < take; ++j, ++pos) {
+                        inner->children[j] = level[pos];
+                        inner->counts[j] = _count(level[pos]);
+                        if(j > 0) inner->keys[j-1] = mins[pos];
+                    }
+                    inner->length = static_cast<int>(take) - 1;
+                    level[n] = inner;
+                    mins[n] = min;
+                }
+                count = parents;
+            }
+            root = level[0];
+        }
+        catch(std::bad_alloc&) {
+            delete[] level;
+            delete[] mins;
+            root = nullptr;
+            this->clear();
+            throw AllocError();
+        }
+        length = len;
+        delete[] level;
+        delete[] mins;
+    }
+
+    bool is_empty() const { return length == 0; }
+
+    size_t get_length() const { return length; }
+
+    bool insert(const K& key, const V& value) { return _insert_root(key, value, true); }
+    bool insert(K&& key, V&& value) { return _insert_root(std::move(key), std::move(value), true); }
+
+    void remove(const K& key) {
+        if(!_erase_root(key)) throw KeyError();
+    }
+    bool try_remove(const K& key) {
+        return _erase_root(key);
+    }
+    K erase(int index) {
+        Leaf* leaf;
+        int pos;
+        _at_index(_normalize(index), leaf, pos);
+        K key = leaf->keys[pos];
+        _erase_root(key);
+        return key;
+    }
+
+    bool contains(const K& key) const { return get(key) != nullptr; }
+
+    V* get(const K& key) {
+        Leaf* leaf;
+        int i;
+        _lower_bound(key, leaf, i);
+        if(i == leaf->length || comp(key, leaf->keys[i])) return nullptr;
+        return &leaf->values[i];
+    }
+    const V* get(const K& key) const {
+        return const_cast<BTreeMap*>(this)->get(key);
+    }
+
+    V& at(const K& key) {
+        V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+    const V& at(const K& key) const {
+        const V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+
+    // Число ключей меньше key (позиция key в отсортированном порядке)
+    size_t rank(const K& key) const {
+        size_t res = 0;
+        Node* node = root;
+        while(!node->leaf) {
+            Inner* inner = _inner(node);
+            int c = _upper(inner->keys, inner->length, key);
+            for(int j = 0; j < c; ++j) res += inner->counts[j];
+            node = inner->children[c];
+        }
+        return res + _lower(_leaf(node)->keys, node->length, key);
+    }
+
+    int find(const K& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const K& key) const {
+        return contains(key) ? static_cast<int>(rank(key)) : npos;
+    }
+
+    Entry operator[](int index) {
+        Leaf* leaf;
+        int pos;
+        _at_index(_normalize(index), leaf, pos);
+        return Entry{leaf->keys[pos], leaf->values[pos]};
+    }
+    ConstEntry operator[](int index) const {
+        Leaf* leaf;
+        int pos;
+        _at_index(_normalize(index), leaf, pos);
+        return ConstEntry{leaf->keys[pos], leaf->values[pos]};
+    }
+
+    Entry front() { if(!length) throw EmptyError(); return Entry{first->keys[0], first->values[0]}; }
+    Entry back() { if(!length) throw EmptyError(); return Entry{last->keys[last->length-1], last->values[last->length-1]}; }
+
+    Iterator begin() { return Iterator(first, 0); }
+    Iterator end() { return Iterator(last, last->length); }
+    ConstIterator begin() const { return ConstIterator(first, 0); }
+    ConstIterator end() const { return ConstIterator(last, last->length); }
+
+    Iterator lower_bound(const K& key) {
+        Leaf* leaf;
+        int i;
+        _lower_bound(key, leaf, i);
+        return Iterator(leaf, i);
+    }
+    ConstIterator lower_bound(const K& key) const {
+        Leaf* leaf;
+        int i;
+        _lower_bound(key, leaf, i);
+        return ConstIterator(leaf, i);
+    }
+    Iterator upper_bound(const K& key) {
+        Iterator it = lower_bound(key);
+        if(it != end() && !comp(key, it.key())) ++it;
+        return it;
+    }
+    ConstIterator upper_bound(const K& key) const {
+        ConstIterator it = lower_bound(key);
+        if(it != end() && !comp(key, it.key())) ++it;
+        return it;
+    }
+
+    // Элементы с ключами из полуинтервала [from, to)
+    _Range<Iterator> range(const K& from, const K& to) { return _Range<Iterator>(lower_bound(from), lower_bound(to)); }
+    _Range<ConstIterator> range(const K& from, const K& to) const { return _Range<ConstIterator>(lower_bound(from), lower_bound(to)); }
+
+    BTreeMap& operator=(const BTreeMap& right) {
+        if(&right == this) return *this;
+        _copy_from(right);
+        comp = right.comp;
+        return *this;
+    }
+    BTreeMap& operator=(BTreeMap&& right) {
+        if(&right == this) return *this;
+        std::swap(root, right.root);
+        std::swap(first, right.first);
+        std::swap(last, right.last);
+        std::swap(length, right.length);
+        std::swap(comp, right.comp);
+        return *this;
+    }
+};
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+
+#include "Exception.hpp"
+#include "BTreeMap.cpp"
+
+
+namespace siilib {
+template <typename K, typename Compare = std::less<K>>
+class BTreeSet {
+    struct Empty { };
+
+    using Map = BTreeMap<K, Empty, Compare>;
+
+    Map map;
+
+public:
+    class Iterator {
+        typename Map::ConstIterator it;
+    public:
+        Iterator(typename Map::ConstIterator it) : it(it) { }
+        const K& operator*() const { return it.key(); }
+        const K* operator->() const { return &it.key(); }
+        Iterator& operator++() { ++it; return *this; }
+        bool operator==(const Iterator& right) const { return it == right.it; }
+        bool operator!=(const Iterator& right) const { return it != right.it; }
+    };
+
+    class Range {
+        Iterator b, e;
+    public:
+        Range(Iterator b, Iterator e) : b(b), e(e) { }
+        Iterator begin() const { return b; }
+        Iterator end() const { return e; }
+    };
+
+    static constexpr int npos = -1;
+
+    BTreeSet(const Compare& comp=Compare()) : map(comp) { }
+    BTreeSet(const K* keys, size_t len, const Compare& comp=Compare()) : map(comp) {
+        this->bulk_load(keys, len);
+    }
+    BTreeSet(std::initializer_list<K> ar, const Compare& comp=Compare()) : map(comp) {
+        for(const K& x : ar) this->insert(x);
+    }
+
+    void clear() { map.clear(); }
+
+    void bulk_load(const K* keys, size_t len) {
+        Empty* values;
+        try { values = new Empty[len]; }
+        catch(std::bad_alloc&) { throw AllocError(); }
+        try { map.bulk_load(keys, values, len); }
+        catch(...) {
+            delete[] values;
+            throw;
+        }
+        delete[] values;
+    }
+
+    bool is_empty() const { return map.is_empty(); }
+
+    // Счетчики работы (нулевые без -DSIILIB_STATS)
+    StatsSnapshot get_stats() const { return map.get_stats(); }
+    void reset_stats() { map.reset_stats(); }
+
+    size_t get_length() const { return map.get_length(); }
+
+    bool insert(const K& key) { return map.insert(key, Empty()); }
+    bool insert(K&& key) { return map.insert(std::move(key), Empty()); }
+
+    void remove(const K& key) { map.remove(key); }
+    bool try_remove(const K& key) { return map.try_remove(key); }
+    K erase(int index) { return map.erase(index); }
+
+    bool contains(const K& key) const { return map.contains(key); }
+    size_t rank(const K& key) const { return map.rank(key); }
+    int find(const K& key) const { return map.find(key); }
+    int try_find(const K& key) const { return map.try_find(key); }
+
+    const K& operator[](int index) const { return map[index].key; }
+
+    Iterator begin() const { return Iterator(map.begin()); }
+    Iterator end() const { return Iterator(map.end()); }
+    Iterator lower_bound(const K& key) const { return Iterator(map.lower_bound(key)); }
+    Iterator upper_bound(const K& key) const { return Iterator(map.upper_bound(key)); }
+    Range range(const K& from, const K& to) const { return Range(lower_bound(from), lower_bound(to)); }
+};
+}
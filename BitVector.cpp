@@ -0,0 +1,326 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#include "Exception.hpp"
+
+
+#define BITVECTOR_MIN_CAPACITY 8
+#define BITVECTOR_RANK_BLOCK_WORDS 8
+
+
+namespace siilib {
+// Динамический массив битов, упакованных по 64 в слово.
+// Биты за пределами длины в последнем слове всегда равны нулю, на этом держатся count, flip и поиск.
+// Индексы - size_t: массивы флагов бывают длиннее, чем помещается в int.
+class BitVector {
+    uint64_t* words{nullptr};
+    size_t length{0};
+    size_t capacity{0};
+    // Индекс rank/select: число единиц перед каждым блоком из BITVECTOR_RANK_BLOCK_WORDS слов.
+    // Любое изменение битов делает индекс недействительным.
+    uint64_t* rank_index{nullptr};
+    size_t rank_blocks{0};
+    bool rank_valid{false};
+
+
+    static size_t _words_for(size_t len) { return (len + 63) / 64; }
+
+    static void _zero(uint64_t* ptr, size_t count) {
+        if(count) std::memset(ptr, 0, count * sizeof(uint64_t));
+    }
+    static void _copy(uint64_t* dst, const uint64_t* src, size_t count) {
+        if(count) std::memcpy(dst, src, count * sizeof(uint64_t));
+    }
+
+    static size_t _select_in_word(uint64_t w, size_t k) {
+        for(size_t i = 0; i < k; ++i) w &= w - 1;
+        return __builtin_ctzll(w);
+    }
+
+    void _reserve(size_t need) {
+        if(need <= capacity) return;
+        size_t tmp_capacity = capacity ? capacity : BITVECTOR_MIN_CAPACITY;
+        while(tmp_capacity < need) tmp_capacity *= 2;
+        uint64_t* ptr;
+        try { ptr = new uint64_t[tmp_capacity]; }
+        catch(const std::bad_alloc&) { throw ResizeError(); }
+        _copy(ptr, words, _words_for(length));
+        _zero(ptr + _words_for(length), tmp_capacity - _words_for(length));
+        delete[] words;
+        words = ptr;
+        capacity = tmp_capacity;
+    }
+
+    void _clear_tail() {
+        if(length % 64) words[length / 64] &= (uint64_t(1) << (length % 64)) - 1;
+    }
+
+    void _check(size_t index) const {
+        if(index >= length) throw IndexError();
+    }
+
+    void _check_same_length(const BitVector& right) const {
+        if(length != right.length) throw ValueError();
+    }
+
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    BitVector() = default;
+    BitVector(size_t len, bool value=false) {
+        resize(len, value);
+    }
+    BitVector(std::initializer_list<bool> ar) {
+        _reserve(_words_for(ar.size()));
+        for(bool x : ar) push_back(x);
+    }
+    BitVector(const BitVector& right) {
+        *this = right;
+    }
+    BitVector(BitVector&& right) noexcept {
+        *this = std::move(right);
+    }
+    ~BitVector() {
+        delete[] words;
+        delete[] rank_index;
+    }
+
+    BitVector& operator=(const BitVector& right) {
+        if(this == &right) return *this;
+        uint64_t* ptr;
+        try { ptr = new uint64_t[right.capacity ? right.capacity : 1]; }
+        catch(const std::bad_alloc&) { throw AllocError(); }
+        _copy(ptr, right.words, right.capacity);
+        delete[] words;
+        words = ptr;
+        length = right.length;
+        capacity = right.capacity;
+        rank_valid = false;
+        return *this;
+    }
+    BitVector& operator=(BitVector&& right) noexcept {
+        if(this == &right) return *this;
+        delete[] words;
+        delete[] rank_index;
+        words = right.words;
+        length = right.length;
+        capacity = right.capacity;
+        rank_index = right.rank_index;
+        rank_blocks = right.rank_blocks;
+        rank_valid = right.rank_valid;
+        right.words = nullptr;
+        right.rank_index = nullptr;
+        right.length = right.capacity = right.rank_blocks = 0;
+        right.rank_valid = false;
+        return *this;
+    }
+
+    void clear() {
+        _zero(words, _words_for(length));
+        length = 0;
+        rank_valid = false;
+    }
+
+    // Новые биты получают значение value
+    void resize(size_t len, bool value=false) {
+        _reserve(_words_for(len));
+        if(len > length) {
+            if(value) {
+                if(length % 64) words[length / 64] |= ~uint64_t(0) << (length % 64);
+                for(size_t i = _words_for(length); i < _words_for(len); ++i) words[i] = ~uint64_t(0);
+            }
+            length = len;
+            _clear_tail();
+        }
+        else {
+            length = len;
+            _clear_tail();
+            _zero(words + _words_for(len), capacity - _words_for(len));
+        }
+        rank_valid = false;
+    }
+
+    size_t get_length() const { return length; }
+    size_t get_capacity() const { return capacity * 64; }
+    // Занимаемая память в байтах вместе с индексом rank/select
+    size_t get_size() const { return capacity * sizeof(uint64_t) + rank_blocks * sizeof(uint64_t); }
+    bool is_empty() const { return length == 0; }
+
+    void push_back(bool x) {
+        if(length % 64 == 0) _reserve(length / 64 + 1);
+        if(x) words[length / 64] |= uint64_t(1) << (length % 64);
+        length++;
+        rank_valid = false;
+    }
+    bool pop_back() {
+        if(length == 0) throw EmptyError();
+        return *try_pop_back();
+    }
+    std::optional<bool> try_pop_back() {
+        if(length == 0) return std::nullopt;
+        length--;
+        uint64_t mask = uint64_t(1) << (length % 64);
+        bool x = words[length / 64] & mask;
+        words[length / 64] &= ~mask;
+        rank_valid = false;
+        return x;
+    }
+
+    bool test(size_t index) const {
+        _check(index);
+        return (words[index / 64] >> (index % 64)) & 1;
+    }
+    bool operator[](size_t index) const { return test(index); }
+
+    void set(size_t index, bool value=true) {
+        _check(index);
+        uint64_t mask = uint64_t(1) << (index % 64);
+        if(value) words[index / 64] |= mask;
+        else words[index / 64] &= ~mask;
+        rank_valid = false;
+    }
+    void reset(size_t index) { set(index, false); }
+    void flip(size_t index) {
+        _check(index);
+        words[index / 64] ^= uint64_t(1) << (index % 64);
+        rank_valid = false;
+    }
+
+    // Побитовые операции над целыми словами; длины операндов должны совпадать
+    BitVector& operator&=(const BitVector& right) {
+        _check_same_length(right);
+        for(size_t i = 0; i < _words_for(length); ++i) words[i] &= right.words[i];
+        rank_valid = false;
+        return *this;
+    }
+    BitVector& operator|=(const BitVector& right) {
+        _check_same_length(right);
+        for(size_t i = 0; i < _words_for(length); ++i) words[i] |= right.words[i];
+        rank_valid = false;
+        return *this;
+    }
+    BitVector& operator^=(const BitVector& right) {
+        _check_same_length(right);
+        for(size_t i = 0; i < _words_for(length); ++i) words[i] ^= right.words[i];
+        rank_valid = false;
+        return *this;
+    }
+    // Инвертирует все биты
+    BitVector& flip() {
+        for(size_t i = 0; i < _words_for(length); ++i) words[i] = ~words[i];
+        _clear_tail();
+        rank_valid = false;
+        return *this;
+    }
+
+    BitVector operator&(const BitVector& right) const { BitVector res(*this); res &= right; return res; }
+    BitVector operator|(const BitVector& right) const { BitVector res(*this); res |= right; return res; }
+    BitVector operator^(const BitVector& right) const { BitVector res(*this); res ^= right; return res; }
+    BitVector operator~() const { BitVector res(*this); res.flip(); return res; }
+
+    bool operator==(const BitVector& right) const {
+        if(length != right.length) return false;
+        for(size_t i = 0; i < _words_for(length); ++i) if(words[i] != right.words[i]) return false;
+        return true;
+    }
+    bool operator!=(const BitVector& right) const { return !(*this == right); }
+
+    // Число единичных битов
+    size_t count() const {
+        size_t res = 0;
+        for(size_t i = 0; i < _words_for(length); ++i) res += __builtin_popcountll(words[i]);
+        return res;
+    }
+    bool any() const {
+        for(size_t i = 0; i < _words_for(length); ++i) if(words[i]) return true;
+        return false;
+    }
+    bool none() const { return !any(); }
+    bool all() const { return count() == length; }
+
+    // Индекс первого единичного бита или npos
+    size_t find_first() const { return find_next(0); }
+    // Индекс первого единичного бита, не меньшего from, или npos
+    size_t find_next(size_t from) const {
+        if(from >= length) return npos;
+        size_t i = from / 64;
+        uint64_t w = words[i] & (~uint64_t(0) << (from % 64));
+        while(true) {
+            if(w) return i * 64 + __builtin_ctzll(w);
+            if(++i >= _words_for(length)) return npos;
+            w = words[i];
+        }
+    }
+
+    // Строит индекс для rank за O(1) и select за O(log n); дополнительная память - 1/8 от битов.
+    // Индекс перестраивается заново после любого изменения.
+    void build_rank_index() {
+        size_t blocks = _words_for(length) / BITVECTOR_RANK_BLOCK_WORDS + 1;
+        if(blocks != rank_blocks) {
+            uint64_t* ptr;
+            try { ptr = new uint64_t[blocks]; }
+            catch(const std::bad_alloc&) { throw AllocError(); }
+            delete[] rank_index;
+            rank_index = ptr;
+            rank_blocks = blocks;
+        }
+        uint64_t acc = 0;
+        for(size_t b = 0; b < blocks; ++b) {
+            rank_index[b] = acc;
+            size_t end = (b + 1) * BITVECTOR_RANK_BLOCK_WORDS;
+            if(end > _words_for(length)) end = _words_for(length);
+            for(size_t i = b * BITVECTOR_RANK_BLOCK_WORDS; i < end; ++i) acc += __builtin_popcountll(words[i]);
+        }
+        rank_valid = true;
+    }
+    bool has_rank_index() const { return rank_valid; }
+
+    // Число единиц в [0, pos). Без действительного индекса - линейный подсчет по словам.
+    size_t rank(size_t pos) const {
+        if(pos > length) throw IndexError();
+        size_t word = pos / 64;
+        size_t res = 0;
+        size_t i = 0;
+        if(rank_valid) {
+            res = rank_index[word / BITVECTOR_RANK_BLOCK_WORDS];
+            i = word / BITVECTOR_RANK_BLOCK_WORDS * BITVECTOR_RANK_BLOCK_WORDS;
+        }
+        for(; i < word; ++i) res += __builtin_popcountll(words[i]);
+        if(pos % 64) res += __builtin_popcountll(words[word] & ((uint64_t(1) << (pos % 64)) - 1));
+        return res;
+    }
+    // Число нулей в [0, pos)
+    size_t rank0(size_t pos) const { return pos - rank(pos); }
+
+    // Индекс k-го (с нуля) единичного бита или npos, если единиц не больше k
+    size_t select(size_t k) const {
+        size_t i = 0;
+        if(rank_valid) {
+            size_t lo = 0;
+            size_t hi = rank_blocks;
+            while(hi - lo > 1) {
+                size_t mid = (lo + hi) / 2;
+                if(rank_index[mid] <= k) lo = mid;
+                else hi = mid;
+            }
+            k -= rank_index[lo];
+            i = lo * BITVECTOR_RANK_BLOCK_WORDS;
+        }
+        for(; i < _words_for(length); ++i) {
+            size_t c = __builtin_popcountll(words[i]);
+            if(k < c) return i * 64 + _select_in_word(words[i], k);
+            k -= c;
+        }
+        return npos;
+    }
+
+    // Непосредственный доступ к словам, например для сохранения на диск
+    const uint64_t* get_words() const { return words; }
+    size_t get_word_count() const { return _words_for(length); }
+};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cassert>
+
+#include "Exception.hpp"
+
+
+namespace siilib {
+// Политика проверок индексов и пустоты (параметр шаблона CheckPolicy у последовательных контейнеров, см. README):
+//     Checked - исключения IndexError и EmptyError (по умолчанию);
+//     Asserted - assert, то есть проверки только в отладочной сборке (без NDEBUG);
+//     Unchecked - без проверок, выход за границы - неопределенное поведение.
+// Отрицательные индексы в стиле Python работают при любой политике; try_* и get() проверяют всегда.
+struct Checked {
+    template <typename Error>
+    static void require(bool ok) { if(__builtin_expect(!ok, 0)) throw Error(); }
+};
+
+struct Asserted {
+    template <typename Error>
+    static void require(bool ok) {
+        assert(ok && "siilib: index out of range or container is empty");
+        (void)ok;
+    }
+};
+
+struct Unchecked {
+    template <typename Error>
+    static void require(bool) { }
+};
+
+template <typename CheckPolicy, typename Error>
+inline void _require(bool ok) { CheckPolicy::template require<Error>(ok); }
+}
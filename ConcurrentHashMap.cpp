@@ -0,0 +1,213 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "Exception.hpp"
+#include "Hash.hpp"
+#include "HashMap.cpp"
+
+
+#define CONCURRENTHASHMAP_SHARDS 64
+
+
+namespace siilib {
+// Хэш-таблица для нескольких потоков: ключи делятся по старшим битам хэша на независимые части (шарды),
+// каждая - обычный HashMap под своим std::shared_mutex. Читатели одной части не мешают друг другу, писатели
+// блокируют только свою часть, а рост таблицы (rehash) идет в каждой части отдельно и не останавливает остальные.
+// Части выровнены по кэш-линии, чтобы блокировки соседних частей не делили одну линию.
+// Ссылки на значения наружу не выдаются: find возвращает копию, visit, update и upsert вызывают функцию
+// под блокировкой части (функция не должна обращаться к этой же таблице).
+// get_length и is_empty при одновременных изменениях приблизительны.
+template <typename K, typename V, typename Hash = siilib::Hash<K>, typename KeyEqual = std::equal_to<K>>
+class ConcurrentHashMap {
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        HashMap<K, V, Hash, KeyEqual> map;
+
+        Shard(size_t capacity, const Hash& hasher, const KeyEqual& key_equal) : map(capacity, hasher, key_equal) { }
+    };
+
+    Shard* shards{nullptr};
+    size_t shard_count{1};
+    unsigned shard_bits{0};
+    Hash hasher;
+
+
+    // Внутри части HashMap использует младшие биты хэша, поэтому часть выбирается по старшим
+    Shard& _shard(const K& key) const {
+        if(shard_bits == 0) return shards[0];
+        return shards[static_cast<uint64_t>(hasher(key)) >> (64 - shard_bits)];
+    }
+
+
+public:
+    using Entry = typename HashMap<K, V, Hash, KeyEqual>::ConstEntry;
+
+    // Число частей округляется вверх до степени двойки; capacity - ожидаемое число элементов во всей таблице
+    ConcurrentHashMap(size_t shards=CONCURRENTHASHMAP_SHARDS, size_t capacity=0, const Hash& hasher=Hash(), const KeyEqual& key_equal=KeyEqual()) : hasher(hasher) {
+        while(shard_count < shards) {
+            shard_count <<= 1;
+            shard_bits++;
+        }
+        try {
+            this->shards = static_cast<Shard*>(::operator new[](shard_count * sizeof(Shard), std::align_val_t(alignof(Shard))));
+        }
+        catch(const std::bad_alloc&) { throw AllocError(); }
+        size_t i = 0;
+        try {
+            for(; i < shard_count; ++i) new(this->shards + i) Shard(capacity / shard_count, hasher, key_equal);
+        }
+        catch(...) {
+            while(i) this->shards[--i].~Shard();
+            ::operator delete[](this->shards, std::align_val_t(alignof(Shard)));
+            throw;
+        }
+    }
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+    ~ConcurrentHashMap() {
+        for(size_t i = 0; i < shard_count; ++i) shards[i].~Shard();
+        ::operator delete[](shards, std::align_val_t(alignof(Shard)));
+    }
+
+    // Части очищаются по очереди: вставки в уже очищенные части во время clear сохраняются
+    void clear() {
+        for(size_t i = 0; i < shard_count; ++i) {
+            std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+            shards[i].map.clear();
+        }
+    }
+    // Резервирует место под length элементов, блокируя части по одной
+    void reserve(size_t length) {
+        for(size_t i = 0; i < shard_count; ++i) {
+            std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+            shards[i].map.reserve(length / shard_count + 1);
+        }
+    }
+
+    size_t get_length() const {
+        size_t res = 0;
+        for(size_t i = 0; i < shard_count; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+            res += shards[i].map.get_length();
+        }
+        return res;
+    }
+    bool is_empty() const {
+        for(size_t i = 0; i < shard_count; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+            if(!shards[i].map.is_empty()) return false;
+        }
+        return true;
+    }
+    size_t get_shard_count() const { return shard_count; }
+
+    // true - ключ добавлен, false - значение существующего ключа заменено
+    bool insert_or_assign(const K& key, const V& value) {
+        Shard& shard = _shard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if(V* ptr = shard.map.get(key)) {
+            *ptr = value;
+            return false;
+        }
+        shard.map.insert(key, value);
+        return true;
+    }
+    bool insert_or_assign(const K& key, V&& value) {
+        Shard& shard = _shard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if(V* ptr = shard.map.get(key)) {
+            *ptr = std::move(value);
+            return false;
+        }
+        shard.map.insert(key, std::move(value));
+        return true;
+    }
+    // Добавляет ключ, только если его нет; false - ключ уже есть, значение не меняется
+    bool try_insert(const K& key, const V& value) {
+        Shard& shard = _shard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if(shard.map.contains(key)) return false;
+        shard.map.insert(key, value);
+        return true;
+    }
+
+    void remove(const K& key) {
+        if(!try_remove(key)) throw KeyError();
+    }
+    bool try_remove(const K& key) {
+        Shard& shard = _shard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.map.try_remove(key);
+    }
+
+    bool contains(const K& key) const {
+        Shard& shard = _shard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.map.contains(key);
+    }
+
+    // Копия значения на момент вызова
+    std::optional<V> find(const K& key) const {
+        Shard& shard = _shard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        const V* ptr = shard.map.get(key);
+        if(!ptr) return std::nullopt;
+        return *ptr;
+    }
+    V at(const K& key) const {
+        std::optional<V> res = find(key);
+        if(!res) throw KeyError();
+        return std::move(*res);
+    }
+    // f(const V&) под блокировкой чтения, без копирования значения; false - ключа нет
+    template <typename F>
+    bool visit(const K& key, F f) const {
+        Shard& shard = _shard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        const V* ptr = shard.map.get(key);
+        if(!ptr) return false;
+        f(*ptr);
+        return true;
+    }
+
+    // f(V&) под блокировкой записи; false - ключа нет
+    template <typename F>
+    bool update(const K& key, F f) {
+        Shard& shard = _shard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        V* ptr = shard.map.get(key);
+        if(!ptr) return false;
+        f(*ptr);
+        return true;
+    }
+    // Атомарное "вставить или изменить": ключа нет - добавляется init, есть - вызывается f(V&).
+    // Возвращает копию получившегося значения. Например, подсчет слов:
+    //     words.upsert(word, 1, [](int& count) { ++count; });
+    template <typename F>
+    V upsert(const K& key, const V& init, F f) {
+        Shard& shard = _shard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if(V* ptr = shard.map.get(key)) {
+            f(*ptr);
+            return *ptr;
+        }
+        return shard.map.insert(key, init);
+    }
+
+    // f(const Entry&) для каждого элемента, часть за частью под блокировкой чтения.
+    // Изменения в частях, которые еще не пройдены, будут видны, в уже пройденных - нет.
+    template <typename F>
+    void for_each(F f) const {
+        for(size_t i = 0; i < shard_count; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+            const HashMap<K, V, Hash, KeyEqual>& map = shards[i].map;
+            for(Entry entry : map) f(entry);
+        }
+    }
+};
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <optional>
+
+#include "Epoch.hpp"
+#include "Exception.hpp"
+
+
+namespace siilib {
+// Стек без блокировок (стек Трайбера) для нескольких потоков: вершина - атомарный указатель, push и pop -
+// один успешный CAS. Снятый узел освобождается через EpochDomain (Epoch.hpp) только после того, как ни один
+// поток не может его читать, поэтому адрес узла не повторяется, пока кто-то держит старую вершину (нет ABA),
+// и next читается без обращения к освобожденной памяти. Освобожденные узлы возвращаются в пул потока
+// и переиспользуются push без new.
+// Интерфейс - как у Stack, но top возвращает копию вершины на момент вызова (ссылка была бы небезопасна),
+// а push ничего не возвращает. max_length - мягкая граница: одновременные push могут превысить ее на число
+// потоков. get_length - приблизительная длина при одновременных изменениях.
+// pop копирует значение, а не перемещает: одновременный top может читать тот же узел.
+template <typename T>
+class ConcurrentStack {
+    struct Node {
+        T data{};
+        Node* next{nullptr};
+    };
+    using Pool = _RecyclePool<Node>;
+
+    std::atomic<Node*> head{nullptr};
+    std::atomic<size_t> length{0};
+    size_t max_length{0};
+
+
+    bool _full() const { return max_length && length.load(std::memory_order_relaxed) >= max_length; }
+
+    // Длина увеличивается до публикации узла: pop не может опустить ее ниже нуля
+    void _push(Node* node) {
+        length.fetch_add(1, std::memory_order_relaxed);
+        Node* top = head.load(std::memory_order_relaxed);
+        do { node->next = top; } while(!head.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    template <typename U>
+    Node* _node(U&& x) {
+        Node* node;
+        try { node = Pool::get(); }
+        catch(const std::bad_alloc&) { throw AllocError(); }
+        // Узел еще никому не виден и удаляется сразу
+        try { node->data = std::forward<U>(x); }
+        catch(...) { delete node; throw; }
+        return node;
+    }
+
+
+public:
+    ConcurrentStack(size_t max_length=0) : max_length(max_length) { }
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+    // Другие потоки к этому моменту уже не обращаются к стеку
+    ~ConcurrentStack() {
+        Node* node = head.load(std::memory_order_acquire);
+        while(node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    void clear() { while(try_pop()); }
+
+    bool is_empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+    size_t get_length() const { return length.load(std::memory_order_relaxed); }
+    size_t get_max_length() const { return max_length; }
+
+    void push(const T& x) {
+        if(_full()) throw OverflowError();
+        _push(_node(x));
+    }
+    void push(T&& x) {
+        if(_full()) throw OverflowError();
+        _push(_node(std::move(x)));
+    }
+    // false вместо OverflowError
+    bool try_push(const T& x) {
+        if(_full()) return false;
+        _push(_node(x));
+        return true;
+    }
+    bool try_push(T&& x) {
+        if(_full()) return false;
+        _push(_node(std::move(x)));
+        return true;
+    }
+
+    T pop() {
+        std::optional<T> res = try_pop();
+        if(!res) throw EmptyError();
+        return std::move(*res);
+    }
+    std::optional<T> try_pop() {
+        EpochGuard guard;
+        Node* top = head.load(std::memory_order_acquire);
+        while(top && !head.compare_exchange_weak(top, top->next, std::memory_order_acquire, std::memory_order_acquire));
+        if(!top) return std::nullopt;
+        length.fetch_sub(1, std::memory_order_relaxed);
+        // Узел отдается на освобождение до копирования, чтобы исключение копии его не потеряло;
+        // освобожден он будет не раньше, чем закончится guard этого потока
+        guard.retire(top, &Pool::put);
+        return std::optional<T>(top->data);
+    }
+
+    // Копия вершины на момент вызова; пустой стек - EmptyError
+    T top() const {
+        std::optional<T> res = try_top();
+        if(!res) throw EmptyError();
+        return std::move(*res);
+    }
+    std::optional<T> try_top() const {
+        EpochGuard guard;
+        Node* top = head.load(std::memory_order_acquire);
+        if(!top) return std::nullopt;
+        return top->data;
+    }
+};
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <utility>
+
+#include "Exception.hpp"
+
+
+namespace siilib {
+// Общая часть CowVector и CowArray: контейнер в буфере с атомарным счетчиком ссылок.
+// Копирование объекта только увеличивает счетчик; первая изменяющая операция копирующего объекта
+// (detach) копирует контейнер, если буфер разделяется с кем-то еще.
+// Сами объекты не потокобезопасны, но копии (снимки) можно свободно передавать в другие потоки.
+template <typename Container>
+class _Cow {
+    struct _Shared {
+        std::atomic<size_t> refs{1};
+        Container data;
+
+        template <typename... Args>
+        _Shared(Args&&... args) : data(std::forward<Args>(args)...) { }
+    };
+
+    _Shared* shared{nullptr};
+
+
+    void _release() {
+        if(shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete shared;
+    }
+
+protected:
+    template <typename... Args>
+    static _Shared* _make(Args&&... args) {
+        try { return new _Shared(std::forward<Args>(args)...); }
+        catch(const std::bad_alloc&) { throw AllocError(); }
+    }
+
+    template <typename... Args>
+    _Cow(std::in_place_t, Args&&... args) : shared(_make(std::forward<Args>(args)...)) { }
+
+    Container& _write() { detach(); return shared->data; }
+
+public:
+    // Перемещения нет: копия так же дешева и оставляет исходный объект действительным
+    _Cow(const _Cow& right) noexcept : shared(right.shared) {
+        shared->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~_Cow() { _release(); }
+
+    _Cow& operator=(const _Cow& right) noexcept {
+        if(shared == right.shared) return *this;
+        right.shared->refs.fetch_add(1, std::memory_order_relaxed);
+        _release();
+        shared = right.shared;
+        return *this;
+    }
+
+    // Буфер ни с кем не разделяется
+    bool unique() const { return shared->refs.load(std::memory_order_acquire) == 1; }
+    size_t use_count() const { return shared->refs.load(std::memory_order_acquire); }
+
+    // Делает буфер собственным, копируя контейнер, если он разделяется
+    void detach() {
+        if(!unique()) {
+            _Shared* copy = _make(shared->data);
+            _release();
+            shared = copy;
+        }
+    }
+
+    // Контейнер только для чтения, без копирования
+    const Container& read() const { return shared->data; }
+};
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+
+#include "Exception.hpp"
+#include "Cow.hpp"
+#include "Array.cpp"
+
+
+namespace siilib {
+// Array с копированием при записи (см. CowVector): копии разделяют буфер до первого изменения.
+// Неконстантные operator[], get, begin, end считаются изменением; для чтения - read().
+// CheckPolicy - политика проверок внутреннего Array (Check.hpp).
+template <typename T, typename CheckPolicy = Checked>
+class CowArray : public _Cow<Array<T, HeapStorage, CheckPolicy>> {
+    using Data = Array<T, HeapStorage, CheckPolicy>;
+    using Base = _Cow<Data>;
+    using Base::_write;
+
+public:
+    static constexpr int npos = -1;
+
+    CowArray(size_t length) : Base(std::in_place, length) { }
+    CowArray(T ar[], size_t len, size_t length=0) : Base(std::in_place, ar, len, length) { }
+    CowArray(std::initializer_list<T> ar, size_t length=0) : Base(std::in_place, ar, length) { }
+    CowArray(const Data& right) : Base(std::in_place, right) { }
+    CowArray(Data&& right) : Base(std::in_place, std::move(right)) { }
+
+    size_t get_length() const { return this->read().get_length(); }
+    size_t get_size() const { return this->read().get_size(); }
+
+    T& insert(int index, const T& x) { return _write().insert(index, x); }
+    T& insert(int index, T&& x) { return _write().insert(index, std::move(x)); }
+    T erase(int index) { return _write().erase(index); }
+    void remove(const T& key) { _write().remove(key); }
+
+    int find(const T& key) const { return this->read().find(key); }
+    int rfind(const T& key) const { return this->read().rfind(key); }
+    int try_find(const T& key) const { return this->read().try_find(key); }
+    int try_rfind(const T& key) const { return this->read().try_rfind(key); }
+
+    T& operator[](int index) { return _write()[index]; }
+    const T& operator[](int index) const { return this->read()[index]; }
+    T* get(int index) { return this->read().get(index) ? _write().get(index) : nullptr; }
+    const T* get(int index) const { return this->read().get(index); }
+
+    T* begin() { return _write().begin(); }
+    T* end() { return _write().end(); }
+    const T* begin() const { return this->read().begin(); }
+    const T* end() const { return this->read().end(); }
+};
+}
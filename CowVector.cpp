@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "Exception.hpp"
+#include "Cow.hpp"
+#include "Vector.cpp"
+
+
+namespace siilib {
+// Vector с копированием при записи: копия объекта разделяет буфер с оригиналом,
+// элементы копируются только при первом изменении одной из копий.
+// Неконстантные operator[], get, begin, end, front, back тоже считаются изменением; полученные через них
+// ссылки нельзя использовать для записи после копирования объекта (копия увидела бы эти изменения).
+// Для чтения из неконстантного объекта - read(). CheckPolicy - политика проверок внутреннего Vector (Check.hpp).
+template <typename T, typename CheckPolicy = Checked>
+class CowVector : public _Cow<Vector<T, HeapStorage, CheckPolicy>> {
+    using Data = Vector<T, HeapStorage, CheckPolicy>;
+    using Base = _Cow<Data>;
+    using Base::_write;
+
+public:
+    static constexpr int npos = -1;
+
+    CowVector(size_t capacity=VECTOR_MIN_CAPACITY, unsigned resize_factor=2) : Base(std::in_place, capacity, resize_factor) { }
+    CowVector(T ar[], size_t len, unsigned resize_factor=2) : Base(std::in_place, ar, len, resize_factor) { }
+    CowVector(std::initializer_list<T> ar) : Base(std::in_place, ar) { }
+    CowVector(const Data& right) : Base(std::in_place, right) { }
+    CowVector(Data&& right) : Base(std::in_place, std::move(right)) { }
+
+    size_t get_capacity() const { return this->read().get_capacity(); }
+    size_t get_length() const { return this->read().get_length(); }
+    size_t get_size() const { return this->read().get_size(); }
+    bool is_empty() const { return this->read().is_empty(); }
+
+    void clear() { _write().clear(); }
+    void resize(size_t len, bool manual_memory=true) { _write().resize(len, manual_memory); }
+
+    T& push_back(const T& x) { return _write().push_back(x); }
+    T& push_back(T&& x) { return _write().push_back(std::move(x)); }
+    T& push_front(const T& x) { return _write().push_front(x); }
+    T& push_front(T&& x) { return _write().push_front(std::move(x)); }
+    T pop_back() { return _write().pop_back(); }
+    T pop_front() { return _write().pop_front(); }
+    std::optional<T> try_pop_back() { return is_empty() ? std::nullopt : _write().try_pop_back(); }
+    std::optional<T> try_pop_front() { return is_empty() ? std::nullopt : _write().try_pop_front(); }
+    T& insert(int index, const T& x) { return _write().insert(index, x); }
+    T& insert(int index, T&& x) { return _write().insert(index, std::move(x)); }
+    T erase(int index) { return _write().erase(index); }
+    void remove(const T& key) { _write().remove(key); }
+
+    int find(const T& key) const { return this->read().find(key); }
+    int rfind(const T& key) const { return this->read().rfind(key); }
+    int try_find(const T& key) const { return this->read().try_find(key); }
+    int try_rfind(const T& key) const { return this->read().try_rfind(key); }
+
+    CowVector& extend(const Data& right) { _write().extend(right); return *this; }
+
+    T& operator[](int index) { return _write()[index]; }
+    const T& operator[](int index) const { return this->read()[index]; }
+    T* get(int index) { return this->read().get(index) ? _write().get(index) : nullptr; }
+    const T* get(int index) const { return this->read().get(index); }
+
+    T* begin() { return _write().begin(); }
+    T* end() { return _write().end(); }
+    const T* begin() const { return this->read().begin(); }
+    const T* end() const { return this->read().end(); }
+
+    T& front() { return _write().front(); }
+    const T& front() const { return this->read().front(); }
+    T& back() { return _write().back(); }
+    const T& back() const { return this->read().back(); }
+};
+}
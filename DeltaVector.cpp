@@ -0,0 +1,205 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <optional>
+
+#include "Exception.hpp"
+#include "Numeric.cpp"
+#include "PackedIntVector.cpp"
+#include "Vector.cpp"
+
+
+#define DELTAVECTOR_BLOCK 128
+
+
+namespace siilib {
+// Неубывающая последовательность беззнаковых целых, сжатая блоками по DELTAVECTOR_BLOCK значений.
+// Блок хранит в заголовке первое значение, а разности соседних значений - упакованными подряд с одной
+// шириной на весь блок (по наибольшей разности), без байтов длины на каждое значение: распаковка блока -
+// цикл без ветвлений по данным и векторная префиксная сумма (Numeric.cpp).
+// Заголовки блоков лежат отдельно, поэтому lower_bound ищет блок бинарным поиском по первым значениям
+// и распаковывает только его. Последние значения, еще не набравшие блок, хранятся как есть.
+// Доступ по индексу - O(DELTAVECTOR_BLOCK); значение меньше последнего - ValueError.
+class DeltaVector {
+    struct Block {
+        uint64_t first;
+        size_t offset;
+        unsigned bits;
+    };
+
+    Vector<Block> blocks;
+    Vector<uint64_t> words;
+    uint64_t tail[DELTAVECTOR_BLOCK];
+    size_t tail_length{0};
+    size_t length{0};
+
+
+    // Сжимает заполненный хвост в новый блок
+    void _flush_tail() {
+        uint64_t max_delta = 0;
+        for(size_t i = 1; i < DELTAVECTOR_BLOCK; ++i) max_delta |= tail[i] - tail[i - 1];
+        unsigned bits = max_delta ? bits_for(max_delta) : 0;
+        size_t offset = words.get_length();
+        // Лишнее нулевое слово в конце блока позволяет читать любое поле двумя словами без проверок
+        size_t count = (size_t(DELTAVECTOR_BLOCK - 1) * bits + 63) / 64 + 1;
+        for(size_t i = 0; i < count; ++i) words.push_back(0);
+        uint64_t* ptr = words.begin() + offset;
+        for(size_t i = 1; i < DELTAVECTOR_BLOCK && bits; ++i) _bits_set(ptr, (i - 1) * bits, bits, tail[i] - tail[i - 1]);
+        blocks.push_back(Block{tail[0], offset, bits});
+        tail_length = 0;
+    }
+
+    // Все значения блока b в out
+    void _decode(size_t b, uint64_t* out) const {
+        const Block& block = blocks.begin()[b];
+        out[0] = block.first;
+        _bits_unpack(words.begin() + block.offset, 0, block.bits, DELTAVECTOR_BLOCK - 1, out + 1);
+        prefix_sum(out, out + DELTAVECTOR_BLOCK);
+    }
+
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    DeltaVector() = default;
+    DeltaVector(std::initializer_list<uint64_t> ar) {
+        for(uint64_t x : ar) push_back(x);
+    }
+    DeltaVector(const DeltaVector& right) = default;
+    DeltaVector(DeltaVector&& right) noexcept {
+        *this = std::move(right);
+    }
+
+    DeltaVector& operator=(const DeltaVector& right) = default;
+    DeltaVector& operator=(DeltaVector&& right) noexcept {
+        if(this == &right) return *this;
+        blocks = std::move(right.blocks);
+        words = std::move(right.words);
+        for(size_t i = 0; i < right.tail_length; ++i) tail[i] = right.tail[i];
+        tail_length = right.tail_length;
+        length = right.length;
+        right.tail_length = 0;
+        right.length = 0;
+        return *this;
+    }
+
+    void clear() {
+        blocks.clear();
+        words.clear();
+        tail_length = 0;
+        length = 0;
+    }
+
+    size_t get_length() const { return length; }
+    // Занимаемая память в байтах: сжатые разности, заголовки и хвост
+    size_t get_size() const {
+        return words.get_capacity() * sizeof(uint64_t) + blocks.get_capacity() * sizeof(Block) + sizeof(tail);
+    }
+    size_t get_block_count() const { return blocks.get_length(); }
+    bool is_empty() const { return length == 0; }
+
+    void push_back(uint64_t x) {
+        if(length && x < back()) throw ValueError();
+        tail[tail_length++] = x;
+        length++;
+        if(tail_length == DELTAVECTOR_BLOCK) _flush_tail();
+    }
+    uint64_t pop_back() {
+        if(length == 0) throw EmptyError();
+        return *try_pop_back();
+    }
+    std::optional<uint64_t> try_pop_back() {
+        if(length == 0) return std::nullopt;
+        if(tail_length == 0) {
+            // Последний блок снова становится хвостом
+            size_t b = blocks.get_length() - 1;
+            _decode(b, tail);
+            size_t offset = blocks.begin()[b].offset;
+            while(words.get_length() > offset) words.pop_back();
+            blocks.pop_back();
+            tail_length = DELTAVECTOR_BLOCK;
+        }
+        length--;
+        return tail[--tail_length];
+    }
+
+    uint64_t operator[](size_t index) const {
+        if(index >= length) throw IndexError();
+        size_t b = index / DELTAVECTOR_BLOCK;
+        size_t k = index % DELTAVECTOR_BLOCK;
+        if(b == blocks.get_length()) return tail[k];
+        const Block& block = blocks.begin()[b];
+        const uint64_t* ptr = words.begin() + block.offset;
+        uint64_t mask = _bits_mask(block.bits);
+        uint64_t res = block.first;
+        // Позиции полей считаются независимо, без цепочки зависимостей, как при последовательной распаковке
+        for(size_t i = 0; i < k && block.bits; ++i) {
+            size_t pos = i * block.bits;
+            unsigned off = pos % 64;
+            res += ((ptr[pos / 64] >> off) | ((ptr[pos / 64 + 1] << 1) << (63 - off))) & mask;
+        }
+        return res;
+    }
+    uint64_t front() const {
+        if(length == 0) throw EmptyError();
+        return blocks.is_empty() ? tail[0] : blocks.begin()[0].first;
+    }
+    uint64_t back() const {
+        if(length == 0) throw EmptyError();
+        if(tail_length) return tail[tail_length - 1];
+        return (*this)[length - 1];
+    }
+
+    // Индекс первого значения, не меньшего x, или get_length()
+    size_t lower_bound(uint64_t x) const {
+        size_t full = blocks.get_length() * DELTAVECTOR_BLOCK;
+        if(tail_length && tail[0] < x) {
+            size_t i = 0;
+            while(i < tail_length && tail[i] < x) ++i;
+            return full + i;
+        }
+        // Последний блок, первое значение которого меньше x (равные x могут быть и в конце предыдущего блока)
+        const Block* ptr = blocks.begin();
+        size_t lo = 0, hi = blocks.get_length();
+        if(hi == 0 || ptr[0].first >= x) return 0;
+        while(hi - lo > 1) {
+            size_t mid = (lo + hi) / 2;
+            if(ptr[mid].first < x) lo = mid;
+            else hi = mid;
+        }
+        uint64_t values[DELTAVECTOR_BLOCK];
+        _decode(lo, values);
+        size_t i = 0;
+        while(i < DELTAVECTOR_BLOCK && values[i] < x) ++i;
+        return lo * DELTAVECTOR_BLOCK + i;
+    }
+    bool contains(uint64_t x) const { return try_find(x) != npos; }
+    // Индекс первого значения, равного x; такого нет - KeyError (try_find возвращает npos)
+    size_t find(uint64_t x) const {
+        size_t index = try_find(x);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    size_t try_find(uint64_t x) const {
+        size_t pos = lower_bound(x);
+        return pos < length && (*this)[pos] == x ? pos : npos;
+    }
+
+    // Распаковывает все значения в out (не меньше get_length() элементов)
+    void unpack(uint64_t* out) const {
+        for(size_t b = 0; b < blocks.get_length(); ++b) _decode(b, out + b * DELTAVECTOR_BLOCK);
+        for(size_t i = 0; i < tail_length; ++i) out[blocks.get_length() * DELTAVECTOR_BLOCK + i] = tail[i];
+    }
+    // Вызывает f(x) для каждого значения по порядку, распаковывая по блоку за раз
+    template <typename F>
+    void for_each(F f) const {
+        uint64_t values[DELTAVECTOR_BLOCK];
+        for(size_t b = 0; b < blocks.get_length(); ++b) {
+            _decode(b, values);
+            for(size_t i = 0; i < DELTAVECTOR_BLOCK; ++i) f(values[i]);
+        }
+        for(size_t i = 0; i < tail_length; ++i) f(tail[i]);
+    }
+};
+}
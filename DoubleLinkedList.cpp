@@ -1,11 +1,18 @@
+#pragma once
+
 #include <memory>
+#include <optional>
 
+#include "Check.hpp"
 #include "Exception.hpp"
+#include "Serialize.hpp"
+#include "Stats.hpp"
 
 
 namespace siilib {
-template <typename T>
-class DoubleLinkedList { 
+// CheckPolicy - проверки индексов и пустоты (Check.hpp)
+template <typename T, typename CheckPolicy = Checked>
+class DoubleLinkedList : public _Stats {
 
     struct Object {
         T data;
@@ -20,9 +27,8 @@ class DoubleLinkedList {
     Object* tail{nullptr};
     size_t length{0};
 
-    Object* _at(int index) const {
-        if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+    // Узел по индексу из [0, length), без проверок: обход с ближнего конца
+    Object* _walk(int index) const {
         Object* ptr;
         if(index < length / 2) {
             ptr = head;
@@ -34,11 +40,22 @@ class DoubleLinkedList {
         }
         return ptr;
     }
+    Object* _node(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return _walk(index);
+    }
+    Object* _at(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        return _walk(index);
+    }
 
     template <typename U>
     T& _push_back(U&& x) {
         try {
             Object* ptr = new Object(std::forward<U>(x));
+            this->_stat_alloc(sizeof(Object));
             if(!tail) {
                 head = tail = ptr;
             }
@@ -57,6 +74,7 @@ class DoubleLinkedList {
     T& _push_front(U&& x) {
         try {
             Object* ptr = new Object(std::forward<U>(x));
+            this->_stat_alloc(sizeof(Object));
             if(!head) {
                 head = tail = ptr;
             }
@@ -73,11 +91,15 @@ class DoubleLinkedList {
 
     template <typename U>
     T& _insert(int index, U&& x) {
+        // Как у Vector: проверка до выделения узла, чтобы исключение не теряло его
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index <= static_cast<int>(length));
         if(index == 0) return push_front(std::forward<U>(x));
         if(index == length) return push_back(std::forward<U>(x));
         try {
             Object* ptr = new Object(std::forward<U>(x));
-            Object* left = _at(index - 1);
+            this->_stat_alloc(sizeof(Object));
+            Object* left = _walk(index - 1);
             Object* right = left->next;
             left->next = ptr;
             right->prev = ptr;
@@ -89,16 +111,93 @@ class DoubleLinkedList {
         catch(std::bad_alloc&) { throw AllocError(); }
     }
 
+    // Исключает узел из списка, не удаляя его
+    void _unlink(Object* ptr) {
+        if(ptr->prev) ptr->prev->next = ptr->next;
+        else head = ptr->next;
+        if(ptr->next) ptr->next->prev = ptr->prev;
+        else tail = ptr->prev;
+        ptr->prev = ptr->next = nullptr;
+        length--;
+    }
+    void _link_front(Object* ptr) {
+        ptr->next = head;
+        if(head) head->prev = ptr;
+        else tail = ptr;
+        head = ptr;
+        length++;
+    }
+    void _link_back(Object* ptr) {
+        ptr->prev = tail;
+        if(tail) tail->next = ptr;
+        else head = ptr;
+        tail = ptr;
+        length++;
+    }
+
+    T _pop_back() {
+        T res = std::move(tail->data);
+        if(head == tail) {
+            this->_stat_free(sizeof(Object));
+            delete tail;
+            head = tail = nullptr;
+        }
+        else {
+            Object* ptr = tail->prev;
+            ptr->next = nullptr;
+            this->_stat_free(sizeof(Object));
+            delete tail;
+            tail = ptr;
+        }
+        length--;
+        return res;
+    }
+    T _pop_front() {
+        T res = std::move(head->data);
+        if(head == tail) {
+            this->_stat_free(sizeof(Object));
+            delete head;
+            head = tail = nullptr;
+        }
+        else {
+            Object* ptr = head->next;
+            ptr->prev = nullptr;
+            this->_stat_free(sizeof(Object));
+            delete head;
+            head = ptr;
+        }
+        length--;
+        return res;
+    }
+
 
 public:
+    static constexpr int npos = -1;
+
+    // Ссылка на узел: действует, пока элемент не удален из списка (в том числе после перестановок и splice).
+    // Handle по умолчанию пуст. Операции с ручками - O(1), в отличие от доступа по индексу и remove по значению.
+    class Handle {
+        Object* ptr{nullptr};
+        friend class DoubleLinkedList;
+        explicit Handle(Object* ptr) : ptr(ptr) { }
+    public:
+        Handle() = default;
+        T& operator*() const { return ptr->data; }
+        T* operator->() const { return &ptr->data; }
+        explicit operator bool() const { return ptr != nullptr; }
+        bool operator==(const Handle& right) const { return ptr == right.ptr; }
+        bool operator!=(const Handle& right) const { return ptr != right.ptr; }
+    };
+
     DoubleLinkedList() { }
     DoubleLinkedList(const T* ar, size_t len) {
         for(size_t i = 0; i < len; ++i) this->push_back(ar[i]);
     }
-    DoubleLinkedList(const DoubleLinkedList<T>& right) {
+    DoubleLinkedList(const DoubleLinkedList& right) : _Stats() {
         for(Object* ptr = right.head; ptr != nullptr; ptr = ptr->next) this->push_back(ptr->data);
+        this->_stat_copied(right.length);
     }
-    DoubleLinkedList(DoubleLinkedList<T>&& right) noexcept {
+    DoubleLinkedList(DoubleLinkedList&& right) noexcept {
         this->head = right.head;
         this->tail = right.tail;
         this->length = right.length;
@@ -119,6 +218,7 @@ public:
         while(head) {
             ptr = head;
             head = head->next;
+            this->_stat_free(sizeof(Object));
             delete ptr;
         }
         head = tail = nullptr;
@@ -144,36 +244,20 @@ public:
         return _push_front(std::move(x));
     }
     T pop_back() {
-        if(!tail) throw EmptyError();
-        T res = std::move(tail->data);
-        if(head == tail) {
-            delete tail;
-            head = tail = nullptr;
-        }
-        else {
-            Object* ptr = tail->prev;
-            ptr->next = nullptr;
-            delete tail;
-            tail = ptr;
-        }
-        length--;
-        return res;
+        _require<CheckPolicy, EmptyError>(tail != nullptr);
+        return _pop_back();
     }
     T pop_front() {
-        if(!head) throw EmptyError();
-        T res = std::move(head->data);
-        if(head == tail) {
-            delete head;
-            head = tail = nullptr;
-        }
-        else {
-            Object* ptr = head->next;
-            ptr->prev = nullptr;
-            delete head;
-            head = ptr;
-        }
-        length--;
-        return res;
+        _require<CheckPolicy, EmptyError>(head != nullptr);
+        return _pop_front();
+    }
+    std::optional<T> try_pop_back() {
+        if(!tail) return std::nullopt;
+        return _pop_back();
+    }
+    std::optional<T> try_pop_front() {
+        if(!head) return std::nullopt;
+        return _pop_front();
     }
 
     T& insert(int index, const T& x) {
@@ -183,12 +267,15 @@ public:
         return _insert(index, std::move(x));
     }
     T erase(int index) {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         if(index == 0) return pop_front();
         if(index == length-1) return pop_back();
-        Object* ptr = _at(index);
+        Object* ptr = _walk(index);
         T res = std::move(ptr->data);
         ptr->prev->next = ptr->next;
         ptr->next->prev = ptr->prev;
+        this->_stat_free(sizeof(Object));
         delete ptr;
         length--;
         return res;
@@ -201,6 +288,7 @@ public:
                 else head = ptr->next;
                 if(ptr->next) ptr->next->prev = ptr->prev;
                 else tail = ptr->prev;
+                this->_stat_free(sizeof(Object));
                 delete ptr;
                 length--;
                 return;
@@ -209,30 +297,41 @@ public:
         throw KeyError();
     }
 
-    int find(const T& key) {
+    int find(const T& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int rfind(const T& key) const {
+        int index = try_rfind(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const T& key) const {
         Object* ptr = head;
         for(size_t i = 0; ptr != nullptr; ++i, ptr = ptr->next) {
             if(ptr->data == key) {
                 return i;
             }
         }
-        throw KeyError();
+        return npos;
     }
-    int rfind(const T& key) {
+    int try_rfind(const T& key) const {
         Object* ptr = tail;
-        for(int i = static_cast<int>(length); ptr != nullptr; --i, ptr = ptr->prev) {
+        for(int i = static_cast<int>(length)-1; ptr != nullptr; --i, ptr = ptr->prev) {
             if(ptr->data == key) {
                 return i;
             }
         }
-        throw KeyError();
+        return npos;
     }
 
-    DoubleLinkedList<T>& extend(const DoubleLinkedList<T>& right) {
+    DoubleLinkedList& extend(const DoubleLinkedList& right) {
         for(Object* ptr = right.head; ptr != nullptr; ptr = ptr->next) this->push_back(ptr->data);
+        this->_stat_copied(right.length);
         return *this;
     }
-    DoubleLinkedList<T>& extend(DoubleLinkedList<T>&& right) {
+    DoubleLinkedList& extend(DoubleLinkedList&& right) {
         if(&right == this) return *this;
         if (!right.head) return *this;
         if (!head) {
@@ -255,19 +354,77 @@ public:
     const T& operator[](int index) const {
         return _at(index)->data;
     }
+    T* get(int index) {
+        Object* ptr = _node(index);
+        return ptr ? &ptr->data : nullptr;
+    }
+    const T* get(int index) const {
+        Object* ptr = _node(index);
+        return ptr ? &ptr->data : nullptr;
+    }
+
+    T& front() { _require<CheckPolicy, EmptyError>(head != nullptr); return head->data; }
+    const T& front() const { _require<CheckPolicy, EmptyError>(head != nullptr); return head->data; }
+    T& back() { _require<CheckPolicy, EmptyError>(tail != nullptr); return tail->data; }
+    const T& back() const { _require<CheckPolicy, EmptyError>(tail != nullptr); return tail->data; }
 
-    T& front() {if(!head) throw EmptyError(); return head->data; }
-    const T& front() const { if(!head) throw EmptyError();return head->data; }
-    T& back() { if(!tail) throw EmptyError();return tail->data; }
-    const T& back() const { if(!tail) throw EmptyError();return tail->data; }
+    // Ручки первого и последнего элементов (пустые для пустого списка) и соседей
+    Handle front_handle() const { return Handle(head); }
+    Handle back_handle() const { return Handle(tail); }
+    Handle next(Handle h) const { return Handle(h.ptr->next); }
+    Handle prev(Handle h) const { return Handle(h.ptr->prev); }
+
+    // Удаляет элемент по ручке этого списка за O(1)
+    T erase(Handle h) {
+        _require<CheckPolicy, KeyError>(h.ptr != nullptr);
+        _unlink(h.ptr);
+        T res = std::move(h.ptr->data);
+        this->_stat_free(sizeof(Object));
+        delete h.ptr;
+        return res;
+    }
+    // Переставляет элемент этого списка в начало или конец за O(1); ручка остается действительной
+    void move_to_front(Handle h) {
+        if(h.ptr == head) return;
+        _unlink(h.ptr);
+        _link_front(h.ptr);
+    }
+    void move_to_back(Handle h) {
+        if(h.ptr == tail) return;
+        _unlink(h.ptr);
+        _link_back(h.ptr);
+    }
+    // Переносит узел из списка from в начало или конец этого списка без копирования элемента
+    void splice_front(DoubleLinkedList& from, Handle h) {
+        from._unlink(h.ptr);
+        _link_front(h.ptr);
+    }
+    void splice_back(DoubleLinkedList& from, Handle h) {
+        from._unlink(h.ptr);
+        _link_back(h.ptr);
+    }
+
+    // Двоичное сохранение (Serialize.hpp): элементы узлов собираются в пакеты для writev без промежуточного копирования
+    void save(Writer out) const {
+        out.write_header<T>(length);
+        for(Object* ptr = head; ptr != nullptr; ptr = ptr->next) out.write_element(ptr->data);
+        out.flush();
+    }
+    static DoubleLinkedList load(Reader in) {
+        size_t len = in.read_header<T>();
+        DoubleLinkedList res;
+        in.read_each<T>(len, [&](T&& x) { res.push_back(std::move(x)); });
+        return res;
+    }
 
-    DoubleLinkedList<T>& operator=(const DoubleLinkedList<T>& right) {
+    DoubleLinkedList& operator=(const DoubleLinkedList& right) {
         if(&right == this) return *this;
         this->clear();
         for(Object* ptr = right.head; ptr != nullptr; ptr = ptr->next) this->push_back(ptr->data);
+        this->_stat_copied(right.length);
         return *this;
     }
-    DoubleLinkedList<T>& operator=(DoubleLinkedList<T>&& right) noexcept {
+    DoubleLinkedList& operator=(DoubleLinkedList&& right) noexcept {
         if(&right == this) return *this;
         this->clear();
         this->length = right.length;
@@ -277,7 +434,7 @@ public:
         right.length = 0;
         return *this;
     }
-    DoubleLinkedList<T>& operator=(std::initializer_list<T> ar) {
+    DoubleLinkedList& operator=(std::initializer_list<T> ar) {
         this->clear();
         for(const T& x : ar) this->push_back(x);
         return *this;
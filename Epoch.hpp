@@ -0,0 +1,195 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include "Vector.cpp"
+
+
+#define EPOCH_COLLECT_THRESHOLD 64
+#define EPOCH_POOL_SIZE 256
+
+
+namespace siilib {
+// Безопасное освобождение памяти в структурах без блокировок (epoch-based reclamation).
+// Поток читает общие узлы только внутри EpochGuard; узел, исключенный из структуры, передается в retire
+// и освобождается, когда глобальная эпоха продвинется на две вперед: к этому моменту каждый поток,
+// который мог видеть узел, уже вышел из своей критической секции. Пока узел не освобожден, его адрес
+// не может быть выдан снова, поэтому сравнения указателей в CAS не страдают от ABA.
+// Эпоха продвигается, когда все потоки внутри секций объявили текущую; долго спящий внутри EpochGuard
+// поток задерживает освобождение (но не работу остальных).
+class EpochDomain {
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+    // Запись потока: state = (эпоха << 1) | 1 внутри секции, 0 - вне ее.
+    // Записи не удаляются до конца программы: завершившийся поток освобождает свою для следующего.
+    struct Record {
+        std::atomic<uint64_t> state{0};
+        std::atomic<bool> in_use{true};
+        Record* next{nullptr};
+        unsigned depth{0};
+        // Порог следующей сборки: растет, если узлы не удается освободить (поток задерживает эпоху)
+        size_t collect_at{EPOCH_COLLECT_THRESHOLD};
+        Vector<Retired> retired;
+    };
+
+    std::atomic<Record*> records{nullptr};
+    std::atomic<uint64_t> epoch{1};
+
+
+    // Запись текущего потока; отдается обратно при его завершении
+    struct _Holder {
+        Record* rec{nullptr};
+        ~_Holder() { if(rec) rec->in_use.store(false, std::memory_order_release); }
+    };
+
+    Record* _record() {
+        thread_local _Holder holder;
+        if(holder.rec) return holder.rec;
+        for(Record* rec = records.load(std::memory_order_acquire); rec; rec = rec->next) {
+            bool expected = false;
+            if(!rec->in_use.load(std::memory_order_relaxed) && rec->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return holder.rec = rec;
+            }
+        }
+        Record* rec = new Record();
+        Record* head = records.load(std::memory_order_relaxed);
+        do { rec->next = head; } while(!records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+        return holder.rec = rec;
+    }
+
+    bool _try_advance() {
+        uint64_t current = epoch.load(std::memory_order_seq_cst);
+        for(Record* rec = records.load(std::memory_order_acquire); rec; rec = rec->next) {
+            uint64_t state = rec->state.load(std::memory_order_seq_cst);
+            if((state & 1) && (state >> 1) != current) return false;
+        }
+        return epoch.compare_exchange_strong(current, current + 1, std::memory_order_seq_cst);
+    }
+
+    // Освобождает узлы своей записи, пережившие две смены эпохи
+    void _collect(Record* rec) {
+        _try_advance();
+        uint64_t current = epoch.load(std::memory_order_seq_cst);
+        Retired* items = rec->retired.begin();
+        size_t len = rec->retired.get_length();
+        for(size_t i = 0; i < len;) {
+            if(items[i].epoch + 2 <= current) {
+                items[i].deleter(items[i].ptr);
+                items[i] = items[--len];
+                rec->retired.pop_back();
+                items = rec->retired.begin();
+            }
+            else ++i;
+        }
+        rec->collect_at = len * 2 > EPOCH_COLLECT_THRESHOLD ? len * 2 : EPOCH_COLLECT_THRESHOLD;
+    }
+
+    EpochDomain() = default;
+
+
+public:
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Домен не разрушается: потоки статических объектов (например, ThreadPool::global()) завершаются
+    // уже после статических деструкторов и при выходе обращаются к своей записи.
+    // Отложенные к концу программы узлы остаются достижимыми из домена и не считаются утечкой.
+    static EpochDomain& global() {
+        static EpochDomain* domain = new EpochDomain();
+        return *domain;
+    }
+
+    // Критическая секция: общие узлы можно читать, пока guard жив. Секции могут быть вложенными.
+    class Guard {
+        EpochDomain& domain;
+        Record* rec;
+    public:
+        Guard() : domain(EpochDomain::global()), rec(domain._record()) {
+            if(rec->depth++) return;
+            rec->state.store((domain.epoch.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~Guard() {
+            if(--rec->depth) return;
+            rec->state.store(0, std::memory_order_release);
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        // Узел уже недостижим из структуры; deleter(ptr) будет вызван позже, в этом или другом потоке
+        // (если поток завершится раньше - в потоке, который получит его запись)
+        void retire(void* ptr, void (*deleter)(void*)) {
+            rec->retired.push_back(Retired{ptr, deleter, domain.epoch.load(std::memory_order_seq_cst)});
+            if(rec->retired.get_length() >= rec->collect_at) domain._collect(rec);
+        }
+    };
+
+    // Попытка освободить отложенное текущим потоком, не дожидаясь порога
+    void collect() { _collect(_record()); }
+
+    uint64_t get_epoch() const { return epoch.load(std::memory_order_relaxed); }
+};
+
+using EpochGuard = EpochDomain::Guard;
+
+
+// Пул освобожденных узлов типа Node (нужно поле next) у каждого потока: узел, переживший две эпохи,
+// возвращается в пул потока, который его освобождает, и снова выдается этим потоком без new.
+// Пул не больше EPOCH_POOL_SIZE узлов; остаток при завершении потока удаляется.
+template <typename Node>
+class _RecyclePool {
+    // Тривиально разрушаемое состояние можно читать и после разрушения Cleaner этого потока
+    struct State {
+        Node* head;
+        size_t count;
+        bool dead;
+    };
+    struct Cleaner {
+        State* state;
+        ~Cleaner() {
+            while(state->head) {
+                Node* next = state->head->next;
+                delete state->head;
+                state->head = next;
+            }
+            state->count = 0;
+            state->dead = true;
+        }
+    };
+
+    static State& _state() {
+        thread_local State state{nullptr, 0, false};
+        thread_local Cleaner cleaner{&state};
+        (void)cleaner;
+        return state;
+    }
+
+public:
+    static Node* get() {
+        State& state = _state();
+        if(!state.head) return new Node();
+        Node* node = state.head;
+        state.head = node->next;
+        state.count--;
+        return node;
+    }
+    // Подходит как deleter для EpochDomain::retire
+    static void put(void* ptr) {
+        Node* node = static_cast<Node*>(ptr);
+        State& state = _state();
+        if(state.dead || state.count >= EPOCH_POOL_SIZE) {
+            delete node;
+            return;
+        }
+        node->data = decltype(node->data)();
+        node->next = state.head;
+        state.head = node;
+        state.count++;
+    }
+};
+}
@@ -1,85 +1,103 @@
 #pragma once
 
-#include <string>
+#include <exception>
+
+#include "Stats.hpp"
 
 
 namespace siilib {
 
 class Exception : public std::exception {
 protected:
-    std::string msg;
+    const char* msg;
 public:
-    Exception(std::string msg) : msg(msg) { }
-    const char* what() const noexcept override { return msg.c_str(); }
+    Exception(const char* msg) noexcept : msg(msg) { _StatsThrow::count(); }
+    const char* what() const noexcept override { return msg; }
 };
 
 
 
 class LookupException : public Exception {
 public:
-    LookupException(std::string msg) : Exception(msg) { }
+    LookupException(const char* msg) noexcept : Exception(msg) { }
 };
 
 class IndexError : public LookupException {
 public:
-    IndexError() : LookupException("Invalid element index") { }
+    IndexError() noexcept : LookupException("Invalid element index") { }
 };
 
 class KeyError : public LookupException {
 public:
-    KeyError() : LookupException("Key not found") { }
+    KeyError() noexcept : LookupException("Key not found") { }
 };
 
 
 
 class SizeException : public Exception {
 public:
-    SizeException(std::string msg) : Exception(msg) { }
+    SizeException(const char* msg) noexcept : Exception(msg) { }
 };
 
 class EmptyError : public SizeException {
 public:
-    EmptyError() : SizeException("Container is empty") { }
+    EmptyError() noexcept : SizeException("Container is empty") { }
 };
 
 class OverflowError : public SizeException {
 public:
-    OverflowError() : SizeException("Container overflow") { }
+    OverflowError() noexcept : SizeException("Container overflow") { }
 };
 
 
 
 class TypeError : public Exception {
 public:
-    TypeError() : Exception("Invalid type") { }
+    TypeError() noexcept : Exception("Invalid type") { }
 };
 
 
 class ValueError : public Exception {
 public:
-    ValueError() : Exception("Invalid value") { }
+    ValueError() noexcept : Exception("Invalid value") { }
 };
 
 
 
 class MemoryException : public Exception {
 public:
-    MemoryException(std::string msg) : Exception(msg) { }
+    MemoryException(const char* msg) noexcept : Exception(msg) { }
 };
 
 class ResizeError : public MemoryException {
 public:
-    ResizeError() : MemoryException("Resize failed: bad_alloc") { }
+    ResizeError() noexcept : MemoryException("Resize failed: bad_alloc") { }
 };
 
 class AllocError : public MemoryException {
 public:
-    AllocError() : MemoryException("Memory allocation failed: bad_alloc") { }
+    AllocError() noexcept : MemoryException("Memory allocation failed: bad_alloc") { }
+};
+
+
+class IOException : public Exception {
+public:
+    IOException(const char* msg) noexcept : Exception(msg) { }
+};
+
+class IOError : public IOException {
+public:
+    IOError() noexcept : IOException("Read or write failed") { }
+};
+
+class FormatError : public IOException {
+public:
+    FormatError() noexcept : IOException("Invalid or truncated serialized data") { }
 };
 
 
 class ArithmeticException : public Exception {
 public:
-    ArithmeticException(std::string msg) : Exception(msg) { }
+    ArithmeticException(const char* msg) noexcept : Exception(msg) { }
 };
 }
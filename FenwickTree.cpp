@@ -0,0 +1,121 @@
+#pragma once
+
+#include <memory>
+
+#include "Exception.hpp"
+#include "Numeric.cpp"
+#include "Vector.cpp"
+
+
+namespace siilib {
+// Дерево Фенвика (двоичное индексированное дерево): суммы префиксов и диапазонов и изменение элемента за O(log n)
+// вместо O(n) прохода по массиву. Узел i хранит сумму элементов [i & (i + 1), i] - один массив той же длины,
+// что и исходный, без указателей. Построение из Array, Vector или обычного массива - O(n).
+// Диапазоны полуоткрытые [from, to); индексы - size_t. T - числовой тип (нужны +, - и T() == 0).
+template <typename T>
+class FenwickTree {
+    Vector<T> tree;
+
+
+    T* _tree() { return tree.begin(); }
+    const T* _tree() const { return tree.begin(); }
+
+    void _check_range(size_t from, size_t to) const {
+        if(from > to || to > tree.get_length()) throw IndexError();
+    }
+
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    FenwickTree(size_t length=0) {
+        for(size_t i = 0; i < length; ++i) tree.push_back(T());
+    }
+    FenwickTree(const T* first, const T* last) {
+        for(const T* ptr = first; ptr != last; ++ptr) tree.push_back(*ptr);
+        size_t n = tree.get_length();
+        T* t = _tree();
+        for(size_t i = 0; i < n; ++i) {
+            size_t parent = i | (i + 1);
+            if(parent < n) t[parent] += t[i];
+        }
+    }
+    template <typename Container, typename = _NumericContainer<Container>>
+    FenwickTree(const Container& c) : FenwickTree(c.begin(), c.end()) { }
+
+    void clear() { tree.clear(); }
+
+    size_t get_length() const { return tree.get_length(); }
+    bool is_empty() const { return tree.is_empty(); }
+
+    // Новый элемент в конце: сумма его диапазона собирается из уже имеющихся узлов, O(log n)
+    void push_back(const T& x) {
+        size_t i = tree.get_length();
+        T value = x;
+        for(size_t k = i; k > (i & (i + 1)); k &= k - 1) value += _tree()[k - 1];
+        tree.push_back(value);
+    }
+
+    void add(size_t index, const T& delta) {
+        if(index >= tree.get_length()) throw IndexError();
+        T* t = _tree();
+        for(size_t n = tree.get_length(); index < n; index |= index + 1) t[index] += delta;
+    }
+    void set(size_t index, const T& value) { add(index, value - get(index)); }
+
+    T get(size_t index) const {
+        if(index >= tree.get_length()) throw IndexError();
+        const T* t = _tree();
+        T res = t[index];
+        for(size_t k = index, start = index & (index + 1); k > start; k &= k - 1) res -= t[k - 1];
+        return res;
+    }
+
+    // Сумма первых count элементов
+    T prefix_sum(size_t count) const {
+        if(count > tree.get_length()) throw IndexError();
+        const T* t = _tree();
+        T res = T();
+        for(; count; count &= count - 1) res += t[count - 1];
+        return res;
+    }
+    T sum(size_t from, size_t to) const {
+        _check_range(from, to);
+        // Общая часть двух префиксов не считается: спуск идет, пока префиксы не совпадут
+        const T* t = _tree();
+        T res = T();
+        while(to != from) {
+            if(to > from) {
+                res += t[to - 1];
+                to &= to - 1;
+            }
+            else {
+                res -= t[from - 1];
+                from &= from - 1;
+            }
+        }
+        return res;
+    }
+    // Пакет запросов: out[i] = sum(from[i], to[i])
+    void sum(const size_t* from, const size_t* to, size_t count, T* out) const {
+        for(size_t i = 0; i < count; ++i) out[i] = sum(from[i], to[i]);
+    }
+
+    // Индекс первого элемента, на котором сумма префикса достигает value (prefix_sum(index + 1) >= value),
+    // или npos; элементы должны быть неотрицательны. Например, выбор по весам: lower_bound(случайное из (0, total]).
+    size_t lower_bound(T value) const {
+        size_t n = tree.get_length();
+        const T* t = _tree();
+        size_t pos = 0;
+        size_t step = 1;
+        while(step * 2 <= n) step *= 2;
+        for(; n && step; step >>= 1) {
+            if(pos + step <= n && t[pos + step - 1] < value) {
+                pos += step;
+                value -= t[pos - 1];
+            }
+        }
+        return pos < n ? pos : npos;
+    }
+};
+}
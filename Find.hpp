@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+namespace siilib {
+
+// Линейный поиск, общий для Vector, Array и Span. Для целых чисел, перечислений и указателей
+// размером 1, 2, 4 или 8 байт сравнивается сразу 16 байт (SSE2), для остальных типов - обычный цикл.
+template <typename T>
+constexpr bool _simd_searchable = (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+    && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+#ifdef __SSE2__
+template <typename T>
+__m128i _simd_splat(const T& key) {
+    if constexpr(sizeof(T) == 1) { int8_t x; std::memcpy(&x, &key, 1); return _mm_set1_epi8(x); }
+    else if constexpr(sizeof(T) == 2) { int16_t x; std::memcpy(&x, &key, 2); return _mm_set1_epi16(x); }
+    else if constexpr(sizeof(T) == 4) { int32_t x; std::memcpy(&x, &key, 4); return _mm_set1_epi32(x); }
+    else { int64_t x; std::memcpy(&x, &key, 8); return _mm_set1_epi64x(x); }
+}
+
+// Маска байтов 16-байтового блока по адресу ptr, совпавших с needle поэлементно
+template <typename T>
+uint32_t _simd_match(const T* ptr, __m128i needle) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    if constexpr(sizeof(T) == 1) return _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    else if constexpr(sizeof(T) == 2) return _mm_movemask_epi8(_mm_cmpeq_epi16(block, needle));
+    else if constexpr(sizeof(T) == 4) return _mm_movemask_epi8(_mm_cmpeq_epi32(block, needle));
+    else {
+        // В SSE2 нет сравнения 64-битных чисел: обе 32-битные половины должны совпасть
+        __m128i eq = _mm_cmpeq_epi32(block, needle);
+        return _mm_movemask_epi8(_mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+}
+#endif
+
+// Указатель на первый элемент, равный key, или end
+template <typename T>
+const T* _find(const T* begin, const T* end, const T& key) {
+#ifdef __SSE2__
+    if constexpr(_simd_searchable<T>) {
+        constexpr size_t per_block = 16 / sizeof(T);
+        __m128i needle = _simd_splat(key);
+        for(; end - begin >= static_cast<ptrdiff_t>(per_block); begin += per_block) {
+            uint32_t mask = _simd_match(begin, needle);
+            if(mask) return begin + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+#endif
+    for(; begin != end; ++begin) {
+        if(*begin == key) return begin;
+    }
+    return end;
+}
+
+// Указатель на последний элемент, равный key, или end
+template <typename T>
+const T* _rfind(const T* begin, const T* end, const T& key) {
+    const T* cur = end;
+#ifdef __SSE2__
+    if constexpr(_simd_searchable<T>) {
+        constexpr size_t per_block = 16 / sizeof(T);
+        __m128i needle = _simd_splat(key);
+        for(; cur - begin >= static_cast<ptrdiff_t>(per_block); cur -= per_block) {
+            uint32_t mask = _simd_match(cur - per_block, needle);
+            if(mask) return cur - per_block + (31 - __builtin_clz(mask)) / sizeof(T);
+        }
+    }
+#endif
+    while(cur != begin) {
+        if(*--cur == key) return cur;
+    }
+    return end;
+}
+}
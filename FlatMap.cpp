@@ -0,0 +1,176 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <utility>
+
+#include "Exception.hpp"
+#include "Sort.cpp"
+#include "Vector.cpp"
+
+
+namespace siilib {
+// Словарь на двух упорядоченных непрерывных массивах: ключи хранятся отдельно от значений,
+// поэтому бинарный поиск читает только ключи
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+    Vector<K> keys;
+    Vector<V> values;
+    Compare comp;
+
+
+    // Индексы пачки, упорядоченные по ключу; из равных ключей остается последний
+    Vector<size_t> _sorted_batch(const K* ks, size_t len) const {
+        Vector<size_t> order;
+        for(size_t i = 0; i < len; ++i) order.push_back(i);
+        stable_sort(order, [ks, this](size_t a, size_t b) { return comp(ks[a], ks[b]); });
+        size_t* ptr = order.begin();
+        size_t res = 0;
+        for(size_t i = 0; i < len; ++i) {
+            if(i + 1 < len && !comp(ks[ptr[i]], ks[ptr[i + 1]])) continue;
+            ptr[res++] = ptr[i];
+        }
+        while(order.get_length() > res) order.pop_back();
+        return order;
+    }
+
+    size_t _lower(const K& key) const { return siilib::lower_bound(keys.begin(), keys.end(), key, comp) - keys.begin(); }
+
+    template <typename KK, typename VV>
+    V& _insert(KK&& key, VV&& value) {
+        size_t pos = _lower(key);
+        if(pos < keys.get_length() && !comp(key, keys.begin()[pos])) return values.begin()[pos] = std::forward<VV>(value);
+        keys.insert(static_cast<int>(pos), std::forward<KK>(key));
+        return values.insert(static_cast<int>(pos), std::forward<VV>(value));
+    }
+
+
+public:
+    static constexpr int npos = -1;
+
+    FlatMap(const Compare& comp=Compare()) : comp(comp) { }
+    // Построение из неупорядоченных пар: одна сортировка и удаление повторов (остается последнее значение)
+    FlatMap(const K* ks, const V* vs, size_t len, const Compare& comp=Compare()) : comp(comp) {
+        Vector<size_t> order = _sorted_batch(ks, len);
+        for(size_t i : order) {
+            keys.push_back(ks[i]);
+            values.push_back(vs[i]);
+        }
+    }
+    FlatMap(std::initializer_list<std::pair<K, V>> ar, const Compare& comp=Compare()) : comp(comp) {
+        for(const auto& x : ar) this->insert(x.first, x.second);
+    }
+
+    void clear() {
+        keys.clear();
+        values.clear();
+    }
+
+    bool is_empty() const { return keys.is_empty(); }
+
+    size_t get_length() const { return keys.get_length(); }
+
+    V& insert(const K& key, const V& value) { return _insert(key, value); }
+    V& insert(K&& key, V&& value) { return _insert(std::move(key), std::move(value)); }
+
+    // Пакетная вставка за один проход слияния с конца массивов; значения существующих ключей перезаписываются
+    void insert(const K* ks, const V* vs, size_t len) {
+        Vector<size_t> order = _sorted_batch(ks, len);
+        size_t old_len = keys.get_length();
+        size_t add = 0;
+        size_t a = 0;
+        for(size_t i : order) {
+            while(a < old_len && comp(keys.begin()[a], ks[i])) ++a;
+            if(a < old_len && !comp(ks[i], keys.begin()[a])) values.begin()[a] = vs[i];
+            else add++;
+        }
+        if(add == 0) return;
+        for(size_t i = 0; i < add; ++i) {
+            keys.push_back(K());
+            values.push_back(V());
+        }
+        K* kp = keys.begin();
+        V* vp = values.begin();
+        size_t i = old_len;
+        size_t out = old_len + add;
+        const size_t* b = order.end();
+        while(b != order.begin()) {
+            const K& key = ks[*(b - 1)];
+            if(i > 0 && comp(key, kp[i - 1])) {
+                --out;
+                --i;
+                kp[out] = std::move(kp[i]);
+                vp[out] = std::move(vp[i]);
+            }
+            else if(i > 0 && !comp(kp[i - 1], key)) --b;
+            else {
+                --out;
+                --b;
+                kp[out] = ks[*b];
+                vp[out] = vs[*b];
+            }
+        }
+    }
+
+    void remove(const K& key) {
+        if(!try_remove(key)) throw KeyError();
+    }
+    bool try_remove(const K& key) {
+        int index = try_find(key);
+        if(index == npos) return false;
+        keys.erase(index);
+        values.erase(index);
+        return true;
+    }
+
+    size_t lower_bound(const K& key) const { return _lower(key); }
+    size_t upper_bound(const K& key) const { return siilib::upper_bound(keys.begin(), keys.end(), key, comp) - keys.begin(); }
+
+    int find(const K& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const K& key) const {
+        size_t pos = _lower(key);
+        if(pos == keys.get_length() || comp(key, keys.begin()[pos])) return npos;
+        return pos;
+    }
+    bool contains(const K& key) const { return try_find(key) != npos; }
+
+    V* get(const K& key) {
+        int index = try_find(key);
+        return index == npos ? nullptr : values.begin() + index;
+    }
+    const V* get(const K& key) const {
+        int index = try_find(key);
+        return index == npos ? nullptr : values.begin() + index;
+    }
+
+    V& at(const K& key) {
+        V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+    const V& at(const K& key) const {
+        const V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+
+    V& operator[](const K& key) {
+        size_t pos = _lower(key);
+        if(pos < keys.get_length() && !comp(key, keys.begin()[pos])) return values.begin()[pos];
+        keys.insert(static_cast<int>(pos), key);
+        return values.insert(static_cast<int>(pos), V());
+    }
+
+    // Доступ по позиции в отсортированном порядке
+    const K& key(int index) const { return keys[index]; }
+    V& value(int index) { return values[index]; }
+    const V& value(int index) const { return values[index]; }
+
+    const Vector<K>& get_keys() const { return keys; }
+    const Vector<V>& get_values() const { return values; }
+};
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <functional>
+
+#include "SortedVector.cpp"
+
+
+namespace siilib {
+// Множество на упорядоченном непрерывном массиве: быстрый поиск и обход, вставка и удаление за O(n)
+template <typename K, typename Compare = std::less<K>, typename CheckPolicy = Checked>
+using FlatSet = SortedVector<K, Compare, true, CheckPolicy>;
+}
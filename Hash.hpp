@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+
+namespace siilib {
+
+inline uint64_t hash_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Хэш по умолчанию: std::hash с перемешиванием битов (std::hash для целых - тождественная функция,
+// а хэш-таблицам нужны равномерно распределенные все биты хэша)
+template <typename K>
+struct Hash {
+    size_t operator()(const K& key) const { return hash_mix(std::hash<K>{}(key)); }
+};
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <utility>
+
+#include "Exception.hpp"
+#include "Hash.hpp"
+#include "HashTable.cpp"
+
+
+namespace siilib {
+template <typename K, typename V, typename Hash = siilib::Hash<K>, typename KeyEqual = std::equal_to<K>>
+class HashMap {
+    struct _Slot {
+        K key;
+        V value;
+    };
+
+public:
+    // Элемент при обходе (как у BTreeMap): ключ менять нельзя - он определяет положение в таблице
+    struct Entry {
+        const K& key;
+        V& value;
+    };
+    struct ConstEntry {
+        const K& key;
+        const V& value;
+    };
+
+private:
+    using Table = HashTable<_Slot, K, Hash, KeyEqual>;
+
+    Table table;
+
+    template <typename E, typename T>
+    class _Iterator {
+        T* table;
+        size_t index;
+    public:
+        _Iterator(T* table, size_t index) : table(table), index(table->next(index)) { }
+        E operator*() const { return E{table->slot(index).key, table->slot(index).value}; }
+        const K& key() const { return table->slot(index).key; }
+        decltype(std::declval<E>().value) value() const { return table->slot(index).value; }
+        _Iterator& operator++() { index = table->next(index + 1); return *this; }
+        bool operator==(const _Iterator& right) const { return index == right.index; }
+        bool operator!=(const _Iterator& right) const { return index != right.index; }
+    };
+
+public:
+    using Iterator = _Iterator<Entry, Table>;
+    using ConstIterator = _Iterator<ConstEntry, const Table>;
+
+    HashMap(size_t capacity=0, const Hash& hasher=Hash(), const KeyEqual& key_equal=KeyEqual()) : table(capacity, hasher, key_equal) { }
+    HashMap(std::initializer_list<std::pair<K, V>> ar) : table(ar.size()) {
+        for(const std::pair<K, V>& x : ar) this->insert(x.first, x.second);
+    }
+
+    void clear() { table.clear(); }
+    void reserve(size_t length) { table.reserve(length); }
+    void set_max_load_factor(float load_factor) { table.set_max_load_factor(load_factor); }
+
+    size_t get_length() const { return table.get_length(); }
+    size_t get_capacity() const { return table.get_capacity(); }
+    size_t get_size() const { return table.get_size(); }
+    float get_max_load_factor() const { return table.get_max_load_factor(); }
+    float get_load_factor() const { return table.get_load_factor(); }
+    bool is_empty() const { return table.is_empty(); }
+
+    // Счетчики работы (нулевые без -DSIILIB_STATS)
+    StatsSnapshot get_stats() const { return table.get_stats(); }
+    void reset_stats() { table.reset_stats(); }
+
+    V& insert(const K& key, const V& value) {
+        auto res = table.emplace(key, value);
+        if(!res.second) res.first->value = value;
+        return res.first->value;
+    }
+    V& insert(const K& key, V&& value) {
+        auto res = table.emplace(key, std::move(value));
+        if(!res.second) res.first->value = std::move(value);
+        return res.first->value;
+    }
+    V& insert(K&& key, V&& value) {
+        auto res = table.emplace(std::move(key), std::move(value));
+        if(!res.second) res.first->value = std::move(value);
+        return res.first->value;
+    }
+
+    void remove(const K& key) {
+        if(!table.erase(key)) throw KeyError();
+    }
+    bool try_remove(const K& key) {
+        return table.erase(key);
+    }
+
+    bool contains(const K& key) const { return table.find(key) != table.npos; }
+
+    V* get(const K& key) {
+        size_t i = table.find(key);
+        return i == table.npos ? nullptr : &table.slot(i).value;
+    }
+    const V* get(const K& key) const {
+        size_t i = table.find(key);
+        return i == table.npos ? nullptr : &table.slot(i).value;
+    }
+
+    V& at(const K& key) {
+        V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+    const V& at(const K& key) const {
+        const V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+
+    V& operator[](const K& key) { return table.emplace(key, V()).first->value; }
+    V& operator[](K&& key) { return table.emplace(std::move(key), V()).first->value; }
+
+    Iterator begin() { return Iterator(&table, 0); }
+    Iterator end() { return Iterator(&table, table.get_capacity()); }
+    ConstIterator begin() const { return ConstIterator(&table, 0); }
+    ConstIterator end() const { return ConstIterator(&table, table.get_capacity()); }
+};
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+
+#include "Exception.hpp"
+#include "Hash.hpp"
+#include "HashTable.cpp"
+
+
+namespace siilib {
+template <typename K, typename Hash = siilib::Hash<K>, typename KeyEqual = std::equal_to<K>>
+class HashSet {
+    struct Entry {
+        K key;
+    };
+
+    HashTable<Entry, K, Hash, KeyEqual> table;
+
+public:
+    class Iterator {
+        const HashTable<Entry, K, Hash, KeyEqual>* table;
+        size_t index;
+    public:
+        Iterator(const HashTable<Entry, K, Hash, KeyEqual>* table, size_t index) : table(table), index(table->next(index)) { }
+        const K& operator*() const { return table->slot(index).key; }
+        const K* operator->() const { return &table->slot(index).key; }
+        Iterator& operator++() { index = table->next(index + 1); return *this; }
+        bool operator==(const Iterator& right) const { return index == right.index; }
+        bool operator!=(const Iterator& right) const { return index != right.index; }
+    };
+
+    HashSet(size_t capacity=0, const Hash& hasher=Hash(), const KeyEqual& key_equal=KeyEqual()) : table(capacity, hasher, key_equal) { }
+    HashSet(std::initializer_list<K> ar) : table(ar.size()) {
+        for(const K& x : ar) this->insert(x);
+    }
+
+    void clear() { table.clear(); }
+    void reserve(size_t length) { table.reserve(length); }
+    void set_max_load_factor(float load_factor) { table.set_max_load_factor(load_factor); }
+
+    size_t get_length() const { return table.get_length(); }
+    size_t get_capacity() const { return table.get_capacity(); }
+    size_t get_size() const { return table.get_size(); }
+    float get_max_load_factor() const { return table.get_max_load_factor(); }
+    float get_load_factor() const { return table.get_load_factor(); }
+    bool is_empty() const { return table.is_empty(); }
+
+    // Счетчики работы (нулевые без -DSIILIB_STATS)
+    StatsSnapshot get_stats() const { return table.get_stats(); }
+    void reset_stats() { table.reset_stats(); }
+
+    bool insert(const K& key) { return table.emplace(key).second; }
+    bool insert(K&& key) { return table.emplace(std::move(key)).second; }
+
+    void remove(const K& key) {
+        if(!table.erase(key)) throw KeyError();
+    }
+    bool try_remove(const K& key) {
+        return table.erase(key);
+    }
+
+    bool contains(const K& key) const { return table.find(key) != table.npos; }
+
+    Iterator begin() const { return Iterator(&table, 0); }
+    Iterator end() const { return Iterator(&table, table.get_capacity()); }
+};
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "Exception.hpp"
+#include "Hash.hpp"
+#include "Stats.hpp"
+
+
+#define HASH_TABLE_GROUP_WIDTH 16
+#define HASH_TABLE_MIN_CAPACITY 16
+#define HASH_TABLE_MAX_LOAD_FACTOR 0.875f
+
+
+namespace siilib {
+
+// Группа из 16 управляющих байтов: EMPTY (старший бит установлен) или 7 бит хэша занятой ячейки
+class _HashGroup {
+#ifdef __SSE2__
+    __m128i ctrl;
+public:
+    explicit _HashGroup(const int8_t* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) { }
+
+    uint32_t match(int8_t h2) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)); }
+    uint32_t match_empty() const { return _mm_movemask_epi8(ctrl); }
+#else
+    const int8_t* ctrl;
+public:
+    explicit _HashGroup(const int8_t* pos) : ctrl(pos) { }
+
+    uint32_t match(int8_t h2) const {
+        uint32_t mask = 0;
+        for(int i = 0; i < HASH_TABLE_GROUP_WIDTH; ++i) mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        return mask;
+    }
+    uint32_t match_empty() const {
+        uint32_t mask = 0;
+        for(int i = 0; i < HASH_TABLE_GROUP_WIDTH; ++i) mask |= static_cast<uint32_t>(ctrl[i] < 0) << i;
+        return mask;
+    }
+#endif
+};
+
+
+// Открытая адресация с линейным пробированием, просматриваемым группами по 16 ячеек.
+// Удаление без "надгробий": последующие элементы цепочки сдвигаются назад (backward shift),
+// поэтому между домашней ячейкой элемента и самим элементом никогда нет пустых ячеек.
+template <typename Slot, typename Key, typename Hash, typename KeyEqual>
+class HashTable : public _Stats {
+    static constexpr int8_t EMPTY = -128;
+
+    Slot* slots{nullptr};
+    int8_t* ctrl{nullptr};
+    size_t length{0};
+    size_t capacity{0};
+    size_t growth_limit{0};
+    float max_load_factor{HASH_TABLE_MAX_LOAD_FACTOR};
+    Hash hasher;
+    KeyEqual key_equal;
+
+
+    static size_t _h1(size_t hash) { return hash >> 7; }
+    static int8_t _h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+    void _set_ctrl(size_t i, int8_t h) {
+        ctrl[i] = h;
+        if(i < HASH_TABLE_GROUP_WIDTH - 1) ctrl[capacity + i] = h;
+    }
+
+    static size_t _bytes(size_t cap) { return cap * sizeof(Slot) + cap + HASH_TABLE_GROUP_WIDTH - 1; }
+
+    void _allocate(size_t cap) {
+        try {
+            slots = std::allocator<Slot>().allocate(cap);
+            ctrl = new int8_t[cap + HASH_TABLE_GROUP_WIDTH - 1];
+        }
+        catch(const std::bad_alloc&) {
+            if(slots) std::allocator<Slot>().deallocate(slots, cap);
+            slots = nullptr;
+            throw AllocError();
+        }
+        this->_stat_alloc(_bytes(cap));
+        for(size_t i = 0; i < cap + HASH_TABLE_GROUP_WIDTH - 1; ++i) ctrl[i] = EMPTY;
+        capacity = cap;
+        growth_limit = static_cast<size_t>(cap * max_load_factor);
+    }
+
+    void _deallocate() {
+        if(slots) {
+            for(size_t i = 0; i < capacity; ++i) {
+                if(ctrl[i] != EMPTY) slots[i].~Slot();
+            }
+            std::allocator<Slot>().deallocate(slots, capacity);
+            this->_stat_free(_bytes(capacity));
+        }
+        delete[] ctrl;
+        slots = nullptr;
+        ctrl = nullptr;
+        length = capacity = growth_limit = 0;
+    }
+
+    size_t _find_empty(size_t hash) const {
+        size_t mask = capacity - 1;
+        size_t pos = _h1(hash) & mask;
+        while(true) {
+            uint32_t empty = _HashGroup(ctrl + pos).match_empty();
+            if(empty) return (pos + __builtin_ctz(empty)) & mask;
+            pos = (pos + HASH_TABLE_GROUP_WIDTH) & mask;
+        }
+    }
+
+    static size_t _capacity_for(size_t len, float load_factor) {
+        size_t cap = HASH_TABLE_MIN_CAPACITY;
+        while(static_cast<size_t>(cap * load_factor) < len) cap *= 2;
+        return cap;
+    }
+
+    void _rehash(size_t cap) {
+        Slot* old_slots = slots;
+        int8_t* old_ctrl = ctrl;
+        size_t old_capacity = capacity;
+        slots = nullptr;
+        ctrl = nullptr;
+        try { _allocate(cap); }
+        catch(const AllocError&) {
+            slots = old_slots;
+            ctrl = old_ctrl;
+            capacity = old_capacity;
+            throw ResizeError();
+        }
+        this->_stat_realloc();
+        this->_stat_moved(length);
+        for(size_t i = 0; i < old_capacity; ++i) {
+            if(old_ctrl[i] == EMPTY) continue;
+            size_t hash = hasher(old_slots[i].key);
+            size_t j = _find_empty(hash);
+            new (slots + j) Slot(std::move(old_slots[i]));
+            _set_ctrl(j, _h2(hash));
+            old_slots[i].~Slot();
+        }
+        if(old_slots) {
+            std::allocator<Slot>().deallocate(old_slots, old_capacity);
+            this->_stat_free(_bytes(old_capacity));
+        }
+        delete[] old_ctrl;
+    }
+
+    void _copy_from(const HashTable& right) {
+        _allocate(right.capacity ? right.capacity : HASH_TABLE_MIN_CAPACITY);
+        for(size_t i = 0; i < right.capacity; ++i) {
+            if(right.ctrl[i] == EMPTY) continue;
+            new (slots + i) Slot(right.slots[i]);
+            _set_ctrl(i, right.ctrl[i]);
+        }
+        length = right.length;
+        this->_stat_copied(length);
+    }
+
+    void _erase_at(size_t i) {
+        size_t mask = capacity - 1;
+        slots[i].~Slot();
+        _set_ctrl(i, EMPTY);
+        length--;
+        for(size_t j = (i + 1) & mask; ctrl[j] != EMPTY; j = (j + 1) & mask) {
+            size_t home = _h1(hasher(slots[j].key)) & mask;
+            if(((j - home) & mask) < ((j - i) & mask)) continue;
+            new (slots + i) Slot(std::move(slots[j]));
+            this->_stat_moved(1);
+            _set_ctrl(i, ctrl[j]);
+            slots[j].~Slot();
+            _set_ctrl(j, EMPTY);
+            i = j;
+        }
+    }
+
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Таблица после перемещения из нее остается пустой и без памяти (capacity == 0):
+    // поиск сразу дает npos, первая вставка выделяет HASH_TABLE_MIN_CAPACITY ячеек
+    HashTable(size_t capacity=0, const Hash& hasher=Hash(), const KeyEqual& key_equal=KeyEqual()) : hasher(hasher), key_equal(key_equal) {
+        _allocate(_capacity_for(capacity, max_load_factor));
+    }
+    HashTable(const HashTable& right) : _Stats(), max_load_factor(right.max_load_factor), hasher(right.hasher), key_equal(right.key_equal) {
+        _copy_from(right);
+    }
+    HashTable(HashTable&& right) noexcept : slots(right.slots), ctrl(right.ctrl), length(right.length), capacity(right.capacity),
+            growth_limit(right.growth_limit), max_load_factor(right.max_load_factor), hasher(std::move(right.hasher)), key_equal(std::move(right.key_equal)) {
+        right.slots = nullptr;
+        right.ctrl = nullptr;
+        right.length = right.capacity = right.growth_limit = 0;
+    }
+    ~HashTable() {
+        _deallocate();
+    }
+
+    HashTable& operator=(const HashTable& right) {
+        if(&right == this) return *this;
+        _deallocate();
+        max_load_factor = right.max_load_factor;
+        hasher = right.hasher;
+        key_equal = right.key_equal;
+        _copy_from(right);
+        return *this;
+    }
+    HashTable& operator=(HashTable&& right) noexcept {
+        if(&right == this) return *this;
+        _deallocate();
+        slots = right.slots;
+        ctrl = right.ctrl;
+        length = right.length;
+        capacity = right.capacity;
+        growth_limit = right.growth_limit;
+        max_load_factor = right.max_load_factor;
+        hasher = std::move(right.hasher);
+        key_equal = std::move(right.key_equal);
+        right.slots = nullptr;
+        right.ctrl = nullptr;
+        right.length = right.capacity = right.growth_limit = 0;
+        return *this;
+    }
+
+
+    void clear() {
+        if(capacity == 0) return;
+        for(size_t i = 0; i < capacity; ++i) {
+            if(ctrl[i] != EMPTY) slots[i].~Slot();
+        }
+        for(size_t i = 0; i < capacity + HASH_TABLE_GROUP_WIDTH - 1; ++i) ctrl[i] = EMPTY;
+        length = 0;
+    }
+
+    void reserve(size_t len) {
+        size_t cap = _capacity_for(len, max_load_factor);
+        if(cap > capacity) _rehash(cap);
+    }
+
+    void set_max_load_factor(float load_factor) {
+        if(!(load_factor >= 0.25f && load_factor <= 0.9375f)) throw ValueError();
+        max_load_factor = load_factor;
+        growth_limit = static_cast<size_t>(capacity * max_load_factor);
+        if(length > growth_limit) _rehash(_capacity_for(length, max_load_factor));
+    }
+
+    size_t get_length() const { return length; }
+    size_t get_capacity() const { return capacity; }
+    size_t get_size() const { return capacity * (sizeof(Slot) + 1); }
+    float get_max_load_factor() const { return max_load_factor; }
+    float get_load_factor() const { return capacity ? static_cast<float>(length) / capacity : 0.0f; }
+    bool is_empty() const { return length == 0; }
+
+
+    size_t find(const Key& key) const {
+        if(capacity == 0) return npos;
+        size_t hash = hasher(key);
+        int8_t h2 = _h2(hash);
+        size_t mask = capacity - 1;
+        size_t pos = _h1(hash) & mask;
+        while(true) {
+            _HashGroup group(ctrl + pos);
+            for(uint32_t match = group.match(h2); match; match &= match - 1) {
+                size_t i = (pos + __builtin_ctz(match)) & mask;
+                if(key_equal(slots[i].key, key)) return i;
+            }
+            if(group.match_empty()) return npos;
+            pos = (pos + HASH_TABLE_GROUP_WIDTH) & mask;
+        }
+    }
+
+    // Возвращает ячейку с ключом key и true, если она была создана из (key, args...)
+    template <typename K, typename... Args>
+    std::pair<Slot*, bool> emplace(K&& key, Args&&... args) {
+        size_t i = find(key);
+        if(i != npos) return {slots + i, false};
+        if(length + 1 > growth_limit) _rehash(capacity ? capacity * 2 : HASH_TABLE_MIN_CAPACITY);
+        size_t hash = hasher(key);
+        i = _find_empty(hash);
+        new (slots + i) Slot{std::forward<K>(key), std::forward<Args>(args)...};
+        _set_ctrl(i, _h2(hash));
+        length++;
+        return {slots + i, true};
+    }
+
+    bool erase(const Key& key) {
+        size_t i = find(key);
+        if(i == npos) return false;
+        _erase_at(i);
+        return true;
+    }
+
+    Slot& slot(size_t i) { return slots[i]; }
+    const Slot& slot(size_t i) const { return slots[i]; }
+
+    // Индекс первой занятой ячейки, начиная с i, или capacity
+    size_t next(size_t i) const {
+        while(i < capacity && ctrl[i] == EMPTY) ++i;
+        return i;
+    }
+};
+}
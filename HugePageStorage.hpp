@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Storage.hpp"
+#include "ThreadPool.cpp"
+
+
+#define HUGEPAGE_SIZE (size_t(2) << 20)
+#define HUGEPAGE_THRESHOLD (size_t(2) << 20)
+
+
+namespace siilib {
+// Размещение памяти по узлам NUMA:
+//     none - как решит ядро (обычно узел потока, первым коснувшегося страницы);
+//     interleave - страницы по очереди на всех узлах (mbind MPOL_INTERLEAVE);
+//     bind - только на узле Node (mbind MPOL_BIND);
+//     first_touch - страницы сразу касаются потоки ThreadPool::global(), и каждая часть буфера
+//         оказывается на узле потока, который затем будет ее обрабатывать в parallel_* алгоритмах.
+enum class NumaMode { none, interleave, bind, first_touch };
+
+// Буферы от HUGEPAGE_THRESHOLD байт выделяются через mmap с madvise(MADV_HUGEPAGE), меньшие - через new[].
+// Рост и уменьшение буфера тривиально копируемых элементов - через mremap, без копирования.
+// Если прозрачные большие страницы (THP) или NUMA недоступны, соответствующие вызовы просто не действуют.
+template <NumaMode Mode = NumaMode::none, int Node = 0>
+struct HugePageStorage {
+    static bool _mapped(size_t bytes) { return bytes >= HUGEPAGE_THRESHOLD; }
+    static size_t _round(size_t bytes) { return (bytes + HUGEPAGE_SIZE - 1) / HUGEPAGE_SIZE * HUGEPAGE_SIZE; }
+
+    // Маска узлов из /sys/devices/system/node/online ("0", "0-1", "0,2-3"); 0 - сведений нет
+    static unsigned long _online_nodes() {
+        static unsigned long nodes = [] {
+            unsigned long mask = 0;
+            FILE* file = std::fopen("/sys/devices/system/node/online", "r");
+            if(!file) return mask;
+            unsigned from, to;
+            char sep;
+            while(std::fscanf(file, "%u", &from) == 1) {
+                to = from;
+                if(std::fscanf(file, "%c", &sep) == 1 && sep == '-') {
+                    if(std::fscanf(file, "%u", &to) != 1) break;
+                    if(std::fscanf(file, "%c", &sep) != 1) sep = '\n';
+                }
+                for(unsigned node = from; node <= to && node < 64; ++node) mask |= 1UL << node;
+                if(sep != ',') break;
+            }
+            std::fclose(file);
+            return mask;
+        }();
+        return nodes;
+    }
+
+    static void _advise(void* ptr, size_t bytes) {
+#ifdef MADV_HUGEPAGE
+        ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+#ifdef SYS_mbind
+        if constexpr(Mode == NumaMode::interleave || Mode == NumaMode::bind) {
+            unsigned long mask = Mode == NumaMode::bind ? 1UL << Node : _online_nodes();
+            // MPOL_BIND = 2, MPOL_INTERLEAVE = 3; на машине с одним узлом или без NUMA ядро вернет ошибку - это не страшно
+            if(mask) ::syscall(SYS_mbind, ptr, bytes, Mode == NumaMode::bind ? 2 : 3, &mask, sizeof(mask) * 8 + 1, 0);
+        }
+#endif
+    }
+
+    // Каждый поток пула касается своей части буфера (частями, кратными большой странице)
+    static void _first_touch(char* ptr, size_t bytes) {
+        ThreadPool& pool = ThreadPool::global();
+        size_t pages = bytes / HUGEPAGE_SIZE;
+        size_t parts = pool.get_threads() < pages ? pool.get_threads() : pages;
+        pool.run(parts ? parts : 1, [&](size_t part) {
+            size_t from = pages * part / parts * HUGEPAGE_SIZE, to = pages * (part + 1) / parts * HUGEPAGE_SIZE;
+            for(size_t i = from; i < to; i += 4096) ptr[i] = 0;
+        });
+    }
+
+    // mmap выравнивает только по 4 КиБ, а большая страница нужна выровненная по HUGEPAGE_SIZE:
+    // область берется с запасом в одну большую страницу, лишнее по краям сразу возвращается ядру.
+    // Начало выровненной области и есть адрес буфера, поэтому munmap и mremap работают с ним напрямую.
+    static void* _map(size_t bytes) {
+        void* raw = ::mmap(nullptr, bytes + HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(raw == MAP_FAILED) return nullptr;
+        uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (begin + HUGEPAGE_SIZE - 1) & ~(uintptr_t(HUGEPAGE_SIZE) - 1);
+        size_t head = aligned - begin;
+        if(head) ::munmap(raw, head);
+        ::munmap(reinterpret_cast<void*>(aligned + bytes), HUGEPAGE_SIZE - head);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    template <typename T>
+    static void _construct(T* ptr, size_t from, size_t to) {
+        // Память от mmap заполнена нулями, этого достаточно для типов без конструктора по умолчанию
+        if constexpr(!std::is_trivially_default_constructible_v<T>) {
+            for(size_t i = from; i < to; ++i) new(ptr + i) T();
+        }
+    }
+
+    template <typename T>
+    static T* allocate(size_t n) {
+        size_t bytes = n * sizeof(T);
+        if(!_mapped(bytes)) return new T[n];
+        void* ptr = _map(_round(bytes));
+        if(!ptr) throw std::bad_alloc();
+        _advise(ptr, _round(bytes));
+        if constexpr(Mode == NumaMode::first_touch) _first_touch(static_cast<char*>(ptr), _round(bytes));
+        _construct(static_cast<T*>(ptr), 0, n);
+        return static_cast<T*>(ptr);
+    }
+
+    template <typename T>
+    static void deallocate(T* ptr, size_t n) {
+        if(!ptr) return;
+        if(!_mapped(n * sizeof(T))) {
+            delete[] ptr;
+            return;
+        }
+        if constexpr(!std::is_trivially_destructible_v<T>) {
+            for(size_t i = 0; i < n; ++i) ptr[i].~T();
+        }
+        ::munmap(ptr, _round(n * sizeof(T)));
+    }
+
+    template <typename T>
+    static T* reallocate(T* ptr, size_t old_n, size_t new_n) {
+#ifdef MREMAP_MAYMOVE
+        if constexpr(std::is_trivially_copyable_v<T>) {
+            if(!ptr || !_mapped(old_n * sizeof(T)) || !_mapped(new_n * sizeof(T))) return nullptr;
+            size_t old_bytes = _round(old_n * sizeof(T)), new_bytes = _round(new_n * sizeof(T));
+            void* res = ptr;
+            if(old_bytes != new_bytes) {
+                // Ядро переносит страницы, а не их содержимое; при неудаче - обычное копирование.
+                // Сначала - на месте; перенос идет только в заранее выровненную область (MREMAP_FIXED),
+                // иначе ядро выберет адрес, выровненный лишь по 4 КиБ
+                res = ::mremap(ptr, old_bytes, new_bytes, 0);
+                if(res == MAP_FAILED) {
+#ifdef MREMAP_FIXED
+                    void* to = _map(new_bytes);
+                    if(!to) return nullptr;
+                    res = ::mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, to);
+                    if(res == MAP_FAILED) {
+                        ::munmap(to, new_bytes);
+                        return nullptr;
+                    }
+#else
+                    return nullptr;
+#endif
+                }
+                _advise(res, new_bytes);
+            }
+            if(new_n > old_n) _construct(static_cast<T*>(res), old_n, new_n);
+            return static_cast<T*>(res);
+        }
+#endif
+        return nullptr;
+    }
+};
+
+using InterleavedStorage = HugePageStorage<NumaMode::interleave>;
+template <int Node>
+using NodeStorage = HugePageStorage<NumaMode::bind, Node>;
+using FirstTouchStorage = HugePageStorage<NumaMode::first_touch>;
+}
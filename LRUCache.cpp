@@ -0,0 +1,287 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+
+#include "DoubleLinkedList.cpp"
+#include "Exception.hpp"
+#include "Hash.hpp"
+#include "HashMap.cpp"
+
+
+#define SLRUCACHE_PROTECTED_SHARE 0.8f
+
+
+namespace siilib {
+// Счетчики обращений кэша: get и at считают попадания и промахи, put - вытеснения
+struct CacheCounters {
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+
+    double get_hit_rate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+
+// Кэш с вытеснением давно не использованных элементов (LRU). Элементы лежат в DoubleLinkedList от самого
+// свежего к самому старому, HashMap хранит ручку узла для каждого ключа, поэтому get, put и remove - O(1):
+// обращение переставляет узел в начало, вытеснение снимает последний.
+// При вытеснении из-за емкости вызывается on_evict(key, value) (remove и clear его не вызывают).
+// get возвращает указатель на значение (nullptr - промах), действительный до следующего изменения кэша.
+template <typename K, typename V, typename Hash = siilib::Hash<K>, typename KeyEqual = std::equal_to<K>>
+class LRUCache {
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+    using OnEvict = std::function<void(const K&, V&)>;
+
+private:
+    using List = DoubleLinkedList<Entry>;
+    using Handle = typename List::Handle;
+
+    List list;
+    HashMap<K, Handle, Hash, KeyEqual> index;
+    size_t capacity;
+    OnEvict on_evict;
+    CacheCounters counters;
+
+
+    void _evict() {
+        Handle last = list.back_handle();
+        if(on_evict) on_evict(last->key, last->value);
+        index.remove(last->key);
+        list.erase(last);
+        counters.evictions++;
+    }
+
+
+public:
+    LRUCache(size_t capacity, OnEvict on_evict=nullptr) : index(capacity), capacity(capacity), on_evict(std::move(on_evict)) {
+        if(capacity == 0) throw ValueError();
+    }
+    // Ручки в скопированном индексе указывают на узлы исходного списка - они заменяются ручками копии
+    LRUCache(const LRUCache& right) : list(right.list), index(right.index), capacity(right.capacity), on_evict(right.on_evict), counters(right.counters) {
+        for(Handle h = list.front_handle(); h; h = list.next(h)) *index.get(h->key) = h;
+    }
+    LRUCache(LRUCache&&) = default;
+
+    LRUCache& operator=(const LRUCache& right) {
+        if(&right != this) *this = LRUCache(right);
+        return *this;
+    }
+    LRUCache& operator=(LRUCache&&) = default;
+
+    void clear() {
+        list.clear();
+        index.clear();
+    }
+
+    size_t get_length() const { return list.get_length(); }
+    size_t get_capacity() const { return capacity; }
+    bool is_empty() const { return list.is_empty(); }
+    // Уменьшение емкости сразу вытесняет лишние элементы
+    void set_capacity(size_t capacity) {
+        if(capacity == 0) throw ValueError();
+        this->capacity = capacity;
+        while(list.get_length() > capacity) _evict();
+    }
+    void set_on_evict(OnEvict on_evict) { this->on_evict = std::move(on_evict); }
+
+    const CacheCounters& get_counters() const { return counters; }
+    void reset_counters() { counters = CacheCounters(); }
+
+    // Добавляет или заменяет значение и делает элемент самым свежим; полный кэш вытесняет самый старый
+    V& put(const K& key, V value) {
+        if(Handle* h = index.get(key)) {
+            list.move_to_front(*h);
+            return (*h)->value = std::move(value);
+        }
+        if(list.get_length() >= capacity) _evict();
+        list.push_front(Entry{key, std::move(value)});
+        index.insert(key, list.front_handle());
+        return list.front().value;
+    }
+
+    V* get(const K& key) {
+        Handle* h = index.get(key);
+        if(!h) {
+            counters.misses++;
+            return nullptr;
+        }
+        counters.hits++;
+        list.move_to_front(*h);
+        return &(*h)->value;
+    }
+    V& at(const K& key) {
+        V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+    // Без изменения порядка вытеснения и счетчиков
+    const V* peek(const K& key) const {
+        const Handle* h = index.get(key);
+        return h ? &(*h)->value : nullptr;
+    }
+    bool contains(const K& key) const { return index.contains(key); }
+
+    void remove(const K& key) {
+        if(!try_remove(key)) throw KeyError();
+    }
+    bool try_remove(const K& key) {
+        Handle* h = index.get(key);
+        if(!h) return false;
+        Handle node = *h;
+        index.remove(key);
+        list.erase(node);
+        return true;
+    }
+
+    // f(const Entry&) от самого свежего элемента к самому старому
+    template <typename F>
+    void for_each(F f) const {
+        for(Handle h = list.front_handle(); h; h = list.next(h)) f(*h);
+    }
+};
+
+
+// Сегментированный LRU: новые ключи попадают в испытательный сегмент, повторное обращение переносит элемент
+// в защищенный (доля protected_share емкости). Переполненный защищенный сегмент возвращает свой самый старый
+// элемент в начало испытательного, а вытесняется самый старый элемент испытательного. Поэтому однократное
+// чтение множества ключей (сканирование) не вымывает часто используемые элементы, как в простом LRU.
+// Узлы переходят между сегментами через splice, без копирования; интерфейс - как у LRUCache.
+template <typename K, typename V, typename Hash = siilib::Hash<K>, typename KeyEqual = std::equal_to<K>>
+class SLRUCache {
+public:
+    using Entry = typename LRUCache<K, V, Hash, KeyEqual>::Entry;
+    using OnEvict = std::function<void(const K&, V&)>;
+
+private:
+    using List = DoubleLinkedList<Entry>;
+    using Handle = typename List::Handle;
+    struct Slot {
+        Handle handle;
+        bool is_protected{false};
+    };
+
+    List probation;
+    List protect;
+    HashMap<K, Slot, Hash, KeyEqual> index;
+    size_t capacity;
+    size_t protected_capacity;
+    OnEvict on_evict;
+    CacheCounters counters;
+
+
+    void _evict() {
+        List& from = probation.is_empty() ? protect : probation;
+        Handle last = from.back_handle();
+        if(on_evict) on_evict(last->key, last->value);
+        index.remove(last->key);
+        from.erase(last);
+        counters.evictions++;
+    }
+
+    // Обращение к существующему элементу
+    void _touch(Slot& slot) {
+        if(slot.is_protected) {
+            protect.move_to_front(slot.handle);
+            return;
+        }
+        protect.splice_front(probation, slot.handle);
+        slot.is_protected = true;
+        if(protect.get_length() > protected_capacity) {
+            Handle last = protect.back_handle();
+            probation.splice_front(protect, last);
+            index.get(last->key)->is_protected = false;
+        }
+    }
+
+
+public:
+    SLRUCache(size_t capacity, OnEvict on_evict=nullptr, float protected_share=SLRUCACHE_PROTECTED_SHARE)
+        : index(capacity), capacity(capacity), on_evict(std::move(on_evict)) {
+        if(capacity == 0 || protected_share < 0 || protected_share > 1) throw ValueError();
+        protected_capacity = static_cast<size_t>(capacity * protected_share);
+    }
+    SLRUCache(const SLRUCache& right) : probation(right.probation), protect(right.protect), index(right.index), capacity(right.capacity),
+        protected_capacity(right.protected_capacity), on_evict(right.on_evict), counters(right.counters) {
+        for(Handle h = protect.front_handle(); h; h = protect.next(h)) index.get(h->key)->handle = h;
+        for(Handle h = probation.front_handle(); h; h = probation.next(h)) index.get(h->key)->handle = h;
+    }
+    SLRUCache(SLRUCache&&) = default;
+
+    SLRUCache& operator=(const SLRUCache& right) {
+        if(&right != this) *this = SLRUCache(right);
+        return *this;
+    }
+    SLRUCache& operator=(SLRUCache&&) = default;
+
+    void clear() {
+        probation.clear();
+        protect.clear();
+        index.clear();
+    }
+
+    size_t get_length() const { return probation.get_length() + protect.get_length(); }
+    size_t get_capacity() const { return capacity; }
+    size_t get_protected_length() const { return protect.get_length(); }
+    bool is_empty() const { return get_length() == 0; }
+    void set_on_evict(OnEvict on_evict) { this->on_evict = std::move(on_evict); }
+
+    const CacheCounters& get_counters() const { return counters; }
+    void reset_counters() { counters = CacheCounters(); }
+
+    V& put(const K& key, V value) {
+        if(Slot* slot = index.get(key)) {
+            _touch(*slot);
+            return slot->handle->value = std::move(value);
+        }
+        if(get_length() >= capacity) _evict();
+        probation.push_front(Entry{key, std::move(value)});
+        index.insert(key, Slot{probation.front_handle(), false});
+        return probation.front().value;
+    }
+
+    V* get(const K& key) {
+        Slot* slot = index.get(key);
+        if(!slot) {
+            counters.misses++;
+            return nullptr;
+        }
+        counters.hits++;
+        _touch(*slot);
+        return &slot->handle->value;
+    }
+    V& at(const K& key) {
+        V* ptr = get(key);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+    const V* peek(const K& key) const {
+        const Slot* slot = index.get(key);
+        return slot ? &slot->handle->value : nullptr;
+    }
+    bool contains(const K& key) const { return index.contains(key); }
+
+    void remove(const K& key) {
+        if(!try_remove(key)) throw KeyError();
+    }
+    bool try_remove(const K& key) {
+        Slot* slot = index.get(key);
+        if(!slot) return false;
+        Slot tmp = *slot;
+        index.remove(key);
+        (tmp.is_protected ? protect : probation).erase(tmp.handle);
+        return true;
+    }
+
+    // f(const Entry&): сначала защищенный сегмент, затем испытательный, в каждом от самого свежего
+    template <typename F>
+    void for_each(F f) const {
+        for(Handle h = protect.front_handle(); h; h = protect.next(h)) f(*h);
+        for(Handle h = probation.front_handle(); h; h = probation.next(h)) f(*h);
+    }
+};
+}
@@ -0,0 +1,574 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Exception.hpp"
+#include "Find.hpp"
+
+
+namespace siilib {
+
+// Числовые операции над непрерывными массивами арифметических типов: sum, min, max, argmin, argmax, dot,
+// axpy, поэлементные add, sub, mul, div (с числом или другим массивом той же длины) и prefix_sum.
+// float, double и целые размером 4 и 8 байт обрабатываются регистрами AVX2 (при сборке с -mavx2)
+// или SSE2, остальные типы и операции без подходящей инструкции - обычным циклом.
+// Суммы float и double считаются в нескольких независимых аккумуляторах, поэтому могут отличаться от
+// последовательного сложения в последних знаках; целые переполняются по модулю, как в регистре
+// (обычные циклы считают в беззнаковом типе, поэтому переполнение знаковых - не неопределенное поведение).
+// Результат min и max при наличии NaN не определен.
+
+// Тип, которым представлен T в регистре: float, double, int32_t, uint32_t, int64_t, uint64_t или void (нет SIMD)
+template <typename T>
+using _simd_lane = std::conditional_t<std::is_same_v<T, float> || std::is_same_v<T, double>, T,
+    std::conditional_t<std::is_integral_v<T> && sizeof(T) == 4, std::conditional_t<std::is_signed_v<T>, int32_t, uint32_t>,
+    std::conditional_t<std::is_integral_v<T> && sizeof(T) == 8, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>, void>>>;
+
+// Тип для скалярной арифметики над T: у целых - беззнаковый не уже unsigned (переполнение по модулю,
+// без знакового переполнения и без продвижения коротких беззнаковых в int)
+template <typename T, bool = std::is_integral_v<T>>
+struct _Wrap { using type = T; };
+template <typename T>
+struct _Wrap<T, true> { using type = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, std::make_unsigned_t<T>>; };
+
+template <typename T>
+T _wrap_add(T a, T b) { using U = typename _Wrap<T>::type; return static_cast<T>(static_cast<U>(a) + static_cast<U>(b)); }
+template <typename T>
+T _wrap_sub(T a, T b) { using U = typename _Wrap<T>::type; return static_cast<T>(static_cast<U>(a) - static_cast<U>(b)); }
+template <typename T>
+T _wrap_mul(T a, T b) { using U = typename _Wrap<T>::type; return static_cast<T>(static_cast<U>(a) * static_cast<U>(b)); }
+
+// Операции над регистром: load и store (без требований к выравниванию), set1,
+// add, sub, mul, div, min, max, scan (префиксная сумма внутри регистра) и last (последний элемент во все).
+// has_mul, has_div и has_minmax - есть ли соответствующие инструкции.
+template <typename Lane>
+struct _Simd {
+    static constexpr size_t width = 1;
+    static constexpr bool has_mul = false, has_div = false, has_minmax = false;
+};
+
+#if defined(__AVX2__)
+template <>
+struct _Simd<float> {
+    using reg = __m256;
+    static constexpr size_t width = 8;
+    static constexpr bool has_mul = true, has_div = true, has_minmax = true;
+    static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, reg x) { _mm256_storeu_ps(p, x); }
+    static reg set1(float x) { return _mm256_set1_ps(x); }
+    static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+    static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+#ifdef __FMA__
+    static reg mul_add(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+    static reg mul_add(reg a, reg b, reg c) { return add(mul(a, b), c); }
+#endif
+    static reg scan(reg x) {
+        // Сначала внутри каждой 128-битной половины, затем итог нижней половины прибавляется к верхней
+        x = add(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+        x = add(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+        __m256i low = _mm256_permute2x128_si256(_mm256_castps_si256(x), _mm256_castps_si256(x), 0x08);
+        return add(x, _mm256_castsi256_ps(_mm256_shuffle_epi32(low, _MM_SHUFFLE(3, 3, 3, 3))));
+    }
+    static reg last(reg x) { return _mm256_permutevar8x32_ps(x, _mm256_set1_epi32(7)); }
+};
+
+template <>
+struct _Simd<double> {
+    using reg = __m256d;
+    static constexpr size_t width = 4;
+    static constexpr bool has_mul = true, has_div = true, has_minmax = true;
+    static reg load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, reg x) { _mm256_storeu_pd(p, x); }
+    static reg set1(double x) { return _mm256_set1_pd(x); }
+    static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+    static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+    static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+#ifdef __FMA__
+    static reg mul_add(reg a, reg b, reg c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+    static reg mul_add(reg a, reg b, reg c) { return add(mul(a, b), c); }
+#endif
+    static reg scan(reg x) {
+        x = add(x, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(x), 8)));
+        __m256i low = _mm256_permute2x128_si256(_mm256_castpd_si256(x), _mm256_castpd_si256(x), 0x08);
+        return add(x, _mm256_castsi256_pd(_mm256_shuffle_epi32(low, _MM_SHUFFLE(3, 2, 3, 2))));
+    }
+    static reg last(reg x) { return _mm256_permute4x64_pd(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+template <>
+struct _Simd<int32_t> {
+    using reg = __m256i;
+    static constexpr size_t width = 8;
+    static constexpr bool has_mul = true, has_div = false, has_minmax = true;
+    static reg load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const reg*>(p)); }
+    static void store(int32_t* p, reg x) { _mm256_storeu_si256(reinterpret_cast<reg*>(p), x); }
+    static reg set1(int32_t x) { return _mm256_set1_epi32(x); }
+    static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_epi32(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mullo_epi32(a, b); }
+    static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+    static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+    static reg mul_add(reg a, reg b, reg c) { return add(mul(a, b), c); }
+    static reg scan(reg x) {
+        x = add(x, _mm256_slli_si256(x, 4));
+        x = add(x, _mm256_slli_si256(x, 8));
+        return add(x, _mm256_shuffle_epi32(_mm256_permute2x128_si256(x, x, 0x08), _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    static reg last(reg x) { return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7)); }
+};
+
+template <>
+struct _Simd<int64_t> {
+    using reg = __m256i;
+    static constexpr size_t width = 4;
+    // Умножения 64-битных целых в AVX2 нет
+    static constexpr bool has_mul = false, has_div = false, has_minmax = true;
+    static reg load(const int64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const reg*>(p)); }
+    static void store(int64_t* p, reg x) { _mm256_storeu_si256(reinterpret_cast<reg*>(p), x); }
+    static reg set1(int64_t x) { return _mm256_set1_epi64x(x); }
+    static reg add(reg a, reg b) { return _mm256_add_epi64(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_epi64(a, b); }
+    static reg min(reg a, reg b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+    static reg max(reg a, reg b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+    static reg scan(reg x) {
+        x = add(x, _mm256_slli_si256(x, 8));
+        return add(x, _mm256_shuffle_epi32(_mm256_permute2x128_si256(x, x, 0x08), _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+    static reg last(reg x) { return _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+#elif defined(__SSE2__)
+template <>
+struct _Simd<float> {
+    using reg = __m128;
+    static constexpr size_t width = 4;
+    static constexpr bool has_mul = true, has_div = true, has_minmax = true;
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, reg x) { _mm_storeu_ps(p, x); }
+    static reg set1(float x) { return _mm_set1_ps(x); }
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+    static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+    static reg mul_add(reg a, reg b, reg c) { return add(mul(a, b), c); }
+    static reg scan(reg x) {
+        x = add(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        return add(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+    }
+    static reg last(reg x) { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+template <>
+struct _Simd<double> {
+    using reg = __m128d;
+    static constexpr size_t width = 2;
+    static constexpr bool has_mul = true, has_div = true, has_minmax = true;
+    static reg load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, reg x) { _mm_storeu_pd(p, x); }
+    static reg set1(double x) { return _mm_set1_pd(x); }
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+    static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+    static reg mul_add(reg a, reg b, reg c) { return add(mul(a, b), c); }
+    static reg scan(reg x) { return add(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8))); }
+    static reg last(reg x) { return _mm_unpackhi_pd(x, x); }
+};
+
+template <>
+struct _Simd<int32_t> {
+    using reg = __m128i;
+    static constexpr size_t width = 4;
+    static constexpr bool has_mul = true, has_div = false, has_minmax = true;
+    static reg load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const reg*>(p)); }
+    static void store(int32_t* p, reg x) { _mm_storeu_si128(reinterpret_cast<reg*>(p), x); }
+    static reg set1(int32_t x) { return _mm_set1_epi32(x); }
+    static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_epi32(a, b); }
+    static reg mul(reg a, reg b) {
+        // В SSE2 есть только умножение четных элементов в 64-битные произведения: четные и нечетные отдельно
+        reg even = _mm_mul_epu32(a, b);
+        reg odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+    static reg min(reg a, reg b) {
+        reg greater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+    }
+    static reg max(reg a, reg b) {
+        reg greater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+    }
+    static reg mul_add(reg a, reg b, reg c) { return add(mul(a, b), c); }
+    static reg scan(reg x) {
+        x = add(x, _mm_slli_si128(x, 4));
+        return add(x, _mm_slli_si128(x, 8));
+    }
+    static reg last(reg x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+template <>
+struct _Simd<int64_t> {
+    using reg = __m128i;
+    static constexpr size_t width = 2;
+    // Сравнения и умножения 64-битных целых в SSE2 нет
+    static constexpr bool has_mul = false, has_div = false, has_minmax = false;
+    static reg load(const int64_t* p) { return _mm_loadu_si128(reinterpret_cast<const reg*>(p)); }
+    static void store(int64_t* p, reg x) { _mm_storeu_si128(reinterpret_cast<reg*>(p), x); }
+    static reg set1(int64_t x) { return _mm_set1_epi64x(x); }
+    static reg add(reg a, reg b) { return _mm_add_epi64(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_epi64(a, b); }
+    static reg scan(reg x) { return add(x, _mm_slli_si128(x, 8)); }
+    static reg last(reg x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2)); }
+};
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+// Беззнаковые целые: сложение, вычитание и младшие биты умножения от знака не зависят, сравнения - зависят
+template <>
+struct _Simd<uint32_t> : _Simd<int32_t> {
+    static constexpr bool has_minmax = false;
+    static reg load(const uint32_t* p) { return _Simd<int32_t>::load(reinterpret_cast<const int32_t*>(p)); }
+    static void store(uint32_t* p, reg x) { _Simd<int32_t>::store(reinterpret_cast<int32_t*>(p), x); }
+    static reg set1(uint32_t x) { return _Simd<int32_t>::set1(static_cast<int32_t>(x)); }
+};
+
+template <>
+struct _Simd<uint64_t> : _Simd<int64_t> {
+    static constexpr bool has_minmax = false;
+    static reg load(const uint64_t* p) { return _Simd<int64_t>::load(reinterpret_cast<const int64_t*>(p)); }
+    static void store(uint64_t* p, reg x) { _Simd<int64_t>::store(reinterpret_cast<int64_t*>(p), x); }
+    static reg set1(uint64_t x) { return _Simd<int64_t>::set1(static_cast<int64_t>(x)); }
+};
+#endif
+
+
+// Операции для поэлементных циклов и сверток: simd над регистрами, scalar над элементами
+struct _NumAdd {
+    template <typename S> static constexpr bool enabled = true;
+    template <typename S, typename R> static R simd(R a, R b) { return S::add(a, b); }
+    template <typename T> static T scalar(T a, T b) { return _wrap_add(a, b); }
+};
+struct _NumSub {
+    template <typename S> static constexpr bool enabled = true;
+    template <typename S, typename R> static R simd(R a, R b) { return S::sub(a, b); }
+    template <typename T> static T scalar(T a, T b) { return _wrap_sub(a, b); }
+};
+struct _NumMul {
+    template <typename S> static constexpr bool enabled = S::has_mul;
+    template <typename S, typename R> static R simd(R a, R b) { return S::mul(a, b); }
+    template <typename T> static T scalar(T a, T b) { return _wrap_mul(a, b); }
+};
+struct _NumDiv {
+    template <typename S> static constexpr bool enabled = S::has_div;
+    template <typename S, typename R> static R simd(R a, R b) { return S::div(a, b); }
+    template <typename T> static T scalar(T a, T b) { return a / b; }
+};
+struct _NumMin {
+    template <typename S> static constexpr bool enabled = S::has_minmax;
+    template <typename S, typename R> static R simd(R a, R b) { return S::min(a, b); }
+    template <typename T> static T scalar(T a, T b) { return b < a ? b : a; }
+};
+struct _NumMax {
+    template <typename S> static constexpr bool enabled = S::has_minmax;
+    template <typename S, typename R> static R simd(R a, R b) { return S::max(a, b); }
+    template <typename T> static T scalar(T a, T b) { return a < b ? b : a; }
+};
+
+template <typename T>
+constexpr bool _numeric = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+// Сколько первых элементов обработать поодиночке, чтобы записи с ptr + peel не пересекали границу кэш-линии
+template <typename S, typename T>
+size_t _simd_peel(const T* ptr, size_t n) {
+    constexpr size_t bytes = sizeof(typename S::reg);
+    size_t misalign = reinterpret_cast<uintptr_t>(ptr) % bytes;
+    if(misalign == 0 || misalign % sizeof(T)) return 0;
+    size_t peel = (bytes - misalign) / sizeof(T);
+    return peel < n ? peel : n;
+}
+
+
+// Свертка op по n элементам, начиная с init (для сложения - ноль: init попадает в каждый разряд аккумуляторов).
+// Четыре независимых регистра-аккумулятора скрывают задержку операции.
+template <typename Op, typename T>
+T _simd_reduce(const T* data, size_t n, T init) {
+    size_t i = 0;
+    T res = init;
+    using Lane = _simd_lane<T>;
+    if constexpr(!std::is_void_v<Lane>) {
+        using S = _Simd<Lane>;
+        if constexpr(S::width > 1 && Op::template enabled<S>) {
+            constexpr size_t w = S::width;
+            const Lane* p = reinterpret_cast<const Lane*>(data);
+            if(n >= w) {
+                auto acc0 = S::set1(static_cast<Lane>(init)), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+                for(; i + 4 * w <= n; i += 4 * w) {
+                    acc0 = Op::template simd<S>(acc0, S::load(p + i));
+                    acc1 = Op::template simd<S>(acc1, S::load(p + i + w));
+                    acc2 = Op::template simd<S>(acc2, S::load(p + i + 2 * w));
+                    acc3 = Op::template simd<S>(acc3, S::load(p + i + 3 * w));
+                }
+                for(; i + w <= n; i += w) acc0 = Op::template simd<S>(acc0, S::load(p + i));
+                acc0 = Op::template simd<S>(Op::template simd<S>(acc0, acc1), Op::template simd<S>(acc2, acc3));
+                Lane lanes[w];
+                S::store(lanes, acc0);
+                for(size_t j = 0; j < w; ++j) res = Op::scalar(res, static_cast<T>(lanes[j]));
+            }
+        }
+    }
+    for(; i < n; ++i) res = Op::scalar(res, data[i]);
+    return res;
+}
+
+// dst[i] = op(dst[i], src[i]); записи в dst выровнены на регистр, чтение src - как получится
+template <typename Op, typename T>
+void _simd_apply(T* dst, const T* src, size_t n) {
+    size_t i = 0;
+    using Lane = _simd_lane<T>;
+    if constexpr(!std::is_void_v<Lane>) {
+        using S = _Simd<Lane>;
+        if constexpr(S::width > 1 && Op::template enabled<S>) {
+            for(size_t peel = _simd_peel<S>(dst, n); i < peel; ++i) dst[i] = Op::scalar(dst[i], src[i]);
+            Lane* d = reinterpret_cast<Lane*>(dst);
+            const Lane* s = reinterpret_cast<const Lane*>(src);
+            for(; i + S::width <= n; i += S::width) S::store(d + i, Op::template simd<S>(S::load(d + i), S::load(s + i)));
+        }
+    }
+    for(; i < n; ++i) dst[i] = Op::scalar(dst[i], src[i]);
+}
+
+// dst[i] = op(dst[i], x)
+template <typename Op, typename T>
+void _simd_apply_scalar(T* dst, size_t n, T x) {
+    size_t i = 0;
+    using Lane = _simd_lane<T>;
+    if constexpr(!std::is_void_v<Lane>) {
+        using S = _Simd<Lane>;
+        if constexpr(S::width > 1 && Op::template enabled<S>) {
+            for(size_t peel = _simd_peel<S>(dst, n); i < peel; ++i) dst[i] = Op::scalar(dst[i], x);
+            Lane* d = reinterpret_cast<Lane*>(dst);
+            auto splat = S::set1(static_cast<Lane>(x));
+            for(; i + S::width <= n; i += S::width) S::store(d + i, Op::template simd<S>(S::load(d + i), splat));
+        }
+    }
+    for(; i < n; ++i) dst[i] = Op::scalar(dst[i], x);
+}
+
+
+template <typename T>
+T sum(const T* begin, const T* end) {
+    static_assert(_numeric<T>, "sum needs an arithmetic element type");
+    return _simd_reduce<_NumAdd>(begin, end - begin, T());
+}
+
+template <typename T>
+T min(const T* begin, const T* end) {
+    static_assert(_numeric<T>, "min needs an arithmetic element type");
+    if(begin == end) throw EmptyError();
+    return _simd_reduce<_NumMin>(begin + 1, end - begin - 1, *begin);
+}
+
+template <typename T>
+T max(const T* begin, const T* end) {
+    static_assert(_numeric<T>, "max needs an arithmetic element type");
+    if(begin == end) throw EmptyError();
+    return _simd_reduce<_NumMax>(begin + 1, end - begin - 1, *begin);
+}
+
+// Указатель на первый наименьший (наибольший) элемент: векторный поиск значения, затем его первого вхождения
+template <typename T>
+const T* argmin(const T* begin, const T* end) { return _find(begin, end, siilib::min(begin, end)); }
+
+template <typename T>
+const T* argmax(const T* begin, const T* end) { return _find(begin, end, siilib::max(begin, end)); }
+
+// Скалярное произведение [begin, end) и массива той же длины other
+template <typename T>
+T dot(const T* begin, const T* end, const T* other) {
+    static_assert(_numeric<T>, "dot needs an arithmetic element type");
+    size_t n = end - begin, i = 0;
+    T res = T();
+    using Lane = _simd_lane<T>;
+    if constexpr(!std::is_void_v<Lane>) {
+        using S = _Simd<Lane>;
+        if constexpr(S::width > 1 && S::has_mul) {
+            constexpr size_t w = S::width;
+            const Lane* a = reinterpret_cast<const Lane*>(begin);
+            const Lane* b = reinterpret_cast<const Lane*>(other);
+            auto acc0 = S::set1(0), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+            for(; i + 4 * w <= n; i += 4 * w) {
+                acc0 = S::mul_add(S::load(a + i), S::load(b + i), acc0);
+                acc1 = S::mul_add(S::load(a + i + w), S::load(b + i + w), acc1);
+                acc2 = S::mul_add(S::load(a + i + 2 * w), S::load(b + i + 2 * w), acc2);
+                acc3 = S::mul_add(S::load(a + i + 3 * w), S::load(b + i + 3 * w), acc3);
+            }
+            for(; i + w <= n; i += w) acc0 = S::mul_add(S::load(a + i), S::load(b + i), acc0);
+            acc0 = S::add(S::add(acc0, acc1), S::add(acc2, acc3));
+            Lane lanes[w];
+            S::store(lanes, acc0);
+            for(size_t j = 0; j < w; ++j) res = _wrap_add(res, static_cast<T>(lanes[j]));
+        }
+    }
+    for(; i < n; ++i) res = _wrap_add(res, _wrap_mul(begin[i], other[i]));
+    return res;
+}
+
+// y[i] += a * x[i] для [begin, end) массива y и массива x той же длины
+template <typename T>
+void axpy(T a, const T* x, T* begin, T* end) {
+    static_assert(_numeric<T>, "axpy needs an arithmetic element type");
+    size_t n = end - begin, i = 0;
+    using Lane = _simd_lane<T>;
+    if constexpr(!std::is_void_v<Lane>) {
+        using S = _Simd<Lane>;
+        if constexpr(S::width > 1 && S::has_mul) {
+            for(size_t peel = _simd_peel<S>(begin, n); i < peel; ++i) begin[i] = _wrap_add(begin[i], _wrap_mul(a, x[i]));
+            Lane* y = reinterpret_cast<Lane*>(begin);
+            const Lane* p = reinterpret_cast<const Lane*>(x);
+            auto splat = S::set1(static_cast<Lane>(a));
+            for(; i + S::width <= n; i += S::width) S::store(y + i, S::mul_add(splat, S::load(p + i), S::load(y + i)));
+        }
+    }
+    for(; i < n; ++i) begin[i] = _wrap_add(begin[i], _wrap_mul(a, x[i]));
+}
+
+// Поэлементные операции на месте: с числом x или с массивом other той же длины
+template <typename T>
+void add(T* begin, T* end, const T* other) { static_assert(_numeric<T>); _simd_apply<_NumAdd>(begin, other, end - begin); }
+template <typename T>
+void add(T* begin, T* end, T x) { static_assert(_numeric<T>); _simd_apply_scalar<_NumAdd>(begin, end - begin, x); }
+template <typename T>
+void sub(T* begin, T* end, const T* other) { static_assert(_numeric<T>); _simd_apply<_NumSub>(begin, other, end - begin); }
+template <typename T>
+void sub(T* begin, T* end, T x) { static_assert(_numeric<T>); _simd_apply_scalar<_NumSub>(begin, end - begin, x); }
+template <typename T>
+void mul(T* begin, T* end, const T* other) { static_assert(_numeric<T>); _simd_apply<_NumMul>(begin, other, end - begin); }
+template <typename T>
+void mul(T* begin, T* end, T x) { static_assert(_numeric<T>); _simd_apply_scalar<_NumMul>(begin, end - begin, x); }
+template <typename T>
+void div(T* begin, T* end, const T* other) { static_assert(_numeric<T>); _simd_apply<_NumDiv>(begin, other, end - begin); }
+template <typename T>
+void div(T* begin, T* end, T x) { static_assert(_numeric<T>); _simd_apply_scalar<_NumDiv>(begin, end - begin, x); }
+
+// Префиксные суммы на месте: begin[i] = begin[0] + ... + begin[i]
+template <typename T>
+void prefix_sum(T* begin, T* end) {
+    static_assert(_numeric<T>, "prefix_sum needs an arithmetic element type");
+    size_t n = end - begin, i = 0;
+    using Lane = _simd_lane<T>;
+    if constexpr(!std::is_void_v<Lane>) {
+        using S = _Simd<Lane>;
+        if constexpr(S::width > 1) {
+            for(size_t peel = _simd_peel<S>(begin, n); i < peel; ++i) {
+                if(i) begin[i] = _wrap_add(begin[i], begin[i - 1]);
+            }
+            Lane* p = reinterpret_cast<Lane*>(begin);
+            // Перенос - сумма всех предыдущих элементов в каждом разряде регистра
+            auto carry = S::set1(i ? p[i - 1] : Lane());
+            for(; i + S::width <= n; i += S::width) {
+                auto x = S::add(S::scan(S::load(p + i)), carry);
+                S::store(p + i, x);
+                carry = S::last(x);
+            }
+        }
+    }
+    for(; i < n; ++i) {
+        if(i) begin[i] = _wrap_add(begin[i], begin[i - 1]);
+    }
+}
+
+
+// Перегрузки для контейнеров с непрерывным хранением (Vector, Array и т.п.)
+template <typename Container>
+using _NumericContainer = std::enable_if_t<std::is_pointer_v<decltype(std::declval<Container&>().begin())>>;
+template <typename Container>
+using _NumericElement = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Container&>().begin())>>;
+
+template <typename A, typename B>
+void _same_length(const A& a, const B& b) {
+    if(a.get_length() != b.get_length()) throw ValueError();
+}
+
+template <typename Container, typename = _NumericContainer<Container>>
+auto sum(const Container& c) { return siilib::sum(c.begin(), c.end()); }
+template <typename Container, typename = _NumericContainer<Container>>
+auto min(const Container& c) { return siilib::min(c.begin(), c.end()); }
+template <typename Container, typename = _NumericContainer<Container>>
+auto max(const Container& c) { return siilib::max(c.begin(), c.end()); }
+
+// Индекс первого наименьшего (наибольшего) элемента; пустой контейнер - EmptyError
+template <typename Container, typename = _NumericContainer<Container>>
+int argmin(const Container& c) { return static_cast<int>(siilib::argmin(c.begin(), c.end()) - c.begin()); }
+template <typename Container, typename = _NumericContainer<Container>>
+int argmax(const Container& c) { return static_cast<int>(siilib::argmax(c.begin(), c.end()) - c.begin()); }
+
+// Разная длина контейнеров - ValueError
+template <typename A, typename B, typename = _NumericContainer<A>, typename = _NumericContainer<B>>
+auto dot(const A& a, const B& b) {
+    _same_length(a, b);
+    return siilib::dot(a.begin(), a.end(), b.begin());
+}
+
+template <typename A, typename B, typename = _NumericContainer<A>, typename = _NumericContainer<B>>
+void axpy(_NumericElement<B> a, const A& x, B& y) {
+    _same_length(x, y);
+    siilib::axpy(a, x.begin(), y.begin(), y.end());
+}
+
+// Поэлементно с контейнером той же длины (иначе ValueError) или с числом
+template <typename A, typename B, typename = _NumericContainer<A>, typename = _NumericContainer<B>>
+void add(A& a, const B& b) {
+    _same_length(a, b);
+    siilib::add(a.begin(), a.end(), static_cast<const _NumericElement<A>*>(b.begin()));
+}
+template <typename Container, typename = _NumericContainer<Container>>
+void add(Container& c, _NumericElement<Container> x) { siilib::add(c.begin(), c.end(), x); }
+
+template <typename A, typename B, typename = _NumericContainer<A>, typename = _NumericContainer<B>>
+void sub(A& a, const B& b) {
+    _same_length(a, b);
+    siilib::sub(a.begin(), a.end(), static_cast<const _NumericElement<A>*>(b.begin()));
+}
+template <typename Container, typename = _NumericContainer<Container>>
+void sub(Container& c, _NumericElement<Container> x) { siilib::sub(c.begin(), c.end(), x); }
+
+template <typename A, typename B, typename = _NumericContainer<A>, typename = _NumericContainer<B>>
+void mul(A& a, const B& b) {
+    _same_length(a, b);
+    siilib::mul(a.begin(), a.end(), static_cast<const _NumericElement<A>*>(b.begin()));
+}
+template <typename Container, typename = _NumericContainer<Container>>
+void mul(Container& c, _NumericElement<Container> x) { siilib::mul(c.begin(), c.end(), x); }
+
+template <typename A, typename B, typename = _NumericContainer<A>, typename = _NumericContainer<B>>
+void div(A& a, const B& b) {
+    _same_length(a, b);
+    siilib::div(a.begin(), a.end(), static_cast<const _NumericElement<A>*>(b.begin()));
+}
+template <typename Container, typename = _NumericContainer<Container>>
+void div(Container& c, _NumericElement<Container> x) { siilib::div(c.begin(), c.end(), x); }
+
+template <typename Container, typename = _NumericContainer<Container>>
+void prefix_sum(Container& c) { siilib::prefix_sum(c.begin(), c.end()); }
+}
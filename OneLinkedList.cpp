@@ -1,11 +1,18 @@
+#pragma once
+
 #include <memory>
+#include <optional>
 
+#include "Check.hpp"
 #include "Exception.hpp"
+#include "Serialize.hpp"
+#include "Stats.hpp"
 
 
 namespace siilib {
-template <typename T>
-class OneLinkedList { 
+// CheckPolicy - проверки индексов и пустоты (Check.hpp)
+template <typename T, typename CheckPolicy = Checked>
+class OneLinkedList : public _Stats {
 
     struct Object {
         T data;
@@ -19,18 +26,28 @@ class OneLinkedList {
     Object* tail{nullptr};
     size_t length{0};
 
-    Object* _at(int index) const {
-        if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+    // Узел по индексу из [0, length), без проверок
+    Object* _walk(int index) const {
         Object* ptr = head;
         for(int i = 0; i < index; ++i) ptr = ptr->next;
         return ptr;
     }
+    Object* _node(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return _walk(index);
+    }
+    Object* _at(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        return _walk(index);
+    }
 
     template <typename U>
     T& _push_back(U&& x) {
         try {
             Object* ptr = new Object(std::forward<U>(x));
+            this->_stat_alloc(sizeof(Object));
             if(!tail) {
                 head = tail = ptr;
             }
@@ -48,6 +65,7 @@ class OneLinkedList {
     T& _push_front(U&& x) {
         try {
             Object* ptr = new Object(std::forward<U>(x));
+            this->_stat_alloc(sizeof(Object));
             if(!head) {
                 head = tail = ptr;
             }
@@ -63,11 +81,15 @@ class OneLinkedList {
 
     template <typename U>
     T& _insert(int index, U&& x) {
+        // Как у Vector: проверка до выделения узла, чтобы исключение не теряло его
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index <= static_cast<int>(length));
         if(index == 0) return _push_front(std::forward<U>(x));
         if(index == length) return _push_back(std::forward<U>(x));
         try {
             Object* ptr = new Object(std::forward<U>(x));
-            Object* left = _at(index - 1);
+            this->_stat_alloc(sizeof(Object));
+            Object* left = _walk(index - 1);
             Object* right = left->next;
             left->next = ptr;
             ptr->next = right;
@@ -77,16 +99,53 @@ class OneLinkedList {
         catch(std::bad_alloc&) { throw AllocError(); }
     }
 
+    T _pop_back() {
+        T res = std::move(tail->data);
+        if(head == tail) {
+            this->_stat_free(sizeof(Object));
+            delete tail;
+            head = tail = nullptr;
+        }
+        else {
+            Object* ptr = _walk(length-2);
+            ptr->next = nullptr;
+            this->_stat_free(sizeof(Object));
+            delete tail;
+            tail = ptr;
+        }
+        length--;
+        return res;
+    }
+    T _pop_front() {
+        T res = std::move(head->data);
+        if(head == tail) {
+            this->_stat_free(sizeof(Object));
+            delete head;
+            head = tail = nullptr;
+        }
+        else {
+            Object* ptr = head->next;
+            this->_stat_free(sizeof(Object));
+            delete head;
+            head = ptr;
+        }
+        length--;
+        return res;
+    }
+
 
 public:
+    static constexpr int npos = -1;
+
     OneLinkedList() { }
     OneLinkedList(const T* ar, size_t len) {
         for(size_t i = 0; i < len; ++i) this->push_back(ar[i]);
     }
-    OneLinkedList(const OneLinkedList<T>& right) {
+    OneLinkedList(const OneLinkedList& right) : _Stats() {
         for(Object* ptr = right.head; ptr != nullptr; ptr = ptr->next) this->push_back(ptr->data);
+        this->_stat_copied(right.length);
     }
-    OneLinkedList(OneLinkedList<T>&& right) noexcept {
+    OneLinkedList(OneLinkedList&& right) noexcept {
         this->head = right.head;
         this->tail = right.tail;
         this->length = right.length;
@@ -107,6 +166,7 @@ public:
         while(head) {
             ptr = head;
             head = head->next;
+            this->_stat_free(sizeof(Object));
             delete ptr;
         }
         head = tail = nullptr;
@@ -132,35 +192,20 @@ public:
         return _push_front(std::move(x));
     }
     T pop_back() {
-        if(!tail) throw EmptyError();
-        T res = std::move(tail->data);
-        if(head == tail) {
-            delete tail;
-            head = tail = nullptr;
-        }
-        else {
-            Object* ptr = _at(length-2);
-            ptr->next = nullptr;
-            delete tail;
-            tail = ptr;
-        }
-        length--;
-        return res;
+        _require<CheckPolicy, EmptyError>(tail != nullptr);
+        return _pop_back();
     }
     T pop_front() {
-        if(!head) throw EmptyError();
-        T res = std::move(head->data);
-        if(head == tail) {
-            delete head;
-            head = tail = nullptr;
-        }
-        else {
-            Object* ptr = head->next;
-            delete head;
-            head = ptr;
-        }
-        length--;
-        return res;
+        _require<CheckPolicy, EmptyError>(head != nullptr);
+        return _pop_front();
+    }
+    std::optional<T> try_pop_back() {
+        if(!tail) return std::nullopt;
+        return _pop_back();
+    }
+    std::optional<T> try_pop_front() {
+        if(!head) return std::nullopt;
+        return _pop_front();
     }
 
     T& insert(int index, const T& x) {
@@ -170,12 +215,15 @@ public:
         return _insert(index, std::move(x));
     }
     T erase(int index) {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         if(index == 0) return pop_front();
         if(index == length-1) return pop_back();
-        Object* ptr = _at(index-1);
+        Object* ptr = _walk(index-1);
         Object* tmp = ptr->next;
         T res = std::move(tmp->data);
         ptr->next = ptr->next->next;
+        this->_stat_free(sizeof(Object));
         delete tmp;
         length--;
         return res;
@@ -188,6 +236,7 @@ public:
                 if(prev) prev->next = ptr->next;
                 else head = ptr->next;
                 if(ptr == tail) tail = prev;
+                this->_stat_free(sizeof(Object));
                 delete ptr;
                 length--;
                 return;
@@ -198,21 +247,27 @@ public:
         throw KeyError();
     }
 
-    int find(const T& key) {
+    int find(const T& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const T& key) const {
         Object* ptr = head;
         for(size_t i = 0; ptr != nullptr; ++i, ptr = ptr->next) {
             if(ptr->data == key) {
                 return i;
             }
         }
-        throw KeyError();
+        return npos;
     }
 
-    OneLinkedList<T>& extend(const OneLinkedList<T>& right) {
+    OneLinkedList& extend(const OneLinkedList& right) {
         for(Object* ptr = right.head; ptr != nullptr; ptr = ptr->next) this->push_back(ptr->data);
+        this->_stat_copied(right.length);
         return *this;
     }
-    OneLinkedList<T>& extend(OneLinkedList<T>&& right) {
+    OneLinkedList& extend(OneLinkedList&& right) {
         if(&right == this) return *this;
         if (!right.head) return *this;
         if (!head) {
@@ -234,19 +289,41 @@ public:
     const T& operator[](int index) const {
         return _at(index)->data;
     }
+    T* get(int index) {
+        Object* ptr = _node(index);
+        return ptr ? &ptr->data : nullptr;
+    }
+    const T* get(int index) const {
+        Object* ptr = _node(index);
+        return ptr ? &ptr->data : nullptr;
+    }
 
-    T& front() {if(!head) throw EmptyError(); return head->data; }
-    const T& front() const { if(!head) throw EmptyError();return head->data; }
-    T& back() { if(!tail) throw EmptyError();return tail->data; }
-    const T& back() const { if(!tail) throw EmptyError();return tail->data; }
+    T& front() { _require<CheckPolicy, EmptyError>(head != nullptr); return head->data; }
+    const T& front() const { _require<CheckPolicy, EmptyError>(head != nullptr); return head->data; }
+    T& back() { _require<CheckPolicy, EmptyError>(tail != nullptr); return tail->data; }
+    const T& back() const { _require<CheckPolicy, EmptyError>(tail != nullptr); return tail->data; }
+
+    // Двоичное сохранение (Serialize.hpp): элементы узлов собираются в пакеты для writev без промежуточного копирования
+    void save(Writer out) const {
+        out.write_header<T>(length);
+        for(Object* ptr = head; ptr != nullptr; ptr = ptr->next) out.write_element(ptr->data);
+        out.flush();
+    }
+    static OneLinkedList load(Reader in) {
+        size_t len = in.read_header<T>();
+        OneLinkedList res;
+        in.read_each<T>(len, [&](T&& x) { res.push_back(std::move(x)); });
+        return res;
+    }
 
-    OneLinkedList<T>& operator=(const OneLinkedList<T>& right) {
+    OneLinkedList& operator=(const OneLinkedList& right) {
         if(&right == this) return *this;
         this->clear();
         for(Object* ptr = right.head; ptr != nullptr; ptr = ptr->next) this->push_back(ptr->data);
+        this->_stat_copied(right.length);
         return *this;
     }
-    OneLinkedList<T>& operator=(OneLinkedList<T>&& right) noexcept {
+    OneLinkedList& operator=(OneLinkedList&& right) noexcept {
         if(&right == this) return *this;
         this->clear();
         this->length = right.length;
@@ -256,7 +333,7 @@ public:
         right.length = 0;
         return *this;
     }
-    OneLinkedList<T>& operator=(std::initializer_list<T> ar) {
+    OneLinkedList& operator=(std::initializer_list<T> ar) {
         this->clear();
         for(const T& x : ar) this->push_back(x);
         return *this;
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#include "Exception.hpp"
+
+
+#define PACKEDINTVECTOR_MIN_CAPACITY 8
+
+
+namespace siilib {
+// Поле шириной bits (1..64) с бита first_bit массива слов; поле может пересекать границу слов
+inline uint64_t _bits_mask(unsigned bits) { return bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1; }
+
+inline uint64_t _bits_get(const uint64_t* words, size_t first_bit, unsigned bits) {
+    size_t w = first_bit / 64;
+    unsigned off = first_bit % 64;
+    uint64_t res = words[w] >> off;
+    if(off + bits > 64) res |= words[w + 1] << (64 - off);
+    return res & _bits_mask(bits);
+}
+
+// Записывает value (не шире bits) в поле, стирая прежнее значение
+inline void _bits_set(uint64_t* words, size_t first_bit, unsigned bits, uint64_t value) {
+    size_t w = first_bit / 64;
+    unsigned off = first_bit % 64;
+    uint64_t mask = _bits_mask(bits);
+    words[w] = (words[w] & ~(mask << off)) | (value << off);
+    if(off + bits > 64) words[w + 1] = (words[w + 1] & ~(mask >> (64 - off))) | (value >> (64 - off));
+}
+
+// Последовательное чтение count полей подряд: позиция в словах сдвигается без умножения и деления на каждое поле.
+// Поля, начинающиеся до последнего слова данных, читают и следующее слово без проверки, поэтому цикл не ветвится
+// по тому, пересекает ли поле границу слов; поля в последнем слове его не пересекают. bits == 0 - все значения нулевые.
+inline void _bits_unpack(const uint64_t* words, size_t first_bit, unsigned bits, size_t count, uint64_t* out) {
+    if(count == 0) return;
+    if(bits == 0) {
+        for(size_t i = 0; i < count; ++i) out[i] = 0;
+        return;
+    }
+    uint64_t mask = _bits_mask(bits);
+    const uint64_t* w = words + first_bit / 64;
+    const uint64_t* last = words + (first_bit + count * bits - 1) / 64;
+    unsigned off = first_bit % 64;
+    size_t i = 0;
+    for(; i < count && w < last; ++i) {
+        // Двойной сдвиг вместо << (64 - off): при off == 0 сдвиг на 64 не определен
+        out[i] = ((*w >> off) | ((w[1] << 1) << (63 - off))) & mask;
+        off += bits;
+        w += off / 64;
+        off %= 64;
+    }
+    for(; i < count; ++i, off += bits) out[i] = (*w >> off) & mask;
+}
+
+// Наименьшая ширина поля, в которую помещается value (для нуля - 1)
+inline unsigned bits_for(uint64_t value) { return value ? 64 - __builtin_clzll(value) : 1; }
+
+
+// Динамический массив беззнаковых целых фиксированной ширины bits (1..64), упакованных подряд без выравнивания:
+// миллион 20-битных чисел занимает 2.5 МБ вместо 8 МБ в Vector<uint64_t>. Доступ по индексу - O(1)
+// (сдвиг одного или двух слов). Значение шире bits - ValueError. Индексы - size_t, как у BitVector.
+class PackedIntVector {
+    uint64_t* words{nullptr};
+    size_t length{0};
+    size_t capacity{0};
+    unsigned bits{64};
+
+
+    static size_t _words_for(size_t len, unsigned bits) { return (len * bits + 63) / 64; }
+
+    void _reserve(size_t len) {
+        size_t need = _words_for(len, bits);
+        if(need <= capacity) return;
+        size_t tmp_capacity = capacity ? capacity : PACKEDINTVECTOR_MIN_CAPACITY;
+        while(tmp_capacity < need) tmp_capacity *= 2;
+        uint64_t* ptr;
+        try { ptr = new uint64_t[tmp_capacity]; }
+        catch(const std::bad_alloc&) { throw ResizeError(); }
+        if(capacity) std::memcpy(ptr, words, capacity * sizeof(uint64_t));
+        std::memset(ptr + capacity, 0, (tmp_capacity - capacity) * sizeof(uint64_t));
+        delete[] words;
+        words = ptr;
+        capacity = tmp_capacity;
+    }
+
+    void _check(size_t index) const {
+        if(index >= length) throw IndexError();
+    }
+    void _check_value(uint64_t value) const {
+        if(value & ~_bits_mask(bits)) throw ValueError();
+    }
+
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    PackedIntVector(unsigned bits=64) : bits(bits) {
+        if(bits == 0 || bits > 64) throw ValueError();
+    }
+    PackedIntVector(unsigned bits, size_t len, uint64_t value=0) : PackedIntVector(bits) {
+        resize(len, value);
+    }
+    // Ширина - наименьшая, в которую помещаются все значения
+    PackedIntVector(std::initializer_list<uint64_t> ar) {
+        uint64_t max_value = 0;
+        for(uint64_t x : ar) max_value |= x;
+        bits = bits_for(max_value);
+        _reserve(ar.size());
+        for(uint64_t x : ar) push_back(x);
+    }
+    PackedIntVector(const PackedIntVector& right) {
+        *this = right;
+    }
+    PackedIntVector(PackedIntVector&& right) noexcept {
+        *this = std::move(right);
+    }
+    ~PackedIntVector() {
+        delete[] words;
+    }
+
+    PackedIntVector& operator=(const PackedIntVector& right) {
+        if(this == &right) return *this;
+        uint64_t* ptr;
+        try { ptr = new uint64_t[right.capacity ? right.capacity : 1]; }
+        catch(const std::bad_alloc&) { throw AllocError(); }
+        if(right.capacity) std::memcpy(ptr, right.words, right.capacity * sizeof(uint64_t));
+        delete[] words;
+        words = ptr;
+        length = right.length;
+        capacity = right.capacity;
+        bits = right.bits;
+        return *this;
+    }
+    PackedIntVector& operator=(PackedIntVector&& right) noexcept {
+        if(this == &right) return *this;
+        delete[] words;
+        words = right.words;
+        length = right.length;
+        capacity = right.capacity;
+        bits = right.bits;
+        right.words = nullptr;
+        right.length = right.capacity = 0;
+        return *this;
+    }
+
+    void clear() {
+        if(capacity) std::memset(words, 0, capacity * sizeof(uint64_t));
+        length = 0;
+    }
+
+    // Новые элементы получают значение value
+    void resize(size_t len, uint64_t value=0) {
+        _check_value(value);
+        if(len > length) {
+            _reserve(len);
+            if(value) for(size_t i = length; i < len; ++i) _bits_set(words, i * bits, bits, value);
+            length = len;
+        }
+        else {
+            // Биты за длиной всегда нулевые: push_back только дописывает единицы
+            for(size_t i = len; i < length; ++i) _bits_set(words, i * bits, bits, 0);
+            length = len;
+        }
+    }
+
+    size_t get_length() const { return length; }
+    size_t get_capacity() const { return capacity * 64 / bits; }
+    // Занимаемая память в байтах
+    size_t get_size() const { return capacity * sizeof(uint64_t); }
+    unsigned get_bits() const { return bits; }
+    uint64_t get_max_value() const { return _bits_mask(bits); }
+    bool is_empty() const { return length == 0; }
+
+    void push_back(uint64_t x) {
+        _check_value(x);
+        _reserve(length + 1);
+        size_t pos = length * bits;
+        words[pos / 64] |= x << (pos % 64);
+        if(pos % 64 + bits > 64) words[pos / 64 + 1] |= x >> (64 - pos % 64);
+        length++;
+    }
+    uint64_t pop_back() {
+        if(length == 0) throw EmptyError();
+        return *try_pop_back();
+    }
+    std::optional<uint64_t> try_pop_back() {
+        if(length == 0) return std::nullopt;
+        length--;
+        uint64_t x = _bits_get(words, length * bits, bits);
+        _bits_set(words, length * bits, bits, 0);
+        return x;
+    }
+
+    uint64_t operator[](size_t index) const {
+        _check(index);
+        return _bits_get(words, index * bits, bits);
+    }
+    void set(size_t index, uint64_t value) {
+        _check(index);
+        _check_value(value);
+        _bits_set(words, index * bits, bits, value);
+    }
+    uint64_t front() const { if(length == 0) throw EmptyError(); return _bits_get(words, 0, bits); }
+    uint64_t back() const { if(length == 0) throw EmptyError(); return _bits_get(words, (length - 1) * bits, bits); }
+
+    // Распаковывает count элементов начиная с from в out - быстрее, чем count обращений по индексу
+    void unpack(size_t from, size_t count, uint64_t* out) const {
+        if(from > length || count > length - from) throw IndexError();
+        _bits_unpack(words, from * bits, bits, count, out);
+    }
+
+    // Индекс первого элемента, равного value; такого нет - KeyError (try_find возвращает npos)
+    size_t find(uint64_t value) const {
+        size_t index = try_find(value);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    size_t try_find(uint64_t value) const {
+        uint64_t buf[64];
+        for(size_t from = 0; from < length; from += 64) {
+            size_t count = length - from < 64 ? length - from : 64;
+            _bits_unpack(words, from * bits, bits, count, buf);
+            for(size_t i = 0; i < count; ++i) if(buf[i] == value) return from + i;
+        }
+        return npos;
+    }
+
+    // Непосредственный доступ к словам, например для сохранения на диск
+    const uint64_t* get_words() const { return words; }
+    size_t get_word_count() const { return _words_for(length, bits); }
+};
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "Exception.hpp"
+#include "Sort.cpp"
+#include "ThreadPool.cpp"
+
+
+#define PARALLEL_DEFAULT_GRAIN 16384
+
+
+namespace siilib {
+
+template <typename Container>
+using _ContainerOnly = decltype(std::declval<const Container&>().get_length());
+
+// Делит [0, len) на не более чем 4 * threads частей не короче grain и вызывает f(begin, end, part)
+// на потоках пула. Если частей меньше двух, f вызывается один раз в текущем потоке.
+template <typename F>
+size_t _parallel_parts(size_t len, size_t grain, ThreadPool& pool, F f) {
+    if(grain == 0) grain = 1;
+    size_t parts = (len + grain - 1) / grain;
+    if(parts > pool.get_threads() * 4) parts = pool.get_threads() * 4;
+    if(parts <= 1 || pool.get_threads() == 1) {
+        f(size_t(0), len, size_t(0));
+        return 1;
+    }
+    pool.run(parts, [&](size_t part) { f(len * part / parts, len * (part + 1) / parts, part); });
+    return parts;
+}
+
+
+template <typename T, typename F>
+void parallel_for_each(T* begin, T* end, F f, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    _parallel_parts(end - begin, grain, pool, [&](size_t from, size_t to, size_t) {
+        for(size_t i = from; i < to; ++i) f(begin[i]);
+    });
+}
+
+template <typename T, typename U, typename F>
+void parallel_transform(const T* begin, const T* end, U* out, F f, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    _parallel_parts(end - begin, grain, pool, [&](size_t from, size_t to, size_t) {
+        for(size_t i = from; i < to; ++i) out[i] = f(begin[i]);
+    });
+}
+
+// op должна быть ассоциативной: частичные результаты частей объединяются слева направо
+template <typename T, typename R, typename Op>
+R parallel_reduce(const T* begin, const T* end, R init, Op op, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    size_t len = end - begin;
+    if(len == 0) return init;
+    size_t max_parts = pool.get_threads() * 4;
+    // unique_ptr: буфер не теряется, если op выбросит исключение
+    std::unique_ptr<R[]> partial;
+    try { partial.reset(new R[max_parts]); }
+    catch(std::bad_alloc&) { throw AllocError(); }
+    size_t parts = _parallel_parts(len, grain, pool, [&](size_t from, size_t to, size_t part) {
+        R acc = begin[from];
+        for(size_t i = from + 1; i < to; ++i) acc = op(std::move(acc), begin[i]);
+        partial[part] = std::move(acc);
+    });
+    R res = std::move(init);
+    for(size_t i = 0; i < parts; ++i) res = op(std::move(res), std::move(partial[i]));
+    return res;
+}
+
+// Указатель на первый элемент, для которого pred истинен, или end.
+// Части, лежащие правее уже найденного элемента, не просматриваются.
+template <typename T, typename Pred>
+T* parallel_find_if(T* begin, T* end, Pred pred, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    size_t len = end - begin;
+    std::atomic<size_t> found{len};
+    _parallel_parts(len, grain, pool, [&](size_t from, size_t to, size_t) {
+        for(size_t i = from; i < to; ++i) {
+            if((i & 1023) == 0 && found.load(std::memory_order_relaxed) < i) return;
+            if(pred(begin[i])) {
+                size_t cur = found.load();
+                while(i < cur && !found.compare_exchange_weak(cur, i));
+                return;
+            }
+        }
+    });
+    return begin + found.load();
+}
+
+template <typename T>
+T* parallel_find(T* begin, T* end, const std::remove_const_t<T>& key, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    return parallel_find_if(begin, end, [&key](const T& x) { return x == key; }, grain, pool);
+}
+
+template <typename T, typename Pred>
+size_t parallel_count_if(const T* begin, const T* end, Pred pred, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    std::atomic<size_t> count{0};
+    _parallel_parts(end - begin, grain, pool, [&](size_t from, size_t to, size_t) {
+        size_t local = 0;
+        for(size_t i = from; i < to; ++i) local += pred(begin[i]) ? 1 : 0;
+        count.fetch_add(local);
+    });
+    return count.load();
+}
+
+// Параллельная сортировка слиянием: части сортируются siilib::sort независимо,
+// затем попарно сливаются, каждый уровень слияний тоже выполняется параллельно
+template <typename T, typename Compare = std::less<T>>
+void parallel_sort(T* begin, T* end, Compare comp = Compare(), size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    size_t len = end - begin;
+    if(grain == 0) grain = 1;
+    size_t parts = (len + grain - 1) / grain;
+    if(parts > pool.get_threads()) parts = pool.get_threads();
+    if(parts <= 1) return sort(begin, end, comp);
+
+    std::unique_ptr<size_t[]> bounds;
+    std::unique_ptr<T[]> buf;
+    try {
+        bounds.reset(new size_t[parts + 1]);
+        buf.reset(new T[len]);
+    }
+    catch(std::bad_alloc&) { throw AllocError(); }
+    for(size_t i = 0; i <= parts; ++i) bounds[i] = len * i / parts;
+    pool.run(parts, [&](size_t part) { sort(begin + bounds[part], begin + bounds[part + 1], comp); });
+
+    T* src = begin;
+    T* dst = buf.get();
+    for(size_t width = 1; width < parts; width *= 2) {
+        size_t merges = (parts + 2 * width - 1) / (2 * width);
+        pool.run(merges, [&](size_t m) {
+            size_t lo = bounds[2 * width * m];
+            size_t mid = bounds[2 * width * m + width < parts ? 2 * width * m + width : parts];
+            size_t hi = bounds[2 * width * (m + 1) < parts ? 2 * width * (m + 1) : parts];
+            T* a = src + lo;
+            T* b = src + mid;
+            T* out = dst + lo;
+            while(a != src + mid && b != src + hi) {
+                if(comp(*b, *a)) *out++ = std::move(*b++);
+                else *out++ = std::move(*a++);
+            }
+            while(a != src + mid) *out++ = std::move(*a++);
+            while(b != src + hi) *out++ = std::move(*b++);
+        });
+        std::swap(src, dst);
+    }
+    if(src != begin) {
+        _parallel_parts(len, grain, pool, [&](size_t from, size_t to, size_t) {
+            for(size_t i = from; i < to; ++i) begin[i] = std::move(src[i]);
+        });
+    }
+}
+
+
+// Перегрузки для контейнеров с непрерывным хранением (Vector, Array)
+template <typename Container, typename F, typename = _ContainerOnly<Container>>
+void parallel_for_each(Container& c, F f, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    parallel_for_each(c.begin(), c.end(), f, grain, pool);
+}
+
+template <typename InContainer, typename OutContainer, typename F, typename = _ContainerOnly<InContainer>>
+void parallel_transform(const InContainer& in, OutContainer& out, F f, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    if(out.get_length() < in.get_length()) throw IndexError();
+    parallel_transform(in.begin(), in.end(), out.begin(), f, grain, pool);
+}
+
+template <typename Container, typename R, typename Op, typename = _ContainerOnly<Container>>
+R parallel_reduce(const Container& c, R init, Op op, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    return parallel_reduce(c.begin(), c.end(), std::move(init), op, grain, pool);
+}
+
+// Индекс первого вхождения key или Container::npos, как у try_find контейнера
+template <typename Container, typename T, typename = _ContainerOnly<Container>>
+int parallel_find(const Container& c, const T& key, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    auto pos = parallel_find(c.begin(), c.end(), key, grain, pool);
+    return pos == c.end() ? Container::npos : static_cast<int>(pos - c.begin());
+}
+
+template <typename Container, typename Pred, typename = _ContainerOnly<Container>>
+size_t parallel_count_if(const Container& c, Pred pred, size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    return parallel_count_if(c.begin(), c.end(), pred, grain, pool);
+}
+
+template <typename Container, typename Compare = std::less<std::remove_reference_t<decltype(*std::declval<Container&>().begin())>>, typename = _ContainerOnly<Container>>
+void parallel_sort(Container& c, Compare comp = Compare(), size_t grain=PARALLEL_DEFAULT_GRAIN, ThreadPool& pool=ThreadPool::global()) {
+    parallel_sort(c.begin(), c.end(), comp, grain, pool);
+}
+}
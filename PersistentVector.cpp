@@ -0,0 +1,372 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+#include "Check.hpp"
+#include "Exception.hpp"
+
+
+#define PERSISTENT_VECTOR_BITS 5
+
+
+namespace siilib {
+// Неизменяемый вектор на префиксном дереве с 32 потомками в узле и отдельным хвостовым листом.
+// push_back, set и pop_back не меняют объект, а возвращают новую версию, которая разделяет с исходной
+// все узлы, кроме O(log32 n) узлов на пути к измененному элементу. Счетчики ссылок узлов атомарные,
+// поэтому версии можно передавать в другие потоки.
+// Для серии изменений без копирования путей - Transient (см. transient()).
+// CheckPolicy - проверки индексов и пустоты (Check.hpp)
+template <typename T, typename CheckPolicy = Checked>
+class PersistentVector {
+    static constexpr size_t WIDTH = size_t(1) << PERSISTENT_VECTOR_BITS;
+    static constexpr size_t MASK = WIDTH - 1;
+
+    struct _Node {
+        std::atomic<size_t> refs{1};
+        // Узел можно менять на месте только в Transient с тем же owner (0 - ничей узел)
+        uint64_t owner;
+        explicit _Node(uint64_t owner) : owner(owner) { }
+    };
+    struct _Inner : _Node {
+        _Node* child[WIDTH]{};
+        explicit _Inner(uint64_t owner) : _Node(owner) { }
+    };
+    struct _Leaf : _Node {
+        T values[WIDTH];
+        explicit _Leaf(uint64_t owner) : _Node(owner) { }
+    };
+
+    _Node* root{nullptr};
+    _Leaf* tail{nullptr};
+    size_t length{0};
+    unsigned shift{PERSISTENT_VECTOR_BITS};
+
+
+    static uint64_t _next_owner() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    template <typename N>
+    static N* _new(uint64_t owner) {
+        try { return new N(owner); }
+        catch(const std::bad_alloc&) { throw AllocError(); }
+    }
+
+    static void _retain(_Node* node) {
+        if(node) node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    // level - высота узла: 0 у листьев, PERSISTENT_VECTOR_BITS у их родителей и т.д.
+    static void _release(_Node* node, unsigned level) {
+        if(!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        if(level == 0) {
+            delete static_cast<_Leaf*>(node);
+            return;
+        }
+        _Inner* inner = static_cast<_Inner*>(node);
+        for(size_t i = 0; i < WIDTH; ++i) _release(inner->child[i], level - PERSISTENT_VECTOR_BITS);
+        delete inner;
+    }
+
+    // Забирает ссылку на node у вызывающего и возвращает узел, который можно менять:
+    // сам node, если он принадлежит owner, иначе его копию
+    static _Node* _editable(_Node* node, unsigned level, uint64_t owner) {
+        if(owner && node->owner == owner) return node;
+        _Node* copy;
+        if(level == 0) {
+            _Leaf* leaf = _new<_Leaf>(owner);
+            for(size_t i = 0; i < WIDTH; ++i) leaf->values[i] = static_cast<_Leaf*>(node)->values[i];
+            copy = leaf;
+        }
+        else {
+            _Inner* inner = _new<_Inner>(owner);
+            for(size_t i = 0; i < WIDTH; ++i) {
+                inner->child[i] = static_cast<_Inner*>(node)->child[i];
+                _retain(inner->child[i]);
+            }
+            copy = inner;
+        }
+        _release(node, level);
+        return copy;
+    }
+
+    size_t _tail_offset() const {
+        return length < WIDTH ? 0 : ((length - 1) >> PERSISTENT_VECTOR_BITS) << PERSISTENT_VECTOR_BITS;
+    }
+
+    const _Leaf* _leaf_for(size_t index) const {
+        if(index >= _tail_offset()) return tail;
+        const _Node* node = root;
+        for(unsigned level = shift; level > 0; level -= PERSISTENT_VECTOR_BITS) {
+            node = static_cast<const _Inner*>(node)->child[(index >> level) & MASK];
+        }
+        return static_cast<const _Leaf*>(node);
+    }
+
+    size_t _check(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        return index;
+    }
+
+    static _Node* _new_path(unsigned level, _Node* leaf, uint64_t owner) {
+        if(level == 0) return leaf;
+        _Inner* node = _new<_Inner>(owner);
+        node->child[0] = _new_path(level - PERSISTENT_VECTOR_BITS, leaf, owner);
+        return node;
+    }
+
+    _Node* _push_tail(_Node* node, unsigned level, _Node* leaf, uint64_t owner) {
+        _Inner* res = static_cast<_Inner*>(_editable(node, level, owner));
+        size_t i = ((length - 1) >> level) & MASK;
+        if(level == PERSISTENT_VECTOR_BITS) res->child[i] = leaf;
+        else if(res->child[i]) res->child[i] = _push_tail(res->child[i], level - PERSISTENT_VECTOR_BITS, leaf, owner);
+        else res->child[i] = _new_path(level - PERSISTENT_VECTOR_BITS, leaf, owner);
+        return res;
+    }
+
+    // Удаляет из поддерева последний лист; nullptr, если поддерево опустело
+    _Node* _pop_tail(_Node* node, unsigned level, uint64_t owner) {
+        size_t i = ((length - 2) >> level) & MASK;
+        if(level > PERSISTENT_VECTOR_BITS) {
+            _Inner* res = static_cast<_Inner*>(_editable(node, level, owner));
+            res->child[i] = _pop_tail(res->child[i], level - PERSISTENT_VECTOR_BITS, owner);
+            if(!res->child[i] && i == 0) {
+                _release(res, level);
+                return nullptr;
+            }
+            return res;
+        }
+        if(i == 0) {
+            _release(node, level);
+            return nullptr;
+        }
+        _Inner* res = static_cast<_Inner*>(_editable(node, level, owner));
+        _release(res->child[i], 0);
+        res->child[i] = nullptr;
+        return res;
+    }
+
+    _Node* _set(_Node* node, unsigned level, size_t index, const T& x, uint64_t owner) {
+        _Node* res = _editable(node, level, owner);
+        if(level == 0) static_cast<_Leaf*>(res)->values[index & MASK] = x;
+        else {
+            _Inner* inner = static_cast<_Inner*>(res);
+            size_t i = (index >> level) & MASK;
+            inner->child[i] = _set(inner->child[i], level - PERSISTENT_VECTOR_BITS, index, x, owner);
+        }
+        return res;
+    }
+
+    // Изменения на месте: узлы копируются, если не принадлежат owner
+    void _push_back(const T& x, uint64_t owner) {
+        if(length - _tail_offset() < WIDTH && tail) {
+            tail = static_cast<_Leaf*>(_editable(tail, 0, owner));
+            tail->values[length - _tail_offset()] = x;
+            length++;
+            return;
+        }
+        if(tail) {
+            if(!root) root = _new_path(PERSISTENT_VECTOR_BITS, tail, owner);
+            else if((length >> PERSISTENT_VECTOR_BITS) > (size_t(1) << shift)) {
+                _Inner* new_root = _new<_Inner>(owner);
+                new_root->child[0] = root;
+                new_root->child[1] = _new_path(shift, tail, owner);
+                root = new_root;
+                shift += PERSISTENT_VECTOR_BITS;
+            }
+            else root = _push_tail(root, shift, tail, owner);
+        }
+        tail = _new<_Leaf>(owner);
+        tail->values[0] = x;
+        length++;
+    }
+
+    void _set(size_t index, const T& x, uint64_t owner) {
+        if(index >= _tail_offset()) {
+            tail = static_cast<_Leaf*>(_editable(tail, 0, owner));
+            tail->values[index - _tail_offset()] = x;
+        }
+        else root = _set(root, shift, index, x, owner);
+    }
+
+    void _pop_back(uint64_t owner) {
+        _require<CheckPolicy, EmptyError>(length != 0);
+        if(length == 1) {
+            clear();
+            return;
+        }
+        if(length - _tail_offset() > 1) {
+            tail = static_cast<_Leaf*>(_editable(tail, 0, owner));
+            tail->values[length - _tail_offset() - 1] = T();
+            length--;
+            return;
+        }
+        _Leaf* new_tail = const_cast<_Leaf*>(_leaf_for(length - 2));
+        _retain(new_tail);
+        _release(tail, 0);
+        tail = new_tail;
+        root = _pop_tail(root, shift, owner);
+        if(root && shift > PERSISTENT_VECTOR_BITS && !static_cast<_Inner*>(root)->child[1]) {
+            _Node* new_root = static_cast<_Inner*>(root)->child[0];
+            _retain(new_root);
+            _release(root, shift);
+            root = new_root;
+            shift -= PERSISTENT_VECTOR_BITS;
+        }
+        if(!root) shift = PERSISTENT_VECTOR_BITS;
+        length--;
+    }
+
+
+public:
+    static constexpr int npos = -1;
+
+    class Iterator {
+        const PersistentVector* vec;
+        size_t index;
+        const _Leaf* leaf;
+    public:
+        Iterator(const PersistentVector* vec, size_t index) : vec(vec), index(index), leaf(index < vec->length ? vec->_leaf_for(index) : nullptr) { }
+        const T& operator*() const { return leaf->values[index & MASK]; }
+        const T* operator->() const { return &leaf->values[index & MASK]; }
+        Iterator& operator++() {
+            if((++index & MASK) == 0 && index < vec->length) leaf = vec->_leaf_for(index);
+            return *this;
+        }
+        bool operator==(const Iterator& right) const { return index == right.index; }
+        bool operator!=(const Iterator& right) const { return index != right.index; }
+    };
+
+    // Изменяемый построитель: узлы, созданные им, меняются на месте, остальные копируются один раз.
+    // После persistent() построитель остается рабочим, но снова копирует пути, не затрагивая выданную версию.
+    class Transient {
+        PersistentVector vec;
+        uint64_t owner;
+    public:
+        explicit Transient(const PersistentVector& vec) : vec(vec), owner(_next_owner()) { }
+        Transient(const Transient&) = delete;
+        Transient& operator=(const Transient&) = delete;
+
+        size_t get_length() const { return vec.length; }
+        const T& operator[](int index) const { return vec[index]; }
+
+        Transient& push_back(const T& x) { vec._push_back(x, owner); return *this; }
+        Transient& set(int index, const T& x) { vec._set(vec._check(index), x, owner); return *this; }
+        Transient& pop_back() { vec._pop_back(owner); return *this; }
+
+        PersistentVector persistent() {
+            owner = _next_owner();
+            return vec;
+        }
+    };
+
+    PersistentVector() = default;
+    PersistentVector(const T* ar, size_t len) {
+        Transient builder(*this);
+        for(size_t i = 0; i < len; ++i) builder.push_back(ar[i]);
+        *this = builder.persistent();
+    }
+    PersistentVector(std::initializer_list<T> ar) {
+        Transient builder(*this);
+        for(const T& x : ar) builder.push_back(x);
+        *this = builder.persistent();
+    }
+    PersistentVector(const PersistentVector& right) : root(right.root), tail(right.tail), length(right.length), shift(right.shift) {
+        _retain(root);
+        _retain(tail);
+    }
+    PersistentVector(PersistentVector&& right) noexcept : root(right.root), tail(right.tail), length(right.length), shift(right.shift) {
+        right.root = nullptr;
+        right.tail = nullptr;
+        right.length = 0;
+        right.shift = PERSISTENT_VECTOR_BITS;
+    }
+    ~PersistentVector() { clear(); }
+
+    PersistentVector& operator=(const PersistentVector& right) {
+        if(this == &right) return *this;
+        _retain(right.root);
+        _retain(right.tail);
+        clear();
+        root = right.root;
+        tail = right.tail;
+        length = right.length;
+        shift = right.shift;
+        return *this;
+    }
+    PersistentVector& operator=(PersistentVector&& right) noexcept {
+        if(this == &right) return *this;
+        clear();
+        std::swap(root, right.root);
+        std::swap(tail, right.tail);
+        std::swap(length, right.length);
+        std::swap(shift, right.shift);
+        return *this;
+    }
+
+    void clear() {
+        _release(root, shift);
+        _release(tail, 0);
+        root = nullptr;
+        tail = nullptr;
+        length = 0;
+        shift = PERSISTENT_VECTOR_BITS;
+    }
+
+    size_t get_length() const { return length; }
+    bool is_empty() const { return length == 0; }
+
+    // Новые версии; исходный объект не меняется
+    PersistentVector push_back(const T& x) const {
+        PersistentVector res(*this);
+        res._push_back(x, 0);
+        return res;
+    }
+    PersistentVector set(int index, const T& x) const {
+        PersistentVector res(*this);
+        res._set(_check(index), x, 0);
+        return res;
+    }
+    PersistentVector pop_back() const {
+        PersistentVector res(*this);
+        res._pop_back(0);
+        return res;
+    }
+
+    Transient transient() const { return Transient(*this); }
+
+    const T& operator[](int index) const {
+        size_t i = _check(index);
+        return _leaf_for(i)->values[i & MASK];
+    }
+    const T* get(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return &_leaf_for(index)->values[index & MASK];
+    }
+    const T& front() const { _require<CheckPolicy, EmptyError>(length != 0); return (*this)[0]; }
+    const T& back() const { _require<CheckPolicy, EmptyError>(length != 0); return (*this)[-1]; }
+
+    int find(const T& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const T& key) const {
+        int i = 0;
+        for(const T& x : *this) {
+            if(x == key) return i;
+            ++i;
+        }
+        return npos;
+    }
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, length); }
+};
+}
@@ -1,11 +1,15 @@
+#pragma once
+
 #include <memory>
+#include <optional>
 
 #include "Exception.hpp"
 #include "OneLinkedList.cpp"
 
 
 namespace siilib {
-template <typename T, typename Container = OneLinkedList<T>>
+// CheckPolicy - проверка пустоты в pop (Check.hpp); проверки top/front/back задает политика Container
+template <typename T, typename Container = OneLinkedList<T>, typename CheckPolicy = Checked>
 class Queue {
 
     Container c;
@@ -13,13 +17,19 @@ class Queue {
 
 public:
     Queue(size_t max_length=0) : max_length(max_length) { }
-    Queue(const Queue<T>& right) : max_length(right.max_length), c(right.c) { }
-    Queue(Queue<T>&& right) noexcept : max_length(right.max_length), c(std::move(right.c)) { }
+    // Готовый контейнер, например RingBuffer<T>(1024, true) - окно последних 1024 элементов
+    Queue(Container c, size_t max_length=0) : c(std::move(c)), max_length(max_length) { }
+    Queue(const Queue& right) : max_length(right.max_length), c(right.c) { }
+    Queue(Queue&& right) noexcept : max_length(right.max_length), c(std::move(right.c)) { }
 
     void clear() { c.clear(); }
 
     bool is_empty() const { return c.get_length() == 0; }
 
+    // Счетчики работы базового контейнера (нулевые без -DSIILIB_STATS)
+    StatsSnapshot get_stats() const { return c.get_stats(); }
+    void reset_stats() { c.reset_stats(); }
+
     size_t get_length() const { return c.get_length(); }
 
 
@@ -33,22 +43,34 @@ public:
     }
 
     T pop() { 
-        if(c.get_length() == 0) throw EmptyError();
+        _require<CheckPolicy, EmptyError>(c.get_length() != 0);
         return c.pop_front();
     }
 
+    T* try_push(const T& x) {
+        if(max_length) if(c.get_length() >= max_length) return nullptr;
+        return &c.push_back(x);
+    }
+    T* try_push(T&& x) {
+        if(max_length) if(c.get_length() >= max_length) return nullptr;
+        return &c.push_back(std::move(x));
+    }
+    std::optional<T> try_pop() {
+        return c.try_pop_front();
+    }
+
     T& front() { return c.front(); }
     const T& front() const { return c.front(); }
     T& back() { return c.back(); }
     const T& back() const { return c.back(); }
 
-    Queue<T>& operator=(const Queue<T>& right) {
+    Queue& operator=(const Queue& right) {
         if(&right == this) return *this;
         this->max_length = right.max_length;
         this->c = right.c;
         return *this;
     }
-    Queue<T>& operator=(Queue<T>&& right) noexcept {
+    Queue& operator=(Queue&& right) noexcept {
         if(&right == this) return *this;
         this->max_length = right.max_length;
         this->c = std::move(right.c);
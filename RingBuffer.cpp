@@ -0,0 +1,245 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "Check.hpp"
+#include "Exception.hpp"
+#include "Span.cpp"
+#include "Stats.hpp"
+
+
+#define RINGBUFFER_MIN_CAPACITY 16
+
+
+namespace siilib {
+// Кольцевой буфер в непрерывном массиве, емкость - степень двойки (позиция элемента вычисляется маской, без деления).
+// Индекс 0 - самый старый элемент, -1 - самый новый.
+// В режиме overwrite емкость постоянна: push_back в полный буфер заменяет самый старый элемент (окно последних N
+// значений), push_front - самый новый. Без него полный буфер растет вдвое, и RingBuffer можно использовать
+// как контейнер Queue вместо списка: узлы не выделяются на каждый элемент.
+template <typename T, typename CheckPolicy = Checked>
+class RingBuffer : public _Stats {
+    T* data{nullptr};
+    size_t capacity{0};
+    size_t first{0};
+    size_t length{0};
+    bool overwrite{false};
+
+
+    static size_t _round(size_t n) {
+        size_t res = 1;
+        while(res < n) res <<= 1;
+        return res;
+    }
+    size_t _pos(size_t index) const { return (first + index) & (capacity - 1); }
+
+    // Переносит элементы в новый буфер, самый старый - в начало
+    void _reallocate(size_t new_capacity) {
+        T* ptr;
+        try { ptr = new T[new_capacity]; }
+        catch(std::bad_alloc&) { throw ResizeError(); }
+        for(size_t i = 0; i < length; ++i) ptr[i] = std::move(data[_pos(i)]);
+        this->_stat_moved(length);
+        this->_stat_realloc();
+        this->_stat_alloc(new_capacity * sizeof(T));
+        if(data) this->_stat_free(capacity * sizeof(T));
+        delete[] data;
+        data = ptr;
+        capacity = new_capacity;
+        first = 0;
+    }
+    void _grow() { _reallocate(capacity ? capacity * 2 : RINGBUFFER_MIN_CAPACITY); }
+
+    template <typename U>
+    T& _push_back(U&& x) {
+        if(length == capacity) {
+            if(overwrite && capacity) {
+                T& slot = data[first];
+                first = _pos(1);
+                return slot = std::forward<U>(x);
+            }
+            _grow();
+        }
+        return data[_pos(length++)] = std::forward<U>(x);
+    }
+    template <typename U>
+    T& _push_front(U&& x) {
+        if(length == capacity) {
+            if(overwrite && capacity) {
+                // Самый новый элемент лежит сразу перед самым старым
+                first = _pos(capacity - 1);
+                return data[first] = std::forward<U>(x);
+            }
+            _grow();
+        }
+        first = _pos(capacity - 1);
+        ++length;
+        return data[first] = std::forward<U>(x);
+    }
+
+    T _pop_back() {
+        T& slot = data[_pos(--length)];
+        T tmp = std::move(slot);
+        slot = T();
+        return tmp;
+    }
+    T _pop_front() {
+        T& slot = data[first];
+        T tmp = std::move(slot);
+        slot = T();
+        first = _pos(1);
+        --length;
+        return tmp;
+    }
+
+    int _index(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        return index;
+    }
+
+
+public:
+    static constexpr int npos = -1;
+
+    template <typename U>
+    class _Iterator {
+        U* data;
+        size_t mask;
+        size_t pos;
+    public:
+        _Iterator(U* data, size_t mask, size_t pos) : data(data), mask(mask), pos(pos) { }
+        U& operator*() const { return data[pos & mask]; }
+        U* operator->() const { return data + (pos & mask); }
+        _Iterator& operator++() { ++pos; return *this; }
+        bool operator==(const _Iterator& right) const { return pos == right.pos; }
+        bool operator!=(const _Iterator& right) const { return pos != right.pos; }
+    };
+    using Iterator = _Iterator<T>;
+    using ConstIterator = _Iterator<const T>;
+
+    // Емкость округляется вверх до степени двойки
+    RingBuffer(size_t capacity=RINGBUFFER_MIN_CAPACITY, bool overwrite=false) : capacity(_round(capacity)), overwrite(overwrite) {
+        try { data = new T[this->capacity]; }
+        catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(this->capacity * sizeof(T));
+    }
+    RingBuffer(std::initializer_list<T> ar) : RingBuffer(ar.size() > RINGBUFFER_MIN_CAPACITY ? ar.size() : RINGBUFFER_MIN_CAPACITY) {
+        for(const T& x : ar) data[length++] = x;
+        this->_stat_copied(length);
+    }
+    RingBuffer(const RingBuffer& right) : RingBuffer(right.capacity, right.overwrite) {
+        for(size_t i = 0; i < right.length; ++i) data[i] = right.data[right._pos(i)];
+        length = right.length;
+        this->_stat_copied(length);
+    }
+    RingBuffer(RingBuffer&& right) noexcept : data(right.data), capacity(right.capacity), first(right.first), length(right.length), overwrite(right.overwrite) {
+        right.data = nullptr;
+        right.capacity = 0;
+        right.first = 0;
+        right.length = 0;
+    }
+    ~RingBuffer() {
+        if(data) this->_stat_free(capacity * sizeof(T));
+        delete[] data;
+    }
+
+    void clear() {
+        for(size_t i = 0; i < length; ++i) data[_pos(i)] = T();
+        first = 0;
+        length = 0;
+    }
+
+    size_t get_length() const { return length; }
+    size_t get_capacity() const { return capacity; }
+    size_t get_size() const { return capacity * sizeof(T); }
+    bool is_empty() const { return length == 0; }
+    bool is_full() const { return length == capacity; }
+    bool is_overwrite() const { return overwrite; }
+    void set_overwrite(bool overwrite) { this->overwrite = overwrite; }
+
+    T& push_back(const T& x) { return _push_back(x); }
+    T& push_back(T&& x) { return _push_back(std::move(x)); }
+    T& push_front(const T& x) { return _push_front(x); }
+    T& push_front(T&& x) { return _push_front(std::move(x)); }
+
+    T pop_back() {
+        _require<CheckPolicy, EmptyError>(length != 0);
+        return _pop_back();
+    }
+    T pop_front() {
+        _require<CheckPolicy, EmptyError>(length != 0);
+        return _pop_front();
+    }
+    std::optional<T> try_pop_back() {
+        if(length == 0) return std::nullopt;
+        return _pop_back();
+    }
+    std::optional<T> try_pop_front() {
+        if(length == 0) return std::nullopt;
+        return _pop_front();
+    }
+
+    T& front() { _require<CheckPolicy, EmptyError>(length != 0); return data[first]; }
+    const T& front() const { _require<CheckPolicy, EmptyError>(length != 0); return data[first]; }
+    T& back() { _require<CheckPolicy, EmptyError>(length != 0); return data[_pos(length - 1)]; }
+    const T& back() const { _require<CheckPolicy, EmptyError>(length != 0); return data[_pos(length - 1)]; }
+
+    T& operator[](int index) { return data[_pos(_index(index))]; }
+    const T& operator[](int index) const { return data[_pos(_index(index))]; }
+    T* get(int index) {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return data + _pos(index);
+    }
+    const T* get(int index) const { return const_cast<RingBuffer*>(this)->get(index); }
+
+    // Элементы от самого старого к самому новому - не больше двух непрерывных частей (вторая может быть пустой).
+    // Каждую часть можно обрабатывать как обычный массив, в том числе функциями Numeric.cpp:
+    //     auto [older, newer] = rb.get_spans();
+    //     double total = sum(older.get_data(), older.get_data() + older.get_length()) + ...
+    std::pair<Span<T>, Span<T>> get_spans() {
+        size_t head = capacity - first < length ? capacity - first : length;
+        return {Span<T>(data + first, head), Span<T>(data, length - head)};
+    }
+    std::pair<ConstSpan<T>, ConstSpan<T>> get_spans() const {
+        size_t head = capacity - first < length ? capacity - first : length;
+        return {ConstSpan<T>(data + first, head), ConstSpan<T>(data, length - head)};
+    }
+    // Копирует все элементы от самого старого в out (не меньше get_length() элементов), возвращает их число
+    size_t copy_to(T* out) const {
+        auto [older, newer] = get_spans();
+        for(size_t i = 0; i < older.get_length(); ++i) out[i] = older.get_data()[i];
+        for(size_t i = 0; i < newer.get_length(); ++i) out[older.get_length() + i] = newer.get_data()[i];
+        return length;
+    }
+
+    Iterator begin() { return Iterator(data, capacity - 1, first); }
+    Iterator end() { return Iterator(data, capacity - 1, first + length); }
+    ConstIterator begin() const { return ConstIterator(data, capacity - 1, first); }
+    ConstIterator end() const { return ConstIterator(data, capacity - 1, first + length); }
+
+    RingBuffer& operator=(const RingBuffer& right) {
+        if(&right == this) return *this;
+        RingBuffer tmp(right);
+        return *this = std::move(tmp);
+    }
+    RingBuffer& operator=(RingBuffer&& right) noexcept {
+        if(&right == this) return *this;
+        if(data) this->_stat_free(capacity * sizeof(T));
+        delete[] data;
+        data = right.data;
+        capacity = right.capacity;
+        first = right.first;
+        length = right.length;
+        overwrite = right.overwrite;
+        right.data = nullptr;
+        right.capacity = 0;
+        right.first = 0;
+        right.length = 0;
+        return *this;
+    }
+};
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <limits>
+
+#include "Exception.hpp"
+#include "Numeric.cpp"
+#include "Vector.cpp"
+
+
+namespace siilib {
+// Операции дерева отрезков с прибавлением числа ко всему диапазону (Update - прибавляемое число).
+// Своя операция описывает:
+//     identity() - нейтральный элемент combine;
+//     combine(a, b) - значение объединения соседних отрезков a и b (a левее);
+//     apply(value, u, len) - значение отрезка из len элементов после изменения u;
+//     compose(older, newer) - одно изменение, равносильное older, затем newer.
+template <typename T>
+struct SumOp {
+    using Update = T;
+    static T identity() { return T(); }
+    static T combine(const T& a, const T& b) { return a + b; }
+    static T apply(const T& value, const Update& u, size_t len) { return value + u * static_cast<T>(len); }
+    static Update compose(const Update& older, const Update& newer) { return older + newer; }
+};
+template <typename T>
+struct MinOp {
+    using Update = T;
+    static T identity() { return std::numeric_limits<T>::max(); }
+    static T combine(const T& a, const T& b) { return b < a ? b : a; }
+    static T apply(const T& value, const Update& u, size_t) { return value + u; }
+    static Update compose(const Update& older, const Update& newer) { return older + newer; }
+};
+template <typename T>
+struct MaxOp {
+    using Update = T;
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+    static T combine(const T& a, const T& b) { return a < b ? b : a; }
+    static T apply(const T& value, const Update& u, size_t) { return value + u; }
+    static Update compose(const Update& older, const Update& newer) { return older + newer; }
+};
+
+
+// Дерево отрезков: запрос Op::combine по диапазону и изменение диапазона за O(log n) с отложенным
+// применением изменений (lazy propagation). Дерево - неявная куча в одном массиве: корень 1, дети узла p -
+// 2p и 2p + 1, листья - с позиции size (длина, округленная вверх до степени двойки). Запросы и изменения
+// идут снизу вверх циклом, без рекурсии; отложенные изменения хранятся только у внутренних узлов
+// и проталкиваются к детям на пути от корня к краям диапазона. Построение из Array, Vector или массива - O(n).
+// Диапазоны полуоткрытые [from, to); пустой диапазон дает Op::identity(). Значения элементов у краев
+// диапазона можно считать только после проталкивания, поэтому query меняет внутреннее состояние
+// (одновременные query из нескольких потоков требуют внешней блокировки).
+template <typename T, typename Op = SumOp<T>>
+class SegmentTree {
+public:
+    using Update = typename Op::Update;
+
+private:
+    mutable Vector<T> tree;
+    mutable Vector<Update> lazy;
+    mutable Vector<uint8_t> pending;
+    size_t length{0};
+    size_t size{1};
+    unsigned height{0};
+
+
+    void _init(size_t length) {
+        this->length = length;
+        while(size < length) {
+            size <<= 1;
+            height++;
+        }
+        for(size_t i = 0; i < 2 * size; ++i) tree.push_back(Op::identity());
+        for(size_t i = 0; i < size; ++i) {
+            lazy.push_back(Update());
+            pending.push_back(0);
+        }
+    }
+    void _build_all() const {
+        T* t = tree.begin();
+        for(size_t p = size - 1; p > 0; --p) t[p] = Op::combine(t[2 * p], t[2 * p + 1]);
+    }
+
+    // Изменение u целиком для узла p из len листьев
+    void _apply(size_t p, const Update& u, size_t len) const {
+        tree.begin()[p] = Op::apply(tree.begin()[p], u, len);
+        if(p < size) {
+            Update& d = lazy.begin()[p];
+            d = pending.begin()[p] ? Op::compose(d, u) : u;
+            pending.begin()[p] = 1;
+        }
+    }
+    // Проталкивает отложенные изменения всех предков листа p
+    void _push(size_t p) const {
+        for(unsigned s = height; s > 0; --s) {
+            size_t i = p >> s;
+            if(!pending.begin()[i]) continue;
+            size_t len = size_t(1) << (s - 1);
+            _apply(2 * i, lazy.begin()[i], len);
+            _apply(2 * i + 1, lazy.begin()[i], len);
+            pending.begin()[i] = 0;
+        }
+    }
+    // Пересчитывает предков листа p
+    void _rebuild(size_t p) {
+        T* t = tree.begin();
+        for(size_t len = 2; p > 1; len <<= 1) {
+            p >>= 1;
+            t[p] = Op::combine(t[2 * p], t[2 * p + 1]);
+            if(pending.begin()[p]) t[p] = Op::apply(t[p], lazy.begin()[p], len);
+        }
+    }
+
+    void _check_range(size_t from, size_t to) const {
+        if(from > to || to > length) throw IndexError();
+    }
+
+
+public:
+    // length элементов со значением value
+    SegmentTree(size_t length=0, const T& value=Op::identity()) {
+        _init(length);
+        for(size_t i = 0; i < length; ++i) tree.begin()[size + i] = value;
+        _build_all();
+    }
+    SegmentTree(const T* first, const T* last) {
+        _init(last - first);
+        for(size_t i = 0; i < length; ++i) tree.begin()[size + i] = first[i];
+        _build_all();
+    }
+    template <typename Container, typename = _NumericContainer<Container>>
+    SegmentTree(const Container& c) : SegmentTree(c.begin(), c.end()) { }
+
+    size_t get_length() const { return length; }
+    bool is_empty() const { return length == 0; }
+
+    T query(size_t from, size_t to) const {
+        _check_range(from, to);
+        if(from == to) return Op::identity();
+        from += size;
+        to += size;
+        _push(from);
+        _push(to - 1);
+        const T* t = tree.begin();
+        T left = Op::identity(), right = Op::identity();
+        for(; from < to; from >>= 1, to >>= 1) {
+            if(from & 1) left = Op::combine(left, t[from++]);
+            if(to & 1) right = Op::combine(t[--to], right);
+        }
+        return Op::combine(left, right);
+    }
+    // Значение всего массива - корень, без обхода
+    T query() const { return tree.begin()[1]; }
+    // Пакет запросов: out[i] = query(from[i], to[i])
+    void query(const size_t* from, const size_t* to, size_t count, T* out) const {
+        for(size_t i = 0; i < count; ++i) out[i] = query(from[i], to[i]);
+    }
+
+    T get(size_t index) const {
+        if(index >= length) throw IndexError();
+        _push(size + index);
+        return tree.begin()[size + index];
+    }
+    void set(size_t index, const T& value) {
+        if(index >= length) throw IndexError();
+        size_t p = size + index;
+        _push(p);
+        tree.begin()[p] = value;
+        _rebuild(p);
+    }
+
+    // Применяет u ко всем элементам [from, to)
+    void update(size_t from, size_t to, const Update& u) {
+        _check_range(from, to);
+        if(from == to) return;
+        size_t l = from + size, r = to + size;
+        _push(l);
+        _push(r - 1);
+        for(size_t len = 1; l < r; l >>= 1, r >>= 1, len <<= 1) {
+            if(l & 1) _apply(l++, u, len);
+            if(r & 1) _apply(--r, u, len);
+        }
+        _rebuild(from + size);
+        _rebuild(to - 1 + size);
+    }
+    void update(size_t index, const Update& u) { update(index, index + 1, u); }
+};
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+// Запись и чтение через файловый дескриптор (writev/read) - только там, где есть POSIX;
+// без него остаются потоки, и Vector и другие контейнеры подключают Serialize.hpp без <unistd.h>
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#include <unistd.h>
+#define SIILIB_SERIALIZE_FD
+#endif
+
+#include "Exception.hpp"
+#include "Span.cpp"
+
+
+#define SERIALIZE_VERSION 2
+#define SERIALIZE_IOV 256
+#define SERIALIZE_CHUNK 65536
+#define SERIALIZE_SMALL 512
+
+
+namespace siilib {
+// Двоичный формат контейнеров: заголовок SerialHeader, за ним элементы подряд.
+// Тривиально копируемые элементы хранятся как есть (порядок байтов машины, записавшей данные) и пишутся
+// и читаются одним блоком; std::string - длина uint64_t и байты строки.
+// kind (с версии 2; в версии 1 - reserved, всегда 0) отличает целые от вещественных того же размера.
+// Данные начинаются сразу за 24-байтным заголовком, поэтому сохраненный массив можно читать на месте (load_view).
+struct SerialHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t encoding;
+    uint32_t element_size;
+    uint32_t kind;
+    uint64_t length;
+};
+
+enum SerialEncoding : uint16_t {
+    SERIAL_RAW = 1,
+    SERIAL_STRING = 2
+};
+
+template <typename T>
+constexpr uint16_t _serial_encoding() {
+    if constexpr(std::is_same_v<T, std::string>) return SERIAL_STRING;
+    else if constexpr(std::is_trivially_copyable_v<T>) return SERIAL_RAW;
+    else return 0;
+}
+
+enum SerialKind : uint32_t {
+    SERIAL_SIGNED = 1,
+    SERIAL_UNSIGNED = 2,
+    SERIAL_FLOAT = 3,
+    SERIAL_OTHER = 4
+};
+
+template <typename T>
+constexpr uint32_t _serial_kind() {
+    if constexpr(std::is_floating_point_v<T>) return SERIAL_FLOAT;
+    else if constexpr(std::is_integral_v<T>) return std::is_signed_v<T> ? SERIAL_SIGNED : SERIAL_UNSIGNED;
+    else return SERIAL_OTHER;
+}
+
+template <typename T>
+void _check_header(const SerialHeader& header) {
+    if(std::memcmp(header.magic, "SIIL", 4) != 0 || header.version == 0 || header.version > SERIALIZE_VERSION) throw FormatError();
+    if(header.encoding != _serial_encoding<T>() || header.element_size != sizeof(T)) throw TypeError();
+    if(header.version >= 2 && header.kind != _serial_kind<T>()) throw TypeError();
+    // Поврежденная длина: емкость под такой массив (с запасом вдвое) не выражается в size_t
+    if(header.length > SIZE_MAX / 2 / sizeof(T)) throw FormatError();
+}
+
+
+// Приемник данных: поток или файловый дескриптор. Записи в дескриптор собираются в пакеты до SERIALIZE_IOV
+// блоков и уходят одним вызовом writev: большие блоки пишутся с места, мелкие (длины строк, элементы списков)
+// копируются в общий буфер SERIALIZE_CHUNK байт.
+class Writer {
+    std::ostream* os{nullptr};
+#ifdef SIILIB_SERIALIZE_FD
+    int fd{-1};
+    iovec iov[SERIALIZE_IOV];
+    int count{0};
+    std::unique_ptr<char[]> buf;
+    size_t buf_used{0};
+#endif
+    SerialHeader header;
+
+    void _add(const void* data, size_t size) {
+        if(os) {
+            if(!os->write(static_cast<const char*>(data), size)) throw IOError();
+            return;
+        }
+#ifdef SIILIB_SERIALIZE_FD
+        if(size < SERIALIZE_SMALL) {
+            if(!buf) buf.reset(new char[SERIALIZE_CHUNK]);
+            // Сброс только до копирования: после flush буфер снова заполняется с начала,
+            // и блок, поставленный в очередь после копирования, указывал бы на перезаписываемые данные
+            if(buf_used + size > SERIALIZE_CHUNK || count == SERIALIZE_IOV) flush();
+            char* to = buf.get() + buf_used;
+            std::memcpy(to, data, size);
+            buf_used += size;
+            // Продолжение предыдущего блока буфера
+            if(count && static_cast<char*>(iov[count - 1].iov_base) + iov[count - 1].iov_len == to) {
+                iov[count - 1].iov_len += size;
+                return;
+            }
+            data = to;
+        }
+        if(count == SERIALIZE_IOV) flush();
+        iov[count++] = iovec{const_cast<void*>(data), size};
+#endif
+    }
+
+public:
+    Writer(std::ostream& os) : os(&os) { }
+#ifdef SIILIB_SERIALIZE_FD
+    Writer(int fd) : fd(fd) { }
+#endif
+    Writer(const Writer&) = delete;
+
+    template <typename T>
+    void write_header(size_t length) {
+        static_assert(_serial_encoding<T>() != 0, "only trivially copyable types and std::string can be serialized");
+        std::memcpy(header.magic, "SIIL", 4);
+        header.version = SERIALIZE_VERSION;
+        header.encoding = _serial_encoding<T>();
+        header.element_size = sizeof(T);
+        header.kind = _serial_kind<T>();
+        header.length = length;
+        _add(&header, sizeof(header));
+    }
+
+    // Крупные элементы должны оставаться на месте до flush()
+    template <typename T>
+    void write_element(const T& x) {
+        if constexpr(_serial_encoding<T>() == SERIAL_RAW) _add(&x, sizeof(T));
+        else {
+            uint64_t size = x.size();
+            _add(&size, sizeof(size));
+            if(size) _add(x.data(), size);
+        }
+    }
+    template <typename T>
+    void write_elements(const T* data, size_t n) {
+        if constexpr(_serial_encoding<T>() == SERIAL_RAW) {
+            if(n) _add(data, n * sizeof(T));
+        }
+        else for(size_t i = 0; i < n; ++i) write_element(data[i]);
+    }
+
+    void flush() {
+#ifdef SIILIB_SERIALIZE_FD
+        int first = 0;
+        while(first < count) {
+            ssize_t written = ::writev(fd, iov + first, count - first);
+            if(written < 0) {
+                if(errno == EINTR) continue;
+                throw IOError();
+            }
+            // Частичная запись: пропускаем записанные блоки и сдвигаем начало недописанного
+            size_t left = written;
+            while(first < count && left >= iov[first].iov_len) left -= iov[first++].iov_len;
+            if(left) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+        count = 0;
+        buf_used = 0;
+#endif
+    }
+};
+
+
+// Источник данных: поток или файловый дескриптор. Неполные данные - FormatError, ошибка чтения - IOError.
+// Мелкие чтения из дескриптора идут через буфер SERIALIZE_CHUNK байт; прочитанное с опережением
+// возвращается в файл через lseek, поэтому из одного файла можно загружать контейнеры подряд
+// (в канал или сокет прочитанное не вернуть - из них загружайте один контейнер или читайте через istream).
+class Reader {
+    std::istream* is{nullptr};
+#ifdef SIILIB_SERIALIZE_FD
+    int fd{-1};
+    std::unique_ptr<char[]> buf;
+    size_t buf_begin{0};
+    size_t buf_end{0};
+
+    size_t _read_fd(char* ptr, size_t size) {
+        while(true) {
+            ssize_t got = ::read(fd, ptr, size);
+            if(got >= 0) return got;
+            if(errno != EINTR) throw IOError();
+        }
+    }
+#endif
+
+    void _read(void* data, size_t size) {
+        if(is) {
+            if(!is->read(static_cast<char*>(data), size)) throw FormatError();
+            return;
+        }
+#ifdef SIILIB_SERIALIZE_FD
+        char* ptr = static_cast<char*>(data);
+        size_t part = buf_end - buf_begin < size ? buf_end - buf_begin : size;
+        if(part) {
+            std::memcpy(ptr, buf.get() + buf_begin, part);
+            buf_begin += part;
+            ptr += part;
+            size -= part;
+        }
+        while(size >= SERIALIZE_SMALL) {
+            size_t got = _read_fd(ptr, size);
+            if(got == 0) throw FormatError();
+            ptr += got;
+            size -= got;
+        }
+        while(size) {
+            if(!buf) buf.reset(new char[SERIALIZE_CHUNK]);
+            buf_begin = 0;
+            buf_end = _read_fd(buf.get(), SERIALIZE_CHUNK);
+            if(buf_end == 0) throw FormatError();
+            part = buf_end < size ? buf_end : size;
+            std::memcpy(ptr, buf.get(), part);
+            buf_begin = part;
+            ptr += part;
+            size -= part;
+        }
+#endif
+    }
+
+    template <typename T>
+    void _read_element(T& x) {
+        if constexpr(_serial_encoding<T>() == SERIAL_RAW) _read(&x, sizeof(T));
+        else {
+            uint64_t size;
+            _read(&size, sizeof(size));
+            if(size > x.max_size()) throw FormatError();
+            // Длинная строка растет по мере чтения: поврежденная длина упирается в конец данных (FormatError),
+            // а не в выделение памяти под всю заявленную длину
+            x.clear();
+            for(uint64_t done = 0; done < size;) {
+                size_t part = size - done < SERIALIZE_CHUNK ? size - done : SERIALIZE_CHUNK;
+                x.resize(done + part);
+                _read(&x[done], part);
+                done += part;
+            }
+        }
+    }
+
+public:
+    Reader(std::istream& is) : is(&is) { }
+#ifdef SIILIB_SERIALIZE_FD
+    Reader(int fd) : fd(fd) { }
+#endif
+    Reader(const Reader&) = delete;
+#ifdef SIILIB_SERIALIZE_FD
+    ~Reader() {
+        if(buf_end > buf_begin) ::lseek(fd, -static_cast<off_t>(buf_end - buf_begin), SEEK_CUR);
+    }
+#endif
+
+    // Проверяет заголовок и возвращает число элементов; другой тип элементов - TypeError
+    template <typename T>
+    size_t read_header() {
+        static_assert(_serial_encoding<T>() != 0, "only trivially copyable types and std::string can be serialized");
+        SerialHeader header;
+        _read(&header, sizeof(header));
+        _check_header<T>(header);
+        return header.length;
+    }
+
+    template <typename T>
+    void read_elements(T* data, size_t n) {
+        if constexpr(_serial_encoding<T>() == SERIAL_RAW) {
+            if(n) _read(data, n * sizeof(T));
+        }
+        else for(size_t i = 0; i < n; ++i) _read_element(data[i]);
+    }
+    // Читает n элементов частями по SERIALIZE_CHUNK байт и передает каждый в f(T&&)
+    template <typename T, typename F>
+    void read_each(size_t n, F&& f) {
+        size_t chunk = SERIALIZE_CHUNK / sizeof(T) ? SERIALIZE_CHUNK / sizeof(T) : 1;
+        std::unique_ptr<T[]> items(new T[n < chunk ? (n ? n : 1) : chunk]);
+        while(n) {
+            size_t part = n < chunk ? n : chunk;
+            read_elements(items.get(), part);
+            for(size_t i = 0; i < part; ++i) f(std::move(items[i]));
+            n -= part;
+        }
+    }
+};
+
+
+// Элементы, сохраненные save, прямо в буфере (например, в файле, отображенном mmap) без копирования.
+// Только для тривиально копируемых T; буфер должен жить дольше представления.
+template <typename T>
+ConstSpan<T> load_view(const void* buffer, size_t size) {
+    static_assert(_serial_encoding<T>() == SERIAL_RAW, "load_view needs a trivially copyable element type");
+    if(size < sizeof(SerialHeader)) throw FormatError();
+    SerialHeader header;
+    std::memcpy(&header, buffer, sizeof(header));
+    _check_header<T>(header);
+    const char* data = static_cast<const char*>(buffer) + sizeof(SerialHeader);
+    if(header.length > (size - sizeof(SerialHeader)) / sizeof(T)) throw FormatError();
+    if(reinterpret_cast<uintptr_t>(data) % alignof(T)) throw ValueError();
+    return ConstSpan<T>(reinterpret_cast<const T*>(data), header.length);
+}
+}
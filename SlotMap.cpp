@@ -0,0 +1,171 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+#include "Exception.hpp"
+#include "Vector.cpp"
+
+
+namespace siilib {
+// Ссылка на элемент SlotMap: номер ячейки и поколение, в котором элемент был вставлен.
+// Ручка по умолчанию (поколение 0) не указывает ни на какой элемент.
+struct SlotHandle {
+    uint32_t index{0};
+    uint32_t generation{0};
+
+    bool operator==(const SlotHandle& right) const { return index == right.index && generation == right.generation; }
+    bool operator!=(const SlotHandle& right) const { return !(*this == right); }
+};
+
+
+// Значения лежат подряд в Vector (обход - как по обычному массиву), а доступ к ним идет через ручки SlotHandle.
+// Ячейка хранит позицию значения в плотном массиве и поколение: нечетное - ячейка занята, четное - свободна.
+// Удаление переносит последнее значение на место удаленного и увеличивает поколение ячейки, поэтому
+// вставка, удаление и поиск - O(1), а ручки удаленных элементов перестают действовать (get дает nullptr,
+// at - KeyError). Свободные ячейки переиспользуются; поколение повторится только через 2^31 повторных
+// использований одной ячейки. Порядок значений при удалении меняется.
+template <typename T>
+class SlotMap {
+    struct Slot {
+        uint32_t dense{0};       // позиция значения или следующая свободная ячейка
+        uint32_t generation{0};
+    };
+
+    Vector<T> values;
+    Vector<uint32_t> owners;     // номер ячейки для каждого значения
+    Vector<Slot> slots;
+    uint32_t free_head{NONE};
+
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    const Slot* _slot(SlotHandle h) const {
+        if(h.index >= slots.get_length()) return nullptr;
+        const Slot* slot = slots.begin() + h.index;
+        return slot->generation == h.generation && (h.generation & 1) ? slot : nullptr;
+    }
+
+    // Ячейка занимается только после добавления значения и ее номера; исключение на любом шаге
+    // откатывает уже сделанное, и свободная ячейка не теряется
+    template <typename U>
+    SlotHandle _insert(U&& x) {
+        bool reuse = free_head != NONE;
+        if(!reuse && slots.get_length() == NONE) throw OverflowError();
+        uint32_t index = reuse ? free_head : static_cast<uint32_t>(slots.get_length());
+        values.push_back(std::forward<U>(x));
+        try { owners.push_back(index); }
+        catch(...) { values.pop_back(); throw; }
+        if(reuse) free_head = slots.begin()[index].dense;
+        else {
+            try { slots.push_back(Slot()); }
+            catch(...) {
+                values.pop_back();
+                owners.pop_back();
+                throw;
+            }
+        }
+        Slot& slot = slots.begin()[index];
+        slot.dense = static_cast<uint32_t>(values.get_length() - 1);
+        slot.generation++;
+        return SlotHandle{index, slot.generation};
+    }
+
+    void _erase(uint32_t index) {
+        Slot& slot = slots.begin()[index];
+        size_t last = values.get_length() - 1;
+        if(slot.dense != last) {
+            values.begin()[slot.dense] = std::move(values.begin()[last]);
+            owners.begin()[slot.dense] = owners.begin()[last];
+            slots.begin()[owners.begin()[slot.dense]].dense = slot.dense;
+        }
+        values.pop_back();
+        owners.pop_back();
+        slot.generation++;
+        slot.dense = free_head;
+        free_head = index;
+    }
+
+
+public:
+    SlotMap() = default;
+    SlotMap(const SlotMap& right) = default;
+    SlotMap(SlotMap&& right) noexcept : values(std::move(right.values)), owners(std::move(right.owners)), slots(std::move(right.slots)), free_head(right.free_head) {
+        right.free_head = NONE;
+    }
+
+    void clear() {
+        while(!values.is_empty()) _erase(owners.begin()[values.get_length() - 1]);
+    }
+
+    size_t get_length() const { return values.get_length(); }
+    // Число ячеек, включая свободные
+    size_t get_capacity() const { return slots.get_length(); }
+    bool is_empty() const { return values.is_empty(); }
+
+    // Счетчики работы плотного массива значений (нулевые без -DSIILIB_STATS)
+    StatsSnapshot get_stats() const { return values.get_stats(); }
+    void reset_stats() { values.reset_stats(); }
+
+    SlotHandle insert(const T& x) { return _insert(x); }
+    SlotHandle insert(T&& x) { return _insert(std::move(x)); }
+
+    void remove(SlotHandle h) {
+        if(!_slot(h)) throw KeyError();
+        _erase(h.index);
+    }
+    // false, если ручка уже недействительна
+    bool try_remove(SlotHandle h) {
+        if(!_slot(h)) return false;
+        _erase(h.index);
+        return true;
+    }
+
+    bool contains(SlotHandle h) const { return _slot(h) != nullptr; }
+
+    T* get(SlotHandle h) {
+        const Slot* slot = _slot(h);
+        return slot ? values.begin() + slot->dense : nullptr;
+    }
+    const T* get(SlotHandle h) const {
+        const Slot* slot = _slot(h);
+        return slot ? values.begin() + slot->dense : nullptr;
+    }
+
+    T& at(SlotHandle h) {
+        T* ptr = get(h);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+    const T& at(SlotHandle h) const {
+        const T* ptr = get(h);
+        if(!ptr) throw KeyError();
+        return *ptr;
+    }
+
+    // Ручка значения на позиции index плотного массива (при обходе)
+    SlotHandle get_handle(size_t index) const {
+        if(index >= values.get_length()) throw IndexError();
+        uint32_t slot = owners.begin()[index];
+        return SlotHandle{slot, slots.begin()[slot].generation};
+    }
+
+    // Плотный массив значений: обход без пропусков
+    T* begin() { return values.begin(); }
+    T* end() { return values.end(); }
+    const T* begin() const { return values.begin(); }
+    const T* end() const { return values.end(); }
+
+    SlotMap& operator=(const SlotMap& right) = default;
+    SlotMap& operator=(SlotMap&& right) noexcept {
+        if(&right == this) return *this;
+        values = std::move(right.values);
+        owners = std::move(right.owners);
+        slots = std::move(right.slots);
+        free_head = right.free_head;
+        right.free_head = NONE;
+        return *this;
+    }
+};
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "Check.hpp"
+#include "Exception.hpp"
+#include "Span.cpp"
+
+
+#define SOAVECTOR_MIN_CAPACITY 8
+#define SOAVECTOR_ALIGNMENT 64
+
+
+namespace siilib {
+// Динамический массив записей, хранящий каждое поле в отдельном непрерывном столбце (structure of arrays).
+// Все столбцы лежат в одном блоке памяти, начало каждого выровнено по SOAVECTOR_ALIGNMENT байт.
+// Рост и уменьшение емкости - как у Vector (множитель resize_factor).
+// Список полей занимает конец списка параметров, поэтому политика проверок (Check.hpp) идет первой:
+// BasicSoAVector<Unchecked, int, double>; SoAVector<int, double> - то же с Checked.
+template <typename CheckPolicy, typename... Fields>
+class BasicSoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    std::tuple<Fields*...> columns;
+    void* block{nullptr};
+    size_t length{0};
+    size_t capacity{0};
+    unsigned resize_factor{2};
+    bool manual_memory{false};
+
+
+    template <typename F, size_t... I>
+    void _each(F&& f, std::index_sequence<I...>) {
+        (f(std::get<I>(columns), std::integral_constant<size_t, I>()), ...);
+    }
+    // Вызывает f(столбец, индекс столбца) для каждого столбца
+    template <typename F>
+    void _each(F&& f) { _each(std::forward<F>(f), std::index_sequence_for<Fields...>()); }
+
+    template <typename T>
+    static void _destroy(T* ptr) { ptr->~T(); }
+
+    static size_t _align(size_t offset) {
+        return (offset + SOAVECTOR_ALIGNMENT - 1) / SOAVECTOR_ALIGNMENT * SOAVECTOR_ALIGNMENT;
+    }
+
+    // Размер блока для столбцов емкостью capacity
+    static size_t _bytes(size_t capacity) {
+        size_t offset = 0;
+        ((offset = _align(offset) + capacity * sizeof(Fields)), ...);
+        return offset;
+    }
+    // Размещает столбцы емкостью capacity в блоке base
+    template <size_t... I>
+    static void _layout(char* base, size_t capacity, std::tuple<Fields*...>& out, std::index_sequence<I...>) {
+        size_t offset = 0;
+        ((offset = _align(offset), std::get<I>(out) = reinterpret_cast<Fields*>(base + offset), offset += capacity * sizeof(Fields)), ...);
+    }
+
+    void _reallocate(size_t new_capacity) {
+        std::tuple<Fields*...> fresh;
+        size_t bytes = _bytes(new_capacity);
+        void* fresh_block;
+        try { fresh_block = ::operator new(bytes ? bytes : 1, std::align_val_t(SOAVECTOR_ALIGNMENT)); }
+        catch(const std::bad_alloc&) { throw ResizeError(); }
+        _layout(static_cast<char*>(fresh_block), new_capacity, fresh, std::index_sequence_for<Fields...>());
+        _each([&](auto* column, auto I) {
+            auto* to = std::get<decltype(I)::value>(fresh);
+            for(size_t i = 0; i < length; ++i) {
+                new(to + i) std::remove_pointer_t<decltype(column)>(std::move(column[i]));
+                _destroy(&column[i]);
+            }
+        });
+        ::operator delete(block, std::align_val_t(SOAVECTOR_ALIGNMENT));
+        block = fresh_block;
+        columns = fresh;
+        capacity = new_capacity;
+    }
+
+    void _inc() {
+        if(length == capacity) _reallocate(capacity ? capacity * resize_factor : SOAVECTOR_MIN_CAPACITY);
+    }
+    void _dec() {
+        if(length < capacity / (resize_factor * 2) && capacity > SOAVECTOR_MIN_CAPACITY && !manual_memory) {
+            _reallocate(capacity / resize_factor);
+        }
+    }
+
+    // Перемещает строку from на место строки to, строка from разрушается
+    void _move_row(size_t to, size_t from) {
+        _each([&](auto* column, auto) {
+            column[to] = std::move(column[from]);
+            _destroy(&column[from]);
+        });
+    }
+
+    std::tuple<Fields...> _take_row(size_t index) {
+        return _take_row(index, std::index_sequence_for<Fields...>());
+    }
+    template <size_t... I>
+    std::tuple<Fields...> _take_row(size_t index, std::index_sequence<I...>) {
+        return std::tuple<Fields...>(std::move(std::get<I>(columns)[index])...);
+    }
+
+    template <size_t... I>
+    std::tuple<Fields&...> _row(size_t index, std::index_sequence<I...>) {
+        return std::tuple<Fields&...>(std::get<I>(columns)[index]...);
+    }
+    template <size_t... I>
+    std::tuple<const Fields&...> _row(size_t index, std::index_sequence<I...>) const {
+        return std::tuple<const Fields&...>(std::get<I>(columns)[index]...);
+    }
+
+    template <size_t... I, typename... Args>
+    void _construct_row(size_t index, std::index_sequence<I...>, Args&&... args) {
+        (new(std::get<I>(columns) + index) Fields(std::forward<Args>(args)), ...);
+    }
+
+    template <size_t... I, typename Tuple>
+    void _construct_row_from(size_t index, std::index_sequence<I...> seq, Tuple&& row) {
+        _construct_row(index, seq, std::get<I>(std::forward<Tuple>(row))...);
+    }
+
+    size_t _check(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        return index;
+    }
+
+
+public:
+    // Строка - кортеж ссылок на поля: std::get<I>(row), структурные привязки, присваивание кортежа
+    using Row = std::tuple<Fields&...>;
+    using ConstRow = std::tuple<const Fields&...>;
+    using Value = std::tuple<Fields...>;
+
+    template <size_t I>
+    using Field = std::tuple_element_t<I, Value>;
+
+    BasicSoAVector(size_t capacity=SOAVECTOR_MIN_CAPACITY, unsigned resize_factor=2) : resize_factor(resize_factor < 2 ? 2 : resize_factor), manual_memory(capacity != SOAVECTOR_MIN_CAPACITY) {
+        try { _reallocate(capacity ? capacity : 1); }
+        catch(const ResizeError&) { throw AllocError(); }
+    }
+    BasicSoAVector(const BasicSoAVector& right) : BasicSoAVector(right.capacity, right.resize_factor) {
+        manual_memory = right.manual_memory;
+        for(size_t i = 0; i < right.length; ++i) push_back(right._row(i, std::index_sequence_for<Fields...>()));
+    }
+    BasicSoAVector(BasicSoAVector&& right) noexcept {
+        *this = std::move(right);
+    }
+    ~BasicSoAVector() {
+        clear();
+        ::operator delete(block, std::align_val_t(SOAVECTOR_ALIGNMENT));
+    }
+
+    BasicSoAVector& operator=(const BasicSoAVector& right) {
+        if(this == &right) return *this;
+        BasicSoAVector tmp(right);
+        return *this = std::move(tmp);
+    }
+    BasicSoAVector& operator=(BasicSoAVector&& right) noexcept {
+        if(this == &right) return *this;
+        clear();
+        ::operator delete(block, std::align_val_t(SOAVECTOR_ALIGNMENT));
+        columns = right.columns;
+        block = right.block;
+        length = right.length;
+        capacity = right.capacity;
+        resize_factor = right.resize_factor;
+        manual_memory = right.manual_memory;
+        right.block = nullptr;
+        right.columns = std::tuple<Fields*...>();
+        right.length = right.capacity = 0;
+        return *this;
+    }
+
+    void clear() {
+        _each([&](auto* column, auto) {
+            for(size_t i = 0; i < length; ++i) _destroy(&column[i]);
+        });
+        length = 0;
+        manual_memory = false;
+    }
+
+    // Емкость не меньше len; при manual_memory емкость больше не уменьшается автоматически
+    void resize(size_t len, bool manual_memory=true) {
+        if(manual_memory) this->manual_memory = true;
+        if(len < length) len = length;
+        _reallocate(len > SOAVECTOR_MIN_CAPACITY ? len : SOAVECTOR_MIN_CAPACITY);
+    }
+
+    void set_resize_factor(unsigned resize_factor) { this->resize_factor = resize_factor < 2 ? 2 : resize_factor; }
+
+    size_t get_capacity() const { return capacity; }
+    size_t get_length() const { return length; }
+    size_t get_size() const { return (sizeof(Fields) + ...) * capacity; }
+    size_t get_resize_factor() const { return resize_factor; }
+    bool is_empty() const { return length == 0; }
+
+    Row push_back(const Value& row) {
+        _inc();
+        _construct_row_from(length, std::index_sequence_for<Fields...>(), row);
+        return (*this)[static_cast<int>(length++)];
+    }
+    Row push_back(Value&& row) {
+        _inc();
+        _construct_row_from(length, std::index_sequence_for<Fields...>(), std::move(row));
+        return (*this)[static_cast<int>(length++)];
+    }
+    // Каждый аргумент передается конструктору своего поля
+    template <typename... Args>
+    Row emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back needs one argument per field");
+        _inc();
+        _construct_row(length, std::index_sequence_for<Fields...>(), std::forward<Args>(args)...);
+        return (*this)[static_cast<int>(length++)];
+    }
+
+    Value pop_back() {
+        _require<CheckPolicy, EmptyError>(length != 0);
+        return *try_pop_back();
+    }
+    std::optional<Value> try_pop_back() {
+        if(length == 0) return std::nullopt;
+        Value row = _take_row(--length);
+        _each([&](auto* column, auto) { _destroy(&column[length]); });
+        _dec();
+        return row;
+    }
+
+    // Удаление за O(1): на место строки index переносится последняя строка, порядок строк не сохраняется
+    Value swap_erase(int index) {
+        size_t pos = _check(index);
+        Value row = _take_row(pos);
+        if(pos != --length) _move_row(pos, length);
+        else _each([&](auto* column, auto) { _destroy(&column[length]); });
+        _dec();
+        return row;
+    }
+    // Удаление со сдвигом всех следующих строк, порядок сохраняется
+    Value erase(int index) {
+        size_t pos = _check(index);
+        Value row = _take_row(pos);
+        _each([&](auto* column, auto) {
+            for(size_t i = pos; i + 1 < length; ++i) column[i] = std::move(column[i + 1]);
+            _destroy(&column[length - 1]);
+        });
+        length--;
+        _dec();
+        return row;
+    }
+
+    Row operator[](int index) { return _row(_check(index), std::index_sequence_for<Fields...>()); }
+    ConstRow operator[](int index) const { return _row(_check(index), std::index_sequence_for<Fields...>()); }
+
+    Row front() { _require<CheckPolicy, EmptyError>(length != 0); return (*this)[0]; }
+    ConstRow front() const { _require<CheckPolicy, EmptyError>(length != 0); return (*this)[0]; }
+    Row back() { _require<CheckPolicy, EmptyError>(length != 0); return (*this)[-1]; }
+    ConstRow back() const { _require<CheckPolicy, EmptyError>(length != 0); return (*this)[-1]; }
+
+    // Столбец поля I как непрерывное представление (действительно до следующего изменения емкости)
+    template <size_t I>
+    Span<Field<I>, CheckPolicy> column() { return Span<Field<I>, CheckPolicy>(std::get<I>(columns), length); }
+    template <size_t I>
+    ConstSpan<Field<I>, CheckPolicy> column() const { return ConstSpan<Field<I>, CheckPolicy>(std::get<I>(columns), length); }
+};
+
+template <typename... Fields>
+using SoAVector = BasicSoAVector<Checked, Fields...>;
+}
@@ -0,0 +1,453 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "Exception.hpp"
+
+
+#define SORT_INSERTION_THRESHOLD 24
+#define SORT_NINTHER_THRESHOLD 128
+#define SORT_PARTIAL_INSERTION_LIMIT 8
+#define SORT_RADIX_THRESHOLD 1024
+
+
+namespace siilib {
+
+template <typename T>
+void _swap(T* a, T* b) {
+    T tmp = std::move(*a);
+    *a = std::move(*b);
+    *b = std::move(tmp);
+}
+
+template <typename T, typename Compare>
+void _insertion_sort(T* begin, T* end, Compare& comp) {
+    if(begin == end) return;
+    for(T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if(comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); }
+            while(sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Слева от begin должен находиться элемент не больше любого из [begin, end)
+template <typename T, typename Compare>
+void _unguarded_insertion_sort(T* begin, T* end, Compare& comp) {
+    if(begin == end) return;
+    for(T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if(comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); }
+            while(comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Сортировка вставками, прерываемая после SORT_PARTIAL_INSERTION_LIMIT перемещений
+template <typename T, typename Compare>
+bool _partial_insertion_sort(T* begin, T* end, Compare& comp) {
+    if(begin == end) return true;
+    size_t limit = 0;
+    for(T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if(comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); }
+            while(sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            limit += cur - sift;
+        }
+        if(limit > SORT_PARTIAL_INSERTION_LIMIT) return false;
+    }
+    return true;
+}
+
+template <typename T, typename Compare>
+void _sort2(T* a, T* b, Compare& comp) {
+    if(comp(*b, *a)) _swap(a, b);
+}
+
+template <typename T, typename Compare>
+void _sort3(T* a, T* b, T* c, Compare& comp) {
+    _sort2(a, b, comp);
+    _sort2(b, c, comp);
+    _sort2(a, b, comp);
+}
+
+template <typename T, typename Compare>
+void _sift_down(T* begin, size_t len, size_t i, Compare& comp) {
+    T tmp = std::move(begin[i]);
+    while(2 * i + 1 < len) {
+        size_t child = 2 * i + 1;
+        if(child + 1 < len && comp(begin[child], begin[child + 1])) child++;
+        if(!comp(tmp, begin[child])) break;
+        begin[i] = std::move(begin[child]);
+        i = child;
+    }
+    begin[i] = std::move(tmp);
+}
+
+template <typename T, typename Compare>
+void _make_heap(T* begin, size_t len, Compare& comp) {
+    for(size_t i = len / 2; i > 0; --i) _sift_down(begin, len, i - 1, comp);
+}
+
+template <typename T, typename Compare>
+void _sort_heap(T* begin, size_t len, Compare& comp) {
+    for(size_t i = len; i > 1; --i) {
+        _swap(begin, begin + i - 1);
+        _sift_down(begin, i - 1, 0, comp);
+    }
+}
+
+template <typename T, typename Compare>
+void _heap_sort(T* begin, T* end, Compare& comp) {
+    _make_heap(begin, end - begin, comp);
+    _sort_heap(begin, end - begin, comp);
+}
+
+// Разбиение с элементами, равными опорному, справа. Возвращает позицию опорного элемента и
+// признак того, что диапазон уже был разбит (ни одной перестановки)
+template <typename T, typename Compare>
+std::pair<T*, bool> _partition_right(T* begin, T* end, Compare& comp) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+    while(comp(*++first, pivot));
+    if(first - 1 == begin) while(first < last && !comp(*--last, pivot));
+    else while(!comp(*--last, pivot));
+    bool already_partitioned = first >= last;
+    while(first < last) {
+        _swap(first, last);
+        while(comp(*++first, pivot));
+        while(!comp(*--last, pivot));
+    }
+    T* pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return {pivot_pos, already_partitioned};
+}
+
+// Разбиение с элементами, равными опорному, слева (используется для большого числа повторов)
+template <typename T, typename Compare>
+T* _partition_left(T* begin, T* end, Compare& comp) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+    while(comp(pivot, *--last));
+    if(last + 1 == end) while(first < last && !comp(pivot, *++first));
+    else while(!comp(pivot, *++first));
+    while(first < last) {
+        _swap(first, last);
+        while(comp(pivot, *--last));
+        while(!comp(pivot, *++first));
+    }
+    T* pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+// Pattern-defeating quicksort (O. Peters): медиана трех/девяти, обнаружение уже упорядоченных
+// участков, отдельная обработка повторов и переход на пирамидальную сортировку при плохих разбиениях
+template <typename T, typename Compare>
+void _pdqsort(T* begin, T* end, Compare& comp, int bad_allowed, bool leftmost) {
+    while(true) {
+        ptrdiff_t size = end - begin;
+        if(size < SORT_INSERTION_THRESHOLD) {
+            if(leftmost) _insertion_sort(begin, end, comp);
+            else _unguarded_insertion_sort(begin, end, comp);
+            return;
+        }
+
+        ptrdiff_t s2 = size / 2;
+        if(size > SORT_NINTHER_THRESHOLD) {
+            _sort3(begin, begin + s2, end - 1, comp);
+            _sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            _sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            _sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            _swap(begin, begin + s2);
+        }
+        else _sort3(begin + s2, begin, end - 1, comp);
+
+        if(!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = _partition_left(begin, end, comp) + 1;
+            continue;
+        }
+
+        std::pair<T*, bool> part = _partition_right(begin, end, comp);
+        T* pivot_pos = part.first;
+        ptrdiff_t l_size = pivot_pos - begin;
+        ptrdiff_t r_size = end - (pivot_pos + 1);
+
+        if(l_size < size / 8 || r_size < size / 8) {
+            if(--bad_allowed == 0) {
+                _heap_sort(begin, end, comp);
+                return;
+            }
+            if(l_size >= SORT_INSERTION_THRESHOLD) {
+                _swap(begin, begin + l_size / 4);
+                _swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if(l_size > SORT_NINTHER_THRESHOLD) {
+                    _swap(begin + 1, begin + (l_size / 4 + 1));
+                    _swap(begin + 2, begin + (l_size / 4 + 2));
+                    _swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    _swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if(r_size >= SORT_INSERTION_THRESHOLD) {
+                _swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                _swap(end - 1, end - r_size / 4);
+                if(r_size > SORT_NINTHER_THRESHOLD) {
+                    _swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    _swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    _swap(end - 2, end - (1 + r_size / 4));
+                    _swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        }
+        else if(part.second && _partial_insertion_sort(begin, pivot_pos, comp)
+                && _partial_insertion_sort(pivot_pos + 1, end, comp)) return;
+
+        _pdqsort(begin, pivot_pos, comp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template <typename T, typename Compare>
+void _merge(T* begin, T* mid, T* end, T* buf, Compare& comp) {
+    if(!comp(*mid, *(mid - 1))) return;
+    size_t left = mid - begin;
+    for(size_t i = 0; i < left; ++i) buf[i] = std::move(begin[i]);
+    T* a = buf;
+    T* a_end = buf + left;
+    T* b = mid;
+    T* out = begin;
+    while(a != a_end && b != end) {
+        if(comp(*b, *a)) *out++ = std::move(*b++);
+        else *out++ = std::move(*a++);
+    }
+    while(a != a_end) *out++ = std::move(*a++);
+}
+
+
+// Ключи сортируются как беззнаковые целые: для знаковых инвертируется знаковый бит,
+// для чисел с плавающей точкой - знаковый бит у положительных и все биты у отрицательных
+template <typename K>
+auto _radix_key(K key) {
+    static_assert(std::is_arithmetic<K>::value, "radix sort requires arithmetic keys");
+    if constexpr(std::is_floating_point<K>::value) {
+        using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+        U bits;
+        std::memcpy(&bits, &key, sizeof(K));
+        U sign = U(1) << (sizeof(K) * 8 - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+    }
+    else {
+        using U = std::make_unsigned_t<std::conditional_t<std::is_same<K, bool>::value, unsigned char, K>>;
+        U bits = static_cast<U>(key);
+        if constexpr(std::is_signed<K>::value) bits ^= U(1) << (sizeof(K) * 8 - 1);
+        return bits;
+    }
+}
+
+// LSD поразрядная сортировка по байтам. values может быть nullptr; если нет, значения
+// переставляются вместе с ключами. Проходы, в которых все ключи имеют одинаковый байт, пропускаются
+template <typename K, typename V>
+void _radix_sort(K* keys, V* values, size_t len) {
+    constexpr size_t PASSES = sizeof(K);
+    if(len < 2) return;
+    size_t counts[PASSES][256] = {};
+    for(size_t i = 0; i < len; ++i) {
+        auto key = _radix_key(keys[i]);
+        for(size_t p = 0; p < PASSES; ++p) counts[p][(key >> (p * 8)) & 0xFF]++;
+    }
+    K* key_buf = nullptr;
+    V* value_buf = nullptr;
+    try {
+        key_buf = new K[len];
+        if(values) value_buf = new V[len];
+    }
+    catch(std::bad_alloc&) {
+        delete[] key_buf;
+        throw AllocError();
+    }
+    K* src_keys = keys;
+    K* dst_keys = key_buf;
+    V* src_values = values;
+    V* dst_values = value_buf;
+    for(size_t p = 0; p < PASSES; ++p) {
+        size_t* count = counts[p];
+        if(count[(_radix_key(src_keys[0]) >> (p * 8)) & 0xFF] == len) continue;
+        size_t offsets[256];
+        size_t sum = 0;
+        for(size_t b = 0; b < 256; ++b) {
+            offsets[b] = sum;
+            sum += count[b];
+        }
+        for(size_t i = 0; i < len; ++i) {
+            size_t pos = offsets[(_radix_key(src_keys[i]) >> (p * 8)) & 0xFF]++;
+            dst_keys[pos] = std::move(src_keys[i]);
+            if(values) dst_values[pos] = std::move(src_values[i]);
+        }
+        std::swap(src_keys, dst_keys);
+        std::swap(src_values, dst_values);
+    }
+    if(src_keys != keys) {
+        for(size_t i = 0; i < len; ++i) keys[i] = std::move(src_keys[i]);
+        if(values) for(size_t i = 0; i < len; ++i) values[i] = std::move(src_values[i]);
+    }
+    delete[] key_buf;
+    delete[] value_buf;
+}
+
+template <typename T, typename Compare>
+constexpr bool _use_radix() {
+    return std::is_arithmetic<T>::value && std::is_same<Compare, std::less<T>>::value;
+}
+
+
+template <typename K>
+void radix_sort(K* begin, K* end) {
+    _radix_sort(begin, static_cast<char*>(nullptr), end - begin);
+}
+
+// Сортирует пары (keys[i], values[i]) по ключу, устойчиво
+template <typename K, typename V>
+void radix_sort(K* keys, V* values, size_t len) {
+    _radix_sort(keys, values, len);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void sort(T* begin, T* end, Compare comp = Compare()) {
+    if constexpr(_use_radix<T, Compare>()) {
+        if(end - begin >= SORT_RADIX_THRESHOLD) return radix_sort(begin, end);
+    }
+    size_t len = end - begin;
+    int log2 = 0;
+    while(len >>= 1) log2++;
+    _pdqsort(begin, end, comp, log2 + 1, true);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void stable_sort(T* begin, T* end, Compare comp = Compare()) {
+    constexpr size_t RUN = 32;
+    size_t len = end - begin;
+    // Только целые: поразрядная сортировка чисел с плавающей точкой ставит все -0.0 перед +0.0,
+    // а для std::less они равны и должны сохранить исходный порядок
+    if constexpr(_use_radix<T, Compare>() && std::is_integral<T>::value) {
+        if(len >= SORT_RADIX_THRESHOLD) return radix_sort(begin, end);
+    }
+    for(size_t i = 0; i < len; i += RUN) _insertion_sort(begin + i, begin + (i + RUN < len ? i + RUN : len), comp);
+    if(len <= RUN) return;
+    T* buf;
+    try { buf = new T[len]; }
+    catch(std::bad_alloc&) { throw AllocError(); }
+    for(size_t width = RUN; width < len; width *= 2) {
+        for(size_t i = 0; i + width < len; i += 2 * width) {
+            _merge(begin + i, begin + i + width, begin + (i + 2 * width < len ? i + 2 * width : len), buf, comp);
+        }
+    }
+    delete[] buf;
+}
+
+// Упорядочивает [begin, middle) так, что там оказываются наименьшие элементы всего диапазона
+template <typename T, typename Compare = std::less<T>>
+void partial_sort(T* begin, T* middle, T* end, Compare comp = Compare()) {
+    size_t k = middle - begin;
+    if(k == 0) return;
+    _make_heap(begin, k, comp);
+    for(T* i = middle; i < end; ++i) {
+        if(comp(*i, *begin)) {
+            _swap(i, begin);
+            _sift_down(begin, k, 0, comp);
+        }
+    }
+    _sort_heap(begin, k, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+bool is_sorted(T* begin, T* end, Compare comp = Compare()) {
+    for(T* i = begin + 1; i < end; ++i) {
+        if(comp(*i, *(i - 1))) return false;
+    }
+    return true;
+}
+
+// Бинарный поиск без ветвлений: на каждом шаге граница сдвигается условной пересылкой,
+// поэтому время поиска не зависит от предсказания переходов
+template <typename T, typename Compare = std::less<T>>
+T* lower_bound(T* begin, T* end, const std::remove_const_t<T>& key, Compare comp = Compare()) {
+    size_t len = end - begin;
+    if(len == 0) return begin;
+    T* base = begin;
+    while(len > 1) {
+        size_t half = len / 2;
+        base = comp(base[half - 1], key) ? base + half : base;
+        len -= half;
+    }
+    return base + comp(*base, key);
+}
+
+template <typename T, typename Compare = std::less<T>>
+T* upper_bound(T* begin, T* end, const std::remove_const_t<T>& key, Compare comp = Compare()) {
+    size_t len = end - begin;
+    if(len == 0) return begin;
+    T* base = begin;
+    while(len > 1) {
+        size_t half = len / 2;
+        base = !comp(key, base[half - 1]) ? base + half : base;
+        len -= half;
+    }
+    return base + !comp(key, *base);
+}
+
+
+// Перегрузки для контейнеров с непрерывным хранением (Vector, Array)
+template <typename Container, typename Compare = std::less<std::remove_reference_t<decltype(*std::declval<Container&>().begin())>>>
+void sort(Container& c, Compare comp = Compare()) {
+    sort(c.begin(), c.end(), comp);
+}
+
+template <typename Container, typename Compare = std::less<std::remove_reference_t<decltype(*std::declval<Container&>().begin())>>>
+void stable_sort(Container& c, Compare comp = Compare()) {
+    stable_sort(c.begin(), c.end(), comp);
+}
+
+template <typename Container, typename Compare = std::less<std::remove_reference_t<decltype(*std::declval<Container&>().begin())>>>
+void partial_sort(Container& c, size_t k, Compare comp = Compare()) {
+    if(k > c.get_length()) throw IndexError();
+    partial_sort(c.begin(), c.begin() + k, c.end(), comp);
+}
+
+template <typename Container, typename Compare = std::less<std::remove_reference_t<decltype(*std::declval<const Container&>().begin())>>>
+bool is_sorted(const Container& c, Compare comp = Compare()) {
+    return is_sorted(c.begin(), c.end(), comp);
+}
+
+template <typename Container>
+void radix_sort(Container& c) {
+    radix_sort(c.begin(), c.end());
+}
+
+template <typename KeyContainer, typename ValueContainer>
+void radix_sort(KeyContainer& keys, ValueContainer& values) {
+    if(keys.get_length() != values.get_length()) throw ValueError();
+    radix_sort(keys.begin(), values.begin(), keys.get_length());
+}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+
+#include "Exception.hpp"
+#include "Sort.cpp"
+#include "Vector.cpp"
+
+
+namespace siilib {
+// Упорядоченный динамический массив. При Unique = true повторяющиеся элементы не хранятся (см. FlatSet).
+// CheckPolicy - проверки индексов и пустоты внутреннего Vector (Check.hpp).
+template <typename T, typename Compare = std::less<T>, bool Unique = false, typename CheckPolicy = Checked>
+class SortedVector {
+    using Data = Vector<T, HeapStorage, CheckPolicy>;
+
+    Data data;
+    Compare comp;
+
+
+    template <typename V>
+    void _dedup(V& v) const {
+        if(!Unique || v.get_length() < 2) return;
+        T* ptr = v.begin();
+        size_t len = v.get_length();
+        size_t res = 1;
+        for(size_t i = 1; i < len; ++i) {
+            if(comp(ptr[res - 1], ptr[i])) ptr[res++] = std::move(ptr[i]);
+        }
+        while(v.get_length() > res) v.pop_back();
+    }
+
+    // Сливает отсортированную пачку [begin, end) с данными за один проход с конца массива
+    void _merge(const T* begin, const T* end) {
+        size_t old_len = data.get_length();
+        size_t add = end - begin;
+        if(Unique) {
+            add = 0;
+            const T* a = data.begin();
+            const T* a_end = data.end();
+            for(const T* b = begin; b != end; ++b) {
+                while(a != a_end && comp(*a, *b)) ++a;
+                if(a == a_end || comp(*b, *a)) add++;
+            }
+        }
+        if(add == 0) return;
+        for(size_t i = 0; i < add; ++i) data.push_back(T());
+        T* ptr = data.begin();
+        size_t i = old_len;
+        size_t out = old_len + add;
+        const T* b = end;
+        while(b != begin) {
+            if(i > 0 && comp(*(b - 1), ptr[i - 1])) ptr[--out] = std::move(ptr[--i]);
+            else if(Unique && i > 0 && !comp(ptr[i - 1], *(b - 1))) --b;
+            else ptr[--out] = *--b;
+        }
+    }
+
+
+public:
+    static constexpr int npos = -1;
+
+    SortedVector(const Compare& comp=Compare()) : comp(comp) { }
+    SortedVector(const T* ar, size_t len, const Compare& comp=Compare()) : comp(comp) {
+        for(size_t i = 0; i < len; ++i) data.push_back(ar[i]);
+        sort(data, this->comp);
+        _dedup(data);
+    }
+    SortedVector(const Data& ar, const Compare& comp=Compare()) : data(ar), comp(comp) {
+        sort(data, this->comp);
+        _dedup(data);
+    }
+    SortedVector(Data&& ar, const Compare& comp=Compare()) : data(std::move(ar)), comp(comp) {
+        sort(data, this->comp);
+        _dedup(data);
+    }
+    SortedVector(std::initializer_list<T> ar, const Compare& comp=Compare()) : data(ar), comp(comp) {
+        sort(data, this->comp);
+        _dedup(data);
+    }
+
+    void clear() { data.clear(); }
+
+    bool is_empty() const { return data.is_empty(); }
+
+    size_t get_length() const { return data.get_length(); }
+    size_t get_capacity() const { return data.get_capacity(); }
+
+    // Индекс вставленного элемента (для Unique - индекс уже существующего равного элемента)
+    int insert(const T& x) {
+        size_t pos = Unique ? lower_bound(x) : upper_bound(x);
+        if(Unique && pos < data.get_length() && !comp(x, data.begin()[pos])) return pos;
+        data.insert(static_cast<int>(pos), x);
+        return pos;
+    }
+    int insert(T&& x) {
+        size_t pos = Unique ? lower_bound(x) : upper_bound(x);
+        if(Unique && pos < data.get_length() && !comp(x, data.begin()[pos])) return pos;
+        data.insert(static_cast<int>(pos), std::move(x));
+        return pos;
+    }
+    // Пакетная вставка: пачка сортируется и сливается с данными за O(n + m log m) вместо m сдвигов
+    void insert(const T* ar, size_t len) {
+        Vector<T> batch;
+        for(size_t i = 0; i < len; ++i) batch.push_back(ar[i]);
+        sort(batch, comp);
+        _dedup(batch);
+        _merge(batch.begin(), batch.end());
+    }
+    void insert(const Vector<T>& ar) {
+        insert(ar.begin(), ar.get_length());
+    }
+
+    T erase(int index) { return data.erase(index); }
+
+    void remove(const T& key) {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        data.erase(index);
+    }
+    bool try_remove(const T& key) {
+        int index = try_find(key);
+        if(index == npos) return false;
+        data.erase(index);
+        return true;
+    }
+
+    size_t lower_bound(const T& key) const { return siilib::lower_bound(data.begin(), data.end(), key, comp) - data.begin(); }
+    size_t upper_bound(const T& key) const { return siilib::upper_bound(data.begin(), data.end(), key, comp) - data.begin(); }
+
+    int find(const T& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const T& key) const {
+        size_t pos = lower_bound(key);
+        if(pos == data.get_length() || comp(key, data.begin()[pos])) return npos;
+        return pos;
+    }
+    bool contains(const T& key) const { return try_find(key) != npos; }
+    size_t count(const T& key) const { return upper_bound(key) - lower_bound(key); }
+
+    const T& operator[](int index) const { return data[index]; }
+    const T* get(int index) const { return data.get(index); }
+
+    const T& front() const { return data.front(); }
+    const T& back() const { return data.back(); }
+
+    const T* begin() const { return data.begin(); }
+    const T* end() const { return data.end(); }
+
+    const Data& get_vector() const { return data; }
+};
+}
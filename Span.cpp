@@ -0,0 +1,150 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+
+#include "Check.hpp"
+#include "Exception.hpp"
+#include "Find.hpp"
+
+
+namespace siilib {
+// Невладеющее представление последовательности элементов с постоянным шагом (шаг может быть отрицательным).
+// Ничего не копирует: данные должны жить дольше представления, а перераспределение памяти
+// владельцем (например, push_back в Vector) делает представление недействительным.
+// CheckPolicy - проверки индексов и пустоты в operator[], front и back (Check.hpp); срезы проверяют всегда.
+template <typename T, typename CheckPolicy = Checked>
+class Span {
+    T* data{nullptr};
+    size_t length{0};
+    ptrdiff_t step{1};
+
+
+    int _index(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        return index;
+    }
+
+
+public:
+    static constexpr int npos = -1;
+
+    class Iterator {
+        T* data;
+        ptrdiff_t step;
+        ptrdiff_t index;
+    public:
+        Iterator(T* data, ptrdiff_t step, ptrdiff_t index) : data(data), step(step), index(index) { }
+        T& operator*() const { return data[index * step]; }
+        T* operator->() const { return data + index * step; }
+        Iterator& operator++() { ++index; return *this; }
+        bool operator==(const Iterator& right) const { return index == right.index; }
+        bool operator!=(const Iterator& right) const { return index != right.index; }
+    };
+
+    Span() = default;
+    Span(T* data, size_t length, ptrdiff_t step=1) : data(data), length(length), step(step) { }
+    template <size_t N>
+    Span(T (&ar)[N]) : data(ar), length(N) { }
+    // Любой контейнер с непрерывным хранением: Vector, Array, SortedVector и т.п.
+    template <typename Container, typename = decltype(std::declval<Container&>().get_length()),
+              typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container&>().begin()), T*>>>
+    Span(Container& c) : data(c.begin()), length(c.get_length()) { }
+    // Span<T> неявно приводится к Span<const T>, в том числе с другой политикой проверок
+    template <typename U, typename P, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    Span(const Span<U, P>& right) : data(right.get_data()), length(right.get_length()), step(right.get_step()) { }
+
+    size_t get_length() const { return length; }
+    size_t get_size() const { return length * sizeof(T); }
+    ptrdiff_t get_step() const { return step; }
+    bool is_empty() const { return length == 0; }
+    // Элементы идут подряд: можно передавать get_data() как обычный массив
+    bool is_contiguous() const { return step == 1 || length < 2; }
+    T* get_data() const { return data; }
+
+    T& operator[](int index) const { return data[_index(index) * step]; }
+    T* get(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return data + index * step;
+    }
+    T& front() const { _require<CheckPolicy, EmptyError>(length != 0); return data[0]; }
+    T& back() const { _require<CheckPolicy, EmptyError>(length != 0); return data[(static_cast<ptrdiff_t>(length) - 1) * step]; }
+
+    Iterator begin() const { return Iterator(data, step, 0); }
+    Iterator end() const { return Iterator(data, step, length); }
+
+    // Срез в стиле Python: [begin:end:step]. Отрицательные границы отсчитываются с конца,
+    // выходящие за пределы границы обрезаются, шаг 0 - ValueError.
+    Span slice(int begin, int end, int step=1) const {
+        if(step == 0) throw ValueError();
+        int len = static_cast<int>(length);
+        if(begin < 0) begin += len;
+        if(end < 0) end += len;
+        int lo = step > 0 ? 0 : -1;
+        int hi = step > 0 ? len : len - 1;
+        begin = begin < lo ? lo : (begin > hi ? hi : begin);
+        end = end < lo ? lo : (end > hi ? hi : end);
+        size_t count = 0;
+        if(step > 0 && end > begin) count = (end - begin + step - 1) / step;
+        if(step < 0 && begin > end) count = (begin - end - step - 1) / -step;
+        return Span(count ? data + begin * this->step : data, count, this->step * step);
+    }
+    // Срез от begin до конца
+    Span slice(int begin) const { return slice(begin, static_cast<int>(length)); }
+    // Элементы в обратном порядке
+    Span reversed() const { return slice(-1, -static_cast<int>(length) - 1, -1); }
+
+    // count элементов начиная с offset; выход за границы - IndexError
+    Span subspan(size_t offset, size_t count) const {
+        if(offset > length || count > length - offset) throw IndexError();
+        return Span(data + static_cast<ptrdiff_t>(offset) * step, count, step);
+    }
+    Span first(size_t count) const { return subspan(0, count); }
+    Span last(size_t count) const {
+        if(count > length) throw IndexError();
+        return subspan(length - count, count);
+    }
+
+    int find(const std::remove_const_t<T>& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int rfind(const std::remove_const_t<T>& key) const {
+        int index = try_rfind(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    // Для непрерывных представлений используется тот же поиск, что и в Vector и Array
+    int try_find(const std::remove_const_t<T>& key) const {
+        if(is_contiguous()) {
+            const T* pos = _find<std::remove_const_t<T>>(data, data + length, key);
+            return pos == data + length ? npos : static_cast<int>(pos - data);
+        }
+        for(size_t i = 0; i < length; ++i) {
+            if(data[static_cast<ptrdiff_t>(i) * step] == key) return i;
+        }
+        return npos;
+    }
+    int try_rfind(const std::remove_const_t<T>& key) const {
+        if(is_contiguous()) {
+            const T* pos = _rfind<std::remove_const_t<T>>(data, data + length, key);
+            return pos == data + length ? npos : static_cast<int>(pos - data);
+        }
+        for(int i = static_cast<int>(length) - 1; i >= 0; --i) {
+            if(data[i * step] == key) return i;
+        }
+        return npos;
+    }
+    bool contains(const std::remove_const_t<T>& key) const { return try_find(key) != npos; }
+};
+
+template <typename T, typename CheckPolicy = Checked>
+using ConstSpan = Span<const T, CheckPolicy>;
+
+template <typename Container>
+auto make_span(Container& c) { return Span<std::remove_reference_t<decltype(*c.begin())>>(c); }
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "Check.hpp"
+#include "Exception.hpp"
+#include "Span.cpp"
+
+
+#define STABLEVECTOR_FIRST_BLOCK 16
+#define STABLEVECTOR_MAX_BLOCKS 48
+
+
+namespace siilib {
+// Динамический массив из блоков размером STABLEVECTOR_FIRST_BLOCK, 2 * STABLEVECTOR_FIRST_BLOCK, 4 * ...
+// Блоки никогда не перемещаются, поэтому ссылки и указатели на элементы остаются действительными
+// до удаления самого элемента. Номер блока и смещение в нем вычисляются по индексу за O(1).
+// CheckPolicy - проверки индексов и пустоты (Check.hpp)
+template <typename T, typename CheckPolicy = Checked>
+class StableVector {
+    static_assert((STABLEVECTOR_FIRST_BLOCK & (STABLEVECTOR_FIRST_BLOCK - 1)) == 0, "STABLEVECTOR_FIRST_BLOCK must be a power of two");
+
+    T* blocks[STABLEVECTOR_MAX_BLOCKS]{};
+    size_t block_count{0};
+    size_t length{0};
+
+
+    static constexpr int FIRST_SHIFT = __builtin_ctzll(STABLEVECTOR_FIRST_BLOCK);
+
+    static size_t _block_size(size_t block) { return size_t(STABLEVECTOR_FIRST_BLOCK) << block; }
+    static size_t _block_start(size_t block) { return _block_size(block) - STABLEVECTOR_FIRST_BLOCK; }
+    static size_t _block_of(size_t index) {
+        return 63 - __builtin_clzll(index + STABLEVECTOR_FIRST_BLOCK) - FIRST_SHIFT;
+    }
+
+    T& _at(size_t index) const {
+        size_t block = _block_of(index);
+        return blocks[block][index - _block_start(block)];
+    }
+
+    size_t _check(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
+        return index;
+    }
+
+    void _inc() {
+        if(length < _block_start(block_count)) return;
+        if(block_count == STABLEVECTOR_MAX_BLOCKS) throw OverflowError();
+        try { blocks[block_count] = new T[_block_size(block_count)]; }
+        catch(const std::bad_alloc&) { throw ResizeError(); }
+        block_count++;
+    }
+    // Освобождает блоки, кроме одного пустого запасного
+    void _dec() {
+        while(block_count > _block_of(length) + 2) {
+            delete[] blocks[--block_count];
+            blocks[block_count] = nullptr;
+        }
+    }
+
+    template <typename U>
+    T& _push_back(U&& x) {
+        _inc();
+        T& slot = _at(length);
+        slot = std::forward<U>(x);
+        length++;
+        return slot;
+    }
+
+
+public:
+    static constexpr int npos = -1;
+
+    // Последовательный обход без пересчета номера блока на каждом шаге
+    template <typename U>
+    class Iterator {
+        U* const* blocks;
+        size_t index;
+        size_t block;
+        U* ptr;
+        U* block_end;
+    public:
+        Iterator(U* const* blocks, size_t index) : blocks(blocks), index(index), block(0), ptr(blocks[0]), block_end(nullptr) {
+            if(ptr) block_end = ptr + _block_size(0);
+        }
+        U& operator*() const { return *ptr; }
+        U* operator->() const { return ptr; }
+        Iterator& operator++() {
+            ++index;
+            if(++ptr == block_end && block + 1 < STABLEVECTOR_MAX_BLOCKS && blocks[block + 1]) {
+                ptr = blocks[++block];
+                block_end = ptr + _block_size(block);
+            }
+            return *this;
+        }
+        bool operator==(const Iterator& right) const { return index == right.index; }
+        bool operator!=(const Iterator& right) const { return index != right.index; }
+    };
+
+    StableVector() = default;
+    StableVector(std::initializer_list<T> ar) {
+        for(const T& x : ar) push_back(x);
+    }
+    StableVector(const StableVector& right) {
+        for(size_t i = 0; i < right.length; ++i) push_back(right._at(i));
+    }
+    StableVector(StableVector&& right) noexcept {
+        *this = std::move(right);
+    }
+    ~StableVector() {
+        for(size_t i = 0; i < block_count; ++i) delete[] blocks[i];
+    }
+
+    StableVector& operator=(const StableVector& right) {
+        if(this == &right) return *this;
+        clear();
+        for(size_t i = 0; i < right.length; ++i) push_back(right._at(i));
+        return *this;
+    }
+    StableVector& operator=(StableVector&& right) noexcept {
+        if(this == &right) return *this;
+        for(size_t i = 0; i < block_count; ++i) delete[] blocks[i];
+        for(size_t i = 0; i < STABLEVECTOR_MAX_BLOCKS; ++i) {
+            blocks[i] = right.blocks[i];
+            right.blocks[i] = nullptr;
+        }
+        block_count = right.block_count;
+        length = right.length;
+        right.block_count = 0;
+        right.length = 0;
+        return *this;
+    }
+
+    void clear() {
+        for(size_t i = 0; i < block_count; ++i) delete[] blocks[i];
+        for(size_t i = 0; i < block_count; ++i) blocks[i] = nullptr;
+        block_count = 0;
+        length = 0;
+    }
+
+    size_t get_length() const { return length; }
+    size_t get_capacity() const { return _block_start(block_count); }
+    size_t get_size() const { return get_capacity() * sizeof(T); }
+    bool is_empty() const { return length == 0; }
+
+    // Возвращаемая ссылка остается действительной при последующих вставках
+    T& push_back(const T& x) { return _push_back(x); }
+    T& push_back(T&& x) { return _push_back(std::move(x)); }
+
+    T pop_back() {
+        _require<CheckPolicy, EmptyError>(length != 0);
+        return *try_pop_back();
+    }
+    std::optional<T> try_pop_back() {
+        if(length == 0) return std::nullopt;
+        T& slot = _at(--length);
+        T tmp = std::move(slot);
+        slot = T();
+        _dec();
+        return tmp;
+    }
+
+    int find(const T& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const T& key) const {
+        for(size_t b = 0; b < get_chunk_count(); ++b) {
+            ConstSpan<T, CheckPolicy> part = chunk(b);
+            int pos = part.try_find(key);
+            if(pos != npos) return static_cast<int>(_block_start(b)) + pos;
+        }
+        return npos;
+    }
+
+    T& operator[](int index) { return _at(_check(index)); }
+    const T& operator[](int index) const { return _at(_check(index)); }
+    T* get(int index) {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return &_at(index);
+    }
+    const T* get(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return &_at(index);
+    }
+
+    T& front() { _require<CheckPolicy, EmptyError>(length != 0); return _at(0); }
+    const T& front() const { _require<CheckPolicy, EmptyError>(length != 0); return _at(0); }
+    T& back() { _require<CheckPolicy, EmptyError>(length != 0); return _at(length - 1); }
+    const T& back() const { _require<CheckPolicy, EmptyError>(length != 0); return _at(length - 1); }
+
+    // end() сравнивается только по индексу и не разыменовывается
+    Iterator<T> begin() { return Iterator<T>(blocks, 0); }
+    Iterator<T> end() { return Iterator<T>(blocks, length); }
+    Iterator<const T> begin() const { return Iterator<const T>(blocks, 0); }
+    Iterator<const T> end() const { return Iterator<const T>(blocks, length); }
+
+    // Поблочный обход: непрерывные части, которые можно обрабатывать как обычные массивы
+    size_t get_chunk_count() const { return length ? _block_of(length - 1) + 1 : 0; }
+    Span<T, CheckPolicy> chunk(size_t index) {
+        _require<CheckPolicy, IndexError>(index < get_chunk_count());
+        size_t end = _block_start(index + 1) < length ? _block_start(index + 1) : length;
+        return Span<T, CheckPolicy>(blocks[index], end - _block_start(index));
+    }
+    ConstSpan<T, CheckPolicy> chunk(size_t index) const {
+        _require<CheckPolicy, IndexError>(index < get_chunk_count());
+        size_t end = _block_start(index + 1) < length ? _block_start(index + 1) : length;
+        return ConstSpan<T, CheckPolicy>(blocks[index], end - _block_start(index));
+    }
+};
+}
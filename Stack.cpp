@@ -1,11 +1,15 @@
+#pragma once
+
 #include <memory>
+#include <optional>
 
 #include "Exception.hpp"
 #include "DoubleLinkedList.cpp"
 
 
 namespace siilib {
-template <typename T, typename Container = DoubleLinkedList<T>>
+// CheckPolicy - проверка пустоты в pop (Check.hpp); проверки top/front/back задает политика Container
+template <typename T, typename Container = DoubleLinkedList<T>, typename CheckPolicy = Checked>
 class Stack {
 
     Container c;
@@ -13,13 +17,17 @@ class Stack {
 
 public:
     Stack(size_t max_length=0) : max_length(max_length) { }
-    Stack(const Stack<T>& right) : max_length(right.max_length), c(right.c) { }
-    Stack(Stack<T>&& right) noexcept : max_length(right.max_length), c(std::move(right.c)) { }
+    Stack(const Stack& right) : max_length(right.max_length), c(right.c) { }
+    Stack(Stack&& right) noexcept : max_length(right.max_length), c(std::move(right.c)) { }
 
     void clear() { c.clear(); }
 
     bool is_empty() const { return c.get_length() == 0; }
 
+    // Счетчики работы базового контейнера (нулевые без -DSIILIB_STATS)
+    StatsSnapshot get_stats() const { return c.get_stats(); }
+    void reset_stats() { c.reset_stats(); }
+
     size_t get_length() const { return c.get_length(); }
 
 
@@ -33,20 +41,32 @@ public:
     }
 
     T pop() {
-        if(c.get_length() == 0) throw EmptyError();
+        _require<CheckPolicy, EmptyError>(c.get_length() != 0);
         return c.pop_back();
     }
 
+    T* try_push(const T& x) {
+        if(max_length) if(c.get_length() >= max_length) return nullptr;
+        return &c.push_back(x);
+    }
+    T* try_push(T&& x) {
+        if(max_length) if(c.get_length() >= max_length) return nullptr;
+        return &c.push_back(std::move(x));
+    }
+    std::optional<T> try_pop() {
+        return c.try_pop_back();
+    }
+
     T& top() { return c.back(); }
     const T& top() const { return c.back(); }
 
-    Stack<T>& operator=(const Stack<T>& right) {
+    Stack& operator=(const Stack& right) {
         if(&right == this) return *this;
         this->max_length = right.max_length;
         this->c = right.c;
         return *this;
     }
-    Stack<T>& operator=(Stack<T>&& right) noexcept {
+    Stack& operator=(Stack&& right) noexcept {
         if(&right == this) return *this;
         this->max_length = right.max_length;
         this->c = std::move(right.c);
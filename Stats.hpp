@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+
+
+// Счетчики работы контейнеров включаются при компиляции: -DSIILIB_STATS.
+// Без этого флага _Stats - пустой базовый класс, все его методы пустые и встраиваются,
+// поэтому ни памяти, ни инструкций в контейнерах не добавляется.
+namespace siilib {
+
+struct StatsSnapshot {
+    size_t allocations{0};
+    size_t frees{0};
+    size_t bytes_allocated{0};
+    size_t bytes_freed{0};
+    size_t reallocations{0};
+    size_t moved{0};
+    size_t copied{0};
+    size_t peak_bytes{0};
+    size_t throws{0};
+
+    std::string to_json() const {
+        char buf[512];
+        std::snprintf(buf, sizeof(buf),
+            "{\"allocations\": %zu, \"frees\": %zu, \"bytes_allocated\": %zu, \"bytes_freed\": %zu, "
+            "\"reallocations\": %zu, \"moved\": %zu, \"copied\": %zu, \"peak_bytes\": %zu, \"throws\": %zu}",
+            allocations, frees, bytes_allocated, bytes_freed, reallocations, moved, copied, peak_bytes, throws);
+        return buf;
+    }
+};
+
+
+#ifdef SIILIB_STATS
+
+// Сумма по всем контейнерам программы; peak_bytes - наибольший объем одновременно занятой памяти
+class GlobalStats {
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> frees{0};
+    std::atomic<size_t> bytes_allocated{0};
+    std::atomic<size_t> bytes_freed{0};
+    std::atomic<size_t> reallocations{0};
+    std::atomic<size_t> moved{0};
+    std::atomic<size_t> copied{0};
+    std::atomic<size_t> live_bytes{0};
+    std::atomic<size_t> peak_bytes{0};
+    std::atomic<size_t> throws{0};
+
+    friend class _Stats;
+    friend struct _StatsThrow;
+
+public:
+    StatsSnapshot snapshot() const {
+        StatsSnapshot s;
+        s.allocations = allocations.load(std::memory_order_relaxed);
+        s.frees = frees.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        s.bytes_freed = bytes_freed.load(std::memory_order_relaxed);
+        s.reallocations = reallocations.load(std::memory_order_relaxed);
+        s.moved = moved.load(std::memory_order_relaxed);
+        s.copied = copied.load(std::memory_order_relaxed);
+        s.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+        s.throws = throws.load(std::memory_order_relaxed);
+        return s;
+    }
+    void reset() {
+        for(std::atomic<size_t>* c : {&allocations, &frees, &bytes_allocated, &bytes_freed, &reallocations, &moved, &copied, &throws}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+        peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+};
+
+inline GlobalStats& global_stats() {
+    static GlobalStats stats;
+    return stats;
+}
+
+// Вызывается из конструктора Exception
+struct _StatsThrow {
+    static void count() { global_stats().throws.fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Счетчики экземпляра контейнера (обновляют и глобальные). Копия контейнера начинает счет с нуля.
+class _Stats {
+    StatsSnapshot stats;
+    size_t live_bytes{0};
+
+protected:
+    void _stat_alloc(size_t bytes) {
+        stats.allocations++;
+        stats.bytes_allocated += bytes;
+        live_bytes += bytes;
+        if(live_bytes > stats.peak_bytes) stats.peak_bytes = live_bytes;
+        GlobalStats& g = global_stats();
+        g.allocations.fetch_add(1, std::memory_order_relaxed);
+        g.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        size_t live = g.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t peak = g.peak_bytes.load(std::memory_order_relaxed);
+        while(live > peak && !g.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+    }
+    void _stat_free(size_t bytes) {
+        stats.frees++;
+        stats.bytes_freed += bytes;
+        live_bytes = live_bytes > bytes ? live_bytes - bytes : 0;
+        GlobalStats& g = global_stats();
+        g.frees.fetch_add(1, std::memory_order_relaxed);
+        g.bytes_freed.fetch_add(bytes, std::memory_order_relaxed);
+        g.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    void _stat_realloc() {
+        stats.reallocations++;
+        global_stats().reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void _stat_moved(size_t count) {
+        stats.moved += count;
+        global_stats().moved.fetch_add(count, std::memory_order_relaxed);
+    }
+    void _stat_copied(size_t count) {
+        stats.copied += count;
+        global_stats().copied.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    _Stats() = default;
+    _Stats(const _Stats&) { }
+    _Stats& operator=(const _Stats&) { return *this; }
+
+public:
+    StatsSnapshot get_stats() const { return stats; }
+    void reset_stats() { stats = StatsSnapshot(); stats.peak_bytes = live_bytes; }
+};
+
+#else
+
+class GlobalStats {
+public:
+    StatsSnapshot snapshot() const { return StatsSnapshot(); }
+    void reset() { }
+};
+
+inline GlobalStats& global_stats() {
+    static GlobalStats stats;
+    return stats;
+}
+
+struct _StatsThrow {
+    static void count() { }
+};
+
+class _Stats {
+protected:
+    void _stat_alloc(size_t) { }
+    void _stat_free(size_t) { }
+    void _stat_realloc() { }
+    void _stat_moved(size_t) { }
+    void _stat_copied(size_t) { }
+
+public:
+    StatsSnapshot get_stats() const { return StatsSnapshot(); }
+    void reset_stats() { }
+};
+
+#endif
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+
+namespace siilib {
+// Стратегия выделения памяти под элементы Vector и Array (второй параметр шаблона).
+// allocate возвращает массив из n созданных элементов или бросает std::bad_alloc, deallocate его освобождает.
+// reallocate может изменить размер буфера без переноса элементов по одному (вернув новый указатель);
+// nullptr означает, что так нельзя, и контейнер сам выделит новый буфер и переместит элементы.
+struct HeapStorage {
+    template <typename T>
+    static T* allocate(size_t n) { return new T[n]; }
+    template <typename T>
+    static void deallocate(T* ptr, size_t) { delete[] ptr; }
+    template <typename T>
+    static T* reallocate(T*, size_t, size_t) { return nullptr; }
+};
+}
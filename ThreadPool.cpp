@@ -0,0 +1,129 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Exception.hpp"
+#include "Queue.cpp"
+
+
+namespace siilib {
+// Пул потоков фиксированного размера. Поток, вызвавший run, тоже выполняет работу,
+// поэтому пул из threads потоков создает threads - 1 рабочих потоков.
+class ThreadPool {
+    std::thread* workers{nullptr};
+    size_t threads{1};
+    Queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping{false};
+
+    void _work() {
+        while(true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stopping || !tasks.is_empty(); });
+                if(tasks.is_empty()) return;
+                task = tasks.pop();
+            }
+            task();
+        }
+    }
+
+    // Задание принадлежит всем его исполнителям: помощник, взятый из очереди уже после run, не обращается
+    // к разрушенной функции, а просто не находит свободных частей
+    template <typename F>
+    struct _Job {
+        F f;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t chunks{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::exception_ptr error;
+
+        _Job(F&& f, size_t chunks) : f(std::move(f)), chunks(chunks) { }
+    };
+
+    template <typename F>
+    static void _run_chunks(const std::shared_ptr<_Job<F>>& job) {
+        size_t i;
+        while((i = job->next.fetch_add(1)) < job->chunks) {
+            try { job->f(i); }
+            catch(...) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                if(!job->error) job->error = std::current_exception();
+            }
+            if(job->done.fetch_add(1) + 1 == job->chunks) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->cv.notify_all();
+            }
+        }
+    }
+
+public:
+    ThreadPool(size_t threads=std::thread::hardware_concurrency()) : threads(threads ? threads : 1) {
+        try {
+            workers = new std::thread[this->threads - 1];
+            for(size_t i = 0; i < this->threads - 1; ++i) workers[i] = std::thread([this] { _work(); });
+        }
+        catch(std::bad_alloc&) { throw AllocError(); }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        for(size_t i = 0; i < threads - 1; ++i) workers[i].join();
+        delete[] workers;
+    }
+
+    // Общий пул размером с число аппаратных потоков
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    size_t get_threads() const { return threads; }
+
+    // Выполняет f(0), ..., f(chunks - 1) на потоках пула и ждет завершения всех вызовов.
+    // Первое исключение, брошенное f, пробрасывается вызывающему потоку.
+    template <typename F>
+    void run(size_t chunks, F f) {
+        if(chunks == 0) return;
+        if(chunks == 1 || threads == 1) {
+            for(size_t i = 0; i < chunks; ++i) f(i);
+            return;
+        }
+        std::shared_ptr<_Job<F>> job;
+        try { job = std::make_shared<_Job<F>>(std::move(f), chunks); }
+        catch(std::bad_alloc&) { throw AllocError(); }
+        size_t helpers = (chunks < threads ? chunks : threads) - 1;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // Не хватило памяти на очередь - оставшиеся части выполнят уже поставленные помощники и этот поток
+            try {
+                for(size_t i = 0; i < helpers; ++i) tasks.push([job] { _run_chunks(job); });
+            }
+            catch(const AllocError&) { }
+            catch(std::bad_alloc&) { }
+        }
+        cv.notify_all();
+        _run_chunks(job);
+        {
+            std::unique_lock<std::mutex> lock(job->mutex);
+            job->cv.wait(lock, [&job] { return job->done.load() == job->chunks; });
+        }
+        if(job->error) std::rethrow_exception(job->error);
+    }
+};
+}
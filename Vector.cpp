@@ -1,14 +1,24 @@
+#pragma once
+
 #include <memory>
+#include <optional>
 
+#include "Check.hpp"
 #include "Exception.hpp"
+#include "Find.hpp"
+#include "Serialize.hpp"
+#include "Stats.hpp"
+#include "Storage.hpp"
 
 
 #define VECTOR_MIN_CAPACITY 8
 
 
 namespace siilib {
-template<typename T>
-class Vector {
+// Storage - стратегия выделения памяти под элементы (Storage.hpp, HugePageStorage.hpp),
+// CheckPolicy - проверки индексов и пустоты (Check.hpp)
+template<typename T, typename Storage = HeapStorage, typename CheckPolicy = Checked>
+class Vector : public _Stats {
     T* data{nullptr};
     size_t length{0};
     size_t capacity{0};
@@ -16,34 +26,34 @@ class Vector {
     bool manual_memory{false};
 
 
-    void _inc() {
-        if(length == capacity) {
-            T* ptr;
-            try {
-                ptr = new T[capacity * resize_factor];
-                capacity *= resize_factor;
-            }
-            catch(const std::bad_alloc&) { throw ResizeError(); }
+    // Переносит элементы в буфер емкостью new_capacity (Storage может изменить размер буфера на месте)
+    void _reallocate(size_t new_capacity) {
+        T* ptr = Storage::reallocate(data, capacity, new_capacity);
+        if(!ptr) {
+            ptr = Storage::template allocate<T>(new_capacity);
             for(size_t i = 0; i < length; ++i) {
                 ptr[i] = std::move(data[i]);
             }
-            delete[] data;
-            data = ptr;
+            Storage::deallocate(data, capacity);
+            this->_stat_moved(length);
+        }
+        this->_stat_realloc();
+        this->_stat_alloc(new_capacity * sizeof(T));
+        this->_stat_free(capacity * sizeof(T));
+        data = ptr;
+        capacity = new_capacity;
+    }
+
+    void _inc() {
+        if(length == capacity) {
+            try { _reallocate(capacity ? capacity * resize_factor : VECTOR_MIN_CAPACITY); }
+            catch(const std::bad_alloc&) { throw ResizeError(); }
         }
     }
     void _dec() {
         if(length < capacity / (resize_factor * 2) && capacity > VECTOR_MIN_CAPACITY && !this->manual_memory) {
-            T* ptr;
-            try {
-                ptr = new T[capacity / resize_factor];
-                capacity /= resize_factor;
-            }
+            try { _reallocate(capacity / resize_factor); }
             catch(const std::bad_alloc&) { throw ResizeError(); }
-            for(size_t i = 0; i < length; ++i) {
-               ptr[i] = std::move(data[i]);
-            }
-            delete[] data;
-            data = ptr;
         }
     }
 
@@ -51,12 +61,15 @@ class Vector {
     template <typename U>
     T& _push_back(U&& x) {
         if(length == capacity) this->_inc();
-        return data[length++] = std::forward<U>(x);
+        // Длина растет после присваивания: исключение копии не оставляет лишнего элемента
+        data[length] = std::forward<U>(x);
+        return data[length++];
     }
 
     template <typename U>
     T& _push_front(U&& x) {
         if(length == capacity) this->_inc();
+        this->_stat_moved(length);
         for(size_t i = length; i > 0; --i) {
             data[i] = std::move(data[i-1]);
         }
@@ -67,8 +80,9 @@ class Vector {
     template <typename U>
     T& _insert(int index, U&& x) {
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index > static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index <= static_cast<int>(length));
         if(length == capacity) this->_inc();
+        this->_stat_moved(length - index);
         for(size_t i = length; i > index; --i) {
             data[i] = std::move(data[i-1]);
         }
@@ -76,27 +90,49 @@ class Vector {
         return data[index] = std::forward<U>(x);
     }
 
+    T _pop_back() {
+        T tmp = std::move(data[--length]);
+        data[length] = T();
+        if(length < capacity / (resize_factor * 2)) this->_dec();
+        return tmp;
+    }
+    T _pop_front() {
+        T tmp = std::move(data[0]);
+        this->_stat_moved(length - 1);
+        for(size_t i = 0; i < length - 1; ++i) {
+            data[i] = std::move(data[i+1]);
+        }
+        data[--length] = T();
+        if(length < capacity / (resize_factor * 2)) this->_dec();
+        return tmp;
+    }
+
 
 public:
+    static constexpr int npos = -1;
+
     Vector(size_t capacity=VECTOR_MIN_CAPACITY, unsigned resize_factor=2) : length(0), capacity(capacity), resize_factor(resize_factor < 2 ? 2 : resize_factor), manual_memory(capacity != VECTOR_MIN_CAPACITY) {
         try {
-            data = new T[capacity];
+            data = Storage::template allocate<T>(capacity);
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(capacity * sizeof(T));
     }
     Vector(T ar[], size_t len, unsigned resize_factor=2) : length(len), capacity(VECTOR_MIN_CAPACITY), resize_factor(resize_factor < 2 ? 2 : resize_factor), manual_memory(false) {
         try {
             while(capacity <= length) capacity *= resize_factor;
-            data = new T[capacity];
+            data = Storage::template allocate<T>(capacity);
             for(size_t i = 0; i < length; ++i) {
                 data[i] = ar[i];
             }
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(capacity * sizeof(T));
+        this->_stat_copied(length);
     }
-    Vector(const Vector<T>& right) {
+    Vector(const Vector& right) : _Stats() {
         try {
-            this->data = new T[right.capacity];
+            this->data = Storage::template allocate<T>(right.capacity);
             this->length = right.length;
             this->capacity = right.capacity;
             this->resize_factor = right.resize_factor;
@@ -106,8 +142,10 @@ public:
             }
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(capacity * sizeof(T));
+        this->_stat_copied(length);
     }
-    Vector(Vector<T>&& right) noexcept {
+    Vector(Vector&& right) noexcept {
         this->length = right.length;
         this->capacity = right.capacity;
         this->resize_factor = right.resize_factor;
@@ -120,51 +158,44 @@ public:
     Vector(std::initializer_list<T> ar) : length(ar.size()), capacity(VECTOR_MIN_CAPACITY), resize_factor(2), manual_memory(false) {
         try {
             while(capacity <= length) capacity *= resize_factor;
-            data = new T[capacity];
+            data = Storage::template allocate<T>(capacity);
             size_t i = 0;
             for (const T& val : ar) {
                 data[i++] = val;
             }
         }
         catch(std::bad_alloc&) { throw AllocError(); }
+        this->_stat_alloc(capacity * sizeof(T));
+        this->_stat_copied(length);
     }
     ~Vector() {
-        this->clear();
-        delete[] data;
+        if(data) this->_stat_free(capacity * sizeof(T));
+        Storage::deallocate(data, capacity);
         data = nullptr;
         capacity = 0;
     }
 
     void clear() { 
+        // Элементы живут в буфере из Storage::allocate, поэтому не разрушаются, а сбрасываются (их разрушит deallocate)
         for (size_t i = 0; i < length; ++i) {
-            data[i].~T();
+            data[i] = T();
         }
         length = 0;
         manual_memory = false;
     }
 
     void resize(size_t len, bool manual_memory=true) {
-        T* ptr;
         if(manual_memory) this->manual_memory = true;
         len = (length > len) ? length : len;
-        try {
-            size_t tmp_capacity = capacity;
-            if(len > capacity) {
-                while(tmp_capacity <= len) tmp_capacity *= resize_factor;
-            }
-            if(len < capacity) {
-                while(tmp_capacity >= len) tmp_capacity /= resize_factor;
-                tmp_capacity = tmp_capacity > VECTOR_MIN_CAPACITY ? tmp_capacity : VECTOR_MIN_CAPACITY;
-            }
-            ptr = new T[tmp_capacity];
-            capacity = tmp_capacity;
+        size_t tmp_capacity = capacity ? capacity : VECTOR_MIN_CAPACITY;
+        if(len > capacity) {
+            while(tmp_capacity <= len) tmp_capacity *= resize_factor;
         }
-        catch(const std::bad_alloc&) { throw ResizeError(); }
-        for(size_t i = 0; i < length; ++i) {
-            ptr[i] = std::move(data[i]);
+        if(len < capacity) {
+            while(tmp_capacity / resize_factor > len && tmp_capacity / resize_factor >= VECTOR_MIN_CAPACITY) tmp_capacity /= resize_factor;
         }
-        delete[] data;
-        data = ptr;
+        try { _reallocate(tmp_capacity); }
+        catch(const std::bad_alloc&) { throw ResizeError(); }
     }
 
     void set_resize_factor(unsigned resize_factor) { this->resize_factor = resize_factor < 2 ? 2 : resize_factor; }
@@ -190,23 +221,20 @@ public:
     }
 
     T pop_back() {
-        if(length == 0) throw EmptyError();
-        length--;
-        if(length < capacity / (resize_factor * 2)) this->_dec();
-        T tmp = std::move(data[length]);
-        data[length].~T();
-        return tmp;
+        _require<CheckPolicy, EmptyError>(length != 0);
+        return _pop_back();
     }
     T pop_front() {
-        if(length == 0) throw EmptyError();
-        T tmp = std::move(data[0]);
-        for(size_t i = 0; i < length - 1; ++i) {
-            data[i] = std::move(data[i+1]);
-        }
-        length--;
-        if(length < capacity / (resize_factor * 2)) this->_dec();
-        data[length].~T();
-        return tmp;
+        _require<CheckPolicy, EmptyError>(length != 0);
+        return _pop_front();
+    }
+    std::optional<T> try_pop_back() {
+        if(length == 0) return std::nullopt;
+        return _pop_back();
+    }
+    std::optional<T> try_pop_front() {
+        if(length == 0) return std::nullopt;
+        return _pop_front();
     }
 
     T& insert(int index, const T& x) {
@@ -217,8 +245,9 @@ public:
     }
     T erase(int index) {
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         T tmp = std::move(data[index]);
+        this->_stat_moved(length - 1 - index);
         for(size_t i = index; i < length - 1; ++i) {
             data[i] = std::move(data[i+1]);
         }
@@ -230,6 +259,7 @@ public:
     void remove(const T& key) {
         for(size_t i = 0; i < length; ++i) {
             if(data[i] == key) {
+                this->_stat_moved(length - 1 - i);
                 for(size_t j = i; j < length - 1; ++j) {
                     data[j] = std::move(data[j+1]);
                 }
@@ -241,28 +271,36 @@ public:
         throw KeyError();
     }
 
-    int find(const T& key) {
-        for(size_t i = 0; i < length; ++i) {
-            if(data[i] == key) return i;
-        }
-        throw KeyError();
+    int find(const T& key) const {
+        int index = try_find(key);
+        if(index == npos) throw KeyError();
+        return index;
     }
-    int rfind(const T& key) {
-        for(int i = static_cast<int>(length)-1; i >= 0; --i) {
-            if(data[i] == key) return i;
-        }
-        throw KeyError();
+    int rfind(const T& key) const {
+        int index = try_rfind(key);
+        if(index == npos) throw KeyError();
+        return index;
+    }
+    int try_find(const T& key) const {
+        const T* pos = _find(data, data + length, key);
+        return pos == data + length ? npos : static_cast<int>(pos - data);
+    }
+    int try_rfind(const T& key) const {
+        const T* pos = _rfind(data, data + length, key);
+        return pos == data + length ? npos : static_cast<int>(pos - data);
     }
 
-    Vector<T>& extend(const Vector<T>& right) {
+    Vector& extend(const Vector& right) {
         this->resize(this->length + right.length, false);
+        this->_stat_copied(right.length);
         for(size_t i = 0; i < right.length; ++i) {
             this->data[length++] = right.data[i];
         }
         return *this;
     }
-    Vector<T>& extend(Vector<T>&& right) {
+    Vector& extend(Vector&& right) {
         this->resize(this->length + right.length, false);
+        this->_stat_copied(right.length);
         for(size_t i = 0; i < right.length; ++i) {
             this->data[length++] = right.data[i];
         }
@@ -271,25 +309,59 @@ public:
 
     T& operator[](int index) {
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         return data[index];
     }
     const T& operator[](int index) const { 
         if(index < 0) index = static_cast<int>(length) + index;
-        if(index < 0 || index >= static_cast<int>(length)) throw IndexError();
+        _require<CheckPolicy, IndexError>(index >= 0 && index < static_cast<int>(length));
         return data[index];
     }
+    T* begin() { return data; }
+    T* end() { return data + length; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + length; }
 
-    T& front() { return data[0]; }
-    const T& front() const { return data[0]; }
-    T& back() { return data[length-1]; }
-    const T& back() const { return data[length-1]; }
+    T* get(int index) {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return data + index;
+    }
+    const T* get(int index) const {
+        if(index < 0) index = static_cast<int>(length) + index;
+        if(index < 0 || index >= static_cast<int>(length)) return nullptr;
+        return data + index;
+    }
+
+    T& front() { _require<CheckPolicy, EmptyError>(length != 0); return data[0]; }
+    const T& front() const { _require<CheckPolicy, EmptyError>(length != 0); return data[0]; }
+    T& back() { _require<CheckPolicy, EmptyError>(length != 0); return data[length-1]; }
+    const T& back() const { _require<CheckPolicy, EmptyError>(length != 0); return data[length-1]; }
+
+    // Двоичное сохранение (Serialize.hpp): в поток или файловый дескриптор, тривиально копируемые элементы - одним блоком
+    void save(Writer out) const {
+        out.write_header<T>(length);
+        out.write_elements(data, length);
+        out.flush();
+    }
+    static Vector load(Reader in) {
+        size_t len = in.read_header<T>();
+        size_t cap = VECTOR_MIN_CAPACITY;
+        while(cap <= len) cap *= 2;
+        Vector res(cap);
+        res.manual_memory = false;
+        in.read_elements(res.data, len);
+        res.length = len;
+        return res;
+    }
 
-    Vector<T>& operator=(const Vector<T>& right) {
+    Vector& operator=(const Vector& right) {
         if(&right == this) return *this;
         try {
-            T* tmp = new T[right.capacity];
-            delete[] data;
+            T* tmp = Storage::template allocate<T>(right.capacity);
+            this->_stat_alloc(right.capacity * sizeof(T));
+            if(data) this->_stat_free(capacity * sizeof(T));
+            Storage::deallocate(data, capacity);
             this->data = tmp;
             this->capacity = right.capacity;
         }
@@ -297,36 +369,41 @@ public:
         this->length = right.length;
         this->resize_factor = right.resize_factor;
         this->manual_memory = right.manual_memory;
+        this->_stat_copied(length);
         for(size_t i = 0; i < length; ++i) {
             this->data[i] = right.data[i];
         }
         return *this;
     }
-    Vector<T>& operator=(Vector<T>&& right) noexcept {
+    Vector& operator=(Vector&& right) noexcept {
         if(&right == this) return *this;
+        if(data) this->_stat_free(capacity * sizeof(T));
+        Storage::deallocate(data, capacity);
         this->length = right.length;
         this->capacity = right.capacity;
         this->resize_factor = right.resize_factor;
         this->manual_memory = right.manual_memory;
-        delete[] data;
         this->data = right.data;
         right.length = 0;
         right.capacity = 0;
         right.data = nullptr;
         return *this;
     }
-    Vector<T>& operator=(std::initializer_list<T> ar) {
+    Vector& operator=(std::initializer_list<T> ar) {
         try {
             size_t tmp_capacity = VECTOR_MIN_CAPACITY;
             while(tmp_capacity <= ar.size()) tmp_capacity *= resize_factor;
-            T* tmp = new T[tmp_capacity];
-            delete[] data;
+            T* tmp = Storage::template allocate<T>(tmp_capacity);
+            this->_stat_alloc(tmp_capacity * sizeof(T));
+            if(data) this->_stat_free(capacity * sizeof(T));
+            Storage::deallocate(data, capacity);
             data = tmp;
             capacity = tmp_capacity;
         }
         catch(std::bad_alloc&) { throw AllocError(); }
         this->clear();
         this->length = ar.size();
+        this->_stat_copied(length);
         size_t i = 0;
         for (const T& val : ar) {
             data[i++] = val;
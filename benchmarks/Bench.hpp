@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+
+namespace siilib {
+namespace bench {
+
+// Число вызовов operator new. Считается, только если до подключения Bench.hpp определен
+// SIILIB_BENCH_ALLOCATIONS (тогда Bench.hpp заменяет глобальные operator new/delete программы).
+inline size_t allocation_count{0};
+
+// Вывод в формате JSON Lines (по объекту на строку) вместо таблицы: флаг --json
+inline bool json_output{false};
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Размер задачи из первого аргумента командной строки, не начинающегося с "--".
+// Заодно разбирает общие флаги бенчмарков (--json).
+inline size_t arg_size(int argc, char** argv, size_t def) {
+    size_t n = def;
+    bool found = false;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--json") == 0) json_output = true;
+        else if(std::strncmp(argv[i], "--", 2) != 0 && !found) {
+            n = std::strtoull(argv[i], nullptr, 10);
+            found = true;
+        }
+    }
+    return n;
+}
+
+inline std::vector<uint64_t> random_keys(size_t n, uint64_t seed=42) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> keys(n);
+    for(auto& k : keys) k = rng();
+    return keys;
+}
+
+// Запускает f (выполняющую ops операций) repeat раз и возвращает лучшее время на операцию в нс
+template <typename F>
+double measure(size_t ops, F&& f, int repeat=3) {
+    double best = 1e300;
+    for(int r = 0; r < repeat; ++r) {
+        uint64_t start = now_ns();
+        f();
+        double ns = static_cast<double>(now_ns() - start) / (ops ? ops : 1);
+        if(ns < best) best = ns;
+    }
+    return best;
+}
+
+struct Result {
+    double ns_per_op{0};
+    double allocs_per_op{0};
+};
+
+// Как measure, но еще считает выделения памяти на операцию (нужен SIILIB_BENCH_ALLOCATIONS)
+template <typename F>
+Result run(size_t ops, F&& f, int repeat=3) {
+    Result best{1e300, 0};
+    for(int r = 0; r < repeat; ++r) {
+        size_t allocs = allocation_count;
+        uint64_t start = now_ns();
+        f();
+        double ns = static_cast<double>(now_ns() - start) / (ops ? ops : 1);
+        if(ns < best.ns_per_op) best = Result{ns, static_cast<double>(allocation_count - allocs) / (ops ? ops : 1)};
+    }
+    return best;
+}
+
+inline void report(const char* group, const char* name, size_t n, const Result& res) {
+    if(json_output) {
+        std::printf("{\"group\": \"%s\", \"name\": \"%s\", \"n\": %zu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f}\n",
+            group, name, n, res.ns_per_op, res.allocs_per_op);
+    }
+    else std::printf("%-24s %-32s n=%-12zu %10.2f ns/op %10.4f allocs/op\n", group, name, n, res.ns_per_op, res.allocs_per_op);
+}
+inline void report(const char* group, const char* name, size_t n, double ns_per_op) {
+    if(json_output) {
+        std::printf("{\"group\": \"%s\", \"name\": \"%s\", \"n\": %zu, \"ns_per_op\": %.3f}\n", group, name, n, ns_per_op);
+    }
+    else std::printf("%-24s %-32s n=%-12zu %10.2f ns/op\n", group, name, n, ns_per_op);
+}
+}
+}
+
+#ifdef SIILIB_BENCH_ALLOCATIONS
+// noinline: встроенные в место вызова new и delete GCC сопоставляет с malloc и free и ложно предупреждает
+// (-Wmismatched-new-delete, -Walloc-size-larger-than)
+__attribute__((noinline)) void* operator new(size_t size) {
+    siilib::bench::allocation_count++;
+    if(size > PTRDIFF_MAX) throw std::bad_alloc();
+    if(void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) void* operator new[](size_t size) { return ::operator new(size); }
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept { std::free(p); }
+#endif
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <map>
+
+#include "Bench.hpp"
+#include "../BTreeMap.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 1000000);
+    std::vector<uint64_t> keys = random_keys(n, 1);
+    std::vector<uint64_t> sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    report("BTreeMap", "random insert", n, measure(n, [&] {
+        BTreeMap<uint64_t, uint64_t> m;
+        for(size_t i = 0; i < n; ++i) m.insert(keys[i], i);
+        do_not_optimize(m.get_length());
+    }, 1));
+    report("std::map", "random insert", n, measure(n, [&] {
+        std::map<uint64_t, uint64_t> m;
+        for(size_t i = 0; i < n; ++i) m[keys[i]] = i;
+        do_not_optimize(m.size());
+    }, 1));
+
+    report("BTreeMap", "bulk load", sorted.size(), measure(sorted.size(), [&] {
+        BTreeMap<uint64_t, uint64_t> m(sorted.data(), sorted.data(), sorted.size());
+        do_not_optimize(m.get_length());
+    }, 1));
+
+    BTreeMap<uint64_t, uint64_t> m(sorted.data(), sorted.data(), sorted.size());
+    std::map<uint64_t, uint64_t> sm;
+    for(uint64_t k : sorted) sm.emplace_hint(sm.end(), k, k);
+
+    report("BTreeMap", "lookup", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < n; ++i) sum += *m.get(keys[i]);
+        do_not_optimize(sum);
+    }));
+    report("std::map", "lookup", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < n; ++i) sum += sm.find(keys[i])->second;
+        do_not_optimize(sum);
+    }));
+
+    report("BTreeMap", "ordered scan", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(auto e : m) sum += e.value;
+        do_not_optimize(sum);
+    }));
+    report("std::map", "ordered scan", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(auto& e : sm) sum += e.second;
+        do_not_optimize(sum);
+    }));
+
+    report("BTreeMap", "positional access", n, measure(n, [&] {
+        uint64_t sum = 0;
+        int len = static_cast<int>(m.get_length());
+        for(size_t i = 0; i < n; ++i) sum += m[static_cast<int>(keys[i] % len)].value;
+        do_not_optimize(sum);
+    }));
+
+    return 0;
+}
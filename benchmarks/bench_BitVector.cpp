@@ -0,0 +1,73 @@
+#include "Bench.hpp"
+#include "../BitVector.cpp"
+#include "../Vector.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 10000000);
+    std::vector<uint64_t> keys = random_keys(n, 1);
+    size_t queries = 1000000;
+
+    BitVector bits;
+    Vector<bool> bytes;
+    report("BitVector", "push_back", n, measure(n, [&] {
+        BitVector b;
+        for(size_t i = 0; i < n; ++i) b.push_back(keys[i] & 1);
+        do_not_optimize(b.get_length());
+        bits = std::move(b);
+    }));
+    report("Vector<bool>", "push_back", n, measure(n, [&] {
+        Vector<bool> v;
+        for(size_t i = 0; i < n; ++i) v.push_back(keys[i] & 1);
+        do_not_optimize(v.get_length());
+        bytes = std::move(v);
+    }));
+    std::printf("memory: BitVector %zu bytes, Vector<bool> %zu bytes\n", bits.get_size(), bytes.get_size());
+
+    report("BitVector", "random test", queries, measure(queries, [&] {
+        size_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += bits.test(keys[i] % n);
+        do_not_optimize(sum);
+    }));
+    report("Vector<bool>", "random get", queries, measure(queries, [&] {
+        size_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += bytes[static_cast<int>(keys[i] % n)];
+        do_not_optimize(sum);
+    }));
+
+    report("BitVector", "count (per bit)", n, measure(n, [&] { do_not_optimize(bits.count()); }));
+    report("Vector<bool>", "count loop (per bit)", n, measure(n, [&] {
+        size_t sum = 0;
+        for(bool x : bytes) sum += x;
+        do_not_optimize(sum);
+    }));
+
+    BitVector other(n);
+    for(size_t i = 0; i < n; i += 3) other.set(i);
+    report("BitVector", "&= (per bit)", n, measure(n, [&] { bits &= other; do_not_optimize(bits.get_words()[0]); }));
+
+    report("BitVector", "find_next scan (per bit)", n, measure(n, [&] {
+        size_t seen = 0;
+        for(size_t i = other.find_first(); i != BitVector::npos; i = other.find_next(i + 1)) seen++;
+        do_not_optimize(seen);
+    }));
+
+    report("BitVector", "build_rank_index (per bit)", n, measure(n, [&] { other.build_rank_index(); }));
+    std::printf("rank index: %zu bytes for %zu bits\n", other.get_size() - other.get_capacity() / 8, n);
+    report("BitVector", "rank (indexed)", queries, measure(queries, [&] {
+        size_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += other.rank(keys[i] % n);
+        do_not_optimize(sum);
+    }));
+    size_t ones = other.count();
+    report("BitVector", "select (indexed)", queries, measure(queries, [&] {
+        size_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += other.select(keys[i] % ones);
+        do_not_optimize(sum);
+    }));
+
+    return 0;
+}
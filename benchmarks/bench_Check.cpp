@@ -0,0 +1,54 @@
+#include "Bench.hpp"
+#include "../Vector.cpp"
+#include "../Array.cpp"
+
+
+// Плотные циклы по индексу при разных политиках проверок (Check.hpp).
+// Asserted собирайте с -DNDEBUG и без него: с NDEBUG он должен совпасть с Unchecked.
+// По умолчанию 2^24 чисел.
+namespace {
+using namespace siilib;
+using namespace siilib::bench;
+
+template <typename CheckPolicy>
+void run(const char* group, size_t n) {
+    Vector<uint64_t, HeapStorage, CheckPolicy> v;
+    for(size_t i = 0; i < n; ++i) v.push_back(i);
+    Array<uint64_t, HeapStorage, CheckPolicy> ar(n);
+    int len = static_cast<int>(n);
+
+    report(group, "Vector sum v[i]", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(int i = 0; i < len; ++i) sum += v[i];
+        do_not_optimize(sum);
+    }));
+    // Проверка мешает векторизации, если компилятор не может вынести ее из цикла
+    report(group, "Array ar[i] = v[i] * 3", n, measure(n, [&] {
+        for(int i = 0; i < len; ++i) ar[i] = v[i] * 3;
+        do_not_optimize(ar[0]);
+    }));
+    report(group, "Vector gather v[hash(v[i]) % n]", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(int i = 0; i < len; ++i) sum += v[static_cast<int>((v[i] * 0x9E3779B97F4A7C15ull >> 20) % n)];
+        do_not_optimize(sum);
+    }));
+    report(group, "Vector back + pop_back", n, measure(n, [&] {
+        Vector<uint64_t, HeapStorage, CheckPolicy> tmp(v);
+        uint64_t sum = 0;
+        while(!tmp.is_empty()) {
+            sum += tmp.back();
+            tmp.pop_back();
+        }
+        do_not_optimize(sum);
+    }, 1));
+}
+}
+
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, size_t(1) << 24);
+    run<Checked>("Checked", n);
+    run<Asserted>("Asserted", n);
+    run<Unchecked>("Unchecked", n);
+    return 0;
+}
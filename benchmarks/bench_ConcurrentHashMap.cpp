@@ -0,0 +1,75 @@
+#include <mutex>
+#include <thread>
+
+#include "Bench.hpp"
+#include "../ConcurrentHashMap.cpp"
+#include "../HashMap.cpp"
+
+
+// Пропускная способность от 1 до max_threads потоков: ./bench_ConcurrentHashMap [n] [max_threads]
+// Смеси "чтение" (95% find, 5% insert_or_assign) и "запись" (50% / 50%) по 2^16 ключам;
+// ConcurrentHashMap сравнивается с HashMap под одним std::mutex. ns/op - на операцию по всей программе.
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 4000000);
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    if(max_threads == 0) max_threads = 1;
+
+    const size_t key_count = 1 << 16;
+    std::vector<uint64_t> keys = random_keys(n, 11);
+    for(uint64_t& k : keys) k %= key_count;
+
+    auto contend = [&](size_t threads, auto work) {
+        std::thread* pool = new std::thread[threads];
+        size_t chunk = n / threads;
+        for(size_t t = 0; t < threads; ++t) pool[t] = std::thread([&, t] { work(t * chunk, (t + 1) * chunk); });
+        for(size_t t = 0; t < threads; ++t) pool[t].join();
+        delete[] pool;
+    };
+
+    const char* mixes[] = {"read 95%", "write 50%"};
+    const size_t write_every[] = {20, 2};
+    char group[48];
+    for(int mix = 0; mix < 2; ++mix) {
+        for(size_t threads = 1; threads <= max_threads; threads *= 2) {
+            std::snprintf(group, sizeof(group), "%s threads=%zu", mixes[mix], threads);
+            size_t every = write_every[mix];
+
+            ConcurrentHashMap<uint64_t, uint64_t> sharded;
+            for(size_t k = 0; k < key_count; k += 2) sharded.insert_or_assign(k, k);
+            double sharded_ns = measure(n, [&] {
+                contend(threads, [&](size_t from, size_t to) {
+                    uint64_t found = 0;
+                    for(size_t i = from; i < to; ++i) {
+                        if(i % every == 0) sharded.insert_or_assign(keys[i], i);
+                        else found += sharded.find(keys[i]).has_value();
+                    }
+                    do_not_optimize(found);
+                });
+            });
+            report(group, "ConcurrentHashMap", n, sharded_ns);
+
+            HashMap<uint64_t, uint64_t> single;
+            std::mutex mutex;
+            for(size_t k = 0; k < key_count; k += 2) single.insert(k, k);
+            double single_ns = measure(n, [&] {
+                contend(threads, [&](size_t from, size_t to) {
+                    uint64_t found = 0;
+                    for(size_t i = from; i < to; ++i) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if(i % every == 0) single.insert(keys[i], i);
+                        else found += single.contains(keys[i]);
+                    }
+                    do_not_optimize(found);
+                });
+            });
+            report(group, "mutex + HashMap", n, single_ns);
+            if(!json_output) {
+                std::printf("%-24s %-32s %.1f Mops/s vs %.1f Mops/s\n", group, "throughput", 1e3 / sharded_ns, 1e3 / single_ns);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <mutex>
+#include <thread>
+
+#include "Bench.hpp"
+#include "../ConcurrentStack.cpp"
+#include "../Stack.cpp"
+#include "../Vector.cpp"
+
+
+// Конкуренция за вершину стека от 1 до max_threads потоков: ./bench_ConcurrentStack [n] [max_threads]
+// Каждый поток выполняет n / threads пар push + pop; ns/op - на одну пару по всей программе.
+// ConcurrentStack сравнивается со Stack<Vector> под std::mutex.
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 4000000);
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    if(max_threads == 0) max_threads = 1;
+
+    auto contend = [&](size_t threads, auto work) {
+        std::thread* pool = new std::thread[threads];
+        for(size_t t = 0; t < threads; ++t) pool[t] = std::thread([&, t] { work(t, n / threads); });
+        for(size_t t = 0; t < threads; ++t) pool[t].join();
+        delete[] pool;
+    };
+
+    char group[32];
+    for(size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::snprintf(group, sizeof(group), "threads=%zu", threads);
+
+        ConcurrentStack<uint64_t> lock_free;
+        report(group, "ConcurrentStack push + pop", n, measure(n, [&] {
+            contend(threads, [&](size_t t, size_t count) {
+                uint64_t total = 0;
+                for(size_t i = 0; i < count; ++i) {
+                    lock_free.push(t + i);
+                    total += lock_free.pop();
+                }
+                do_not_optimize(total);
+            });
+        }, 3));
+
+        Stack<uint64_t, Vector<uint64_t>> locked;
+        std::mutex mutex;
+        report(group, "mutex + Stack<Vector> push + pop", n, measure(n, [&] {
+            contend(threads, [&](size_t t, size_t count) {
+                uint64_t total = 0;
+                for(size_t i = 0; i < count; ++i) {
+                    { std::lock_guard<std::mutex> lock(mutex); locked.push(t + i); }
+                    { std::lock_guard<std::mutex> lock(mutex); total += locked.pop(); }
+                }
+                do_not_optimize(total);
+            });
+        }, 3));
+
+        // Пачка push, затем пачка pop: узлы берутся из пула потока, а не из new
+        report(group, "ConcurrentStack 64 push, 64 pop", n, measure(n, [&] {
+            contend(threads, [&](size_t t, size_t count) {
+                uint64_t total = 0;
+                for(size_t i = 0; i < count; i += 64) {
+                    for(size_t k = 0; k < 64; ++k) lock_free.push(t + k);
+                    for(size_t k = 0; k < 64; ++k) total += lock_free.pop();
+                }
+                do_not_optimize(total);
+            });
+        }, 3));
+    }
+    return 0;
+}
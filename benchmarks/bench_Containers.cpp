@@ -0,0 +1,500 @@
+#define SIILIB_BENCH_ALLOCATIONS
+
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <queue>
+#include <stack>
+#include <string>
+
+#include "Bench.hpp"
+#include "../Vector.cpp"
+#include "../Array.cpp"
+#include "../OneLinkedList.cpp"
+#include "../DoubleLinkedList.cpp"
+#include "../Stack.cpp"
+#include "../Queue.cpp"
+
+
+// Основные контейнеры рядом с аналогами из STL на элементах int, std::string и 64-байтной структуры.
+// Аргумент - наибольший размер (размеры 10, 1000, 100000, 10000000 не больше него), --json - вывод для bench_compare.
+// Операции за O(n) (вставка в середину, поиск) повторяются столько раз, чтобы суммарно обработать ~10^7 элементов.
+namespace {
+using namespace siilib;
+using namespace siilib::bench;
+
+struct Pod64 {
+    uint64_t v[8];
+    bool operator==(const Pod64& right) const { return std::memcmp(v, right.v, sizeof(v)) == 0; }
+};
+
+template <typename T> T make(size_t i);
+template <> int make<int>(size_t i) { return static_cast<int>(i); }
+// Длиннее буфера SSO, чтобы копирование строк выделяло память
+template <> std::string make<std::string>(size_t i) { return "siilib-benchmark-" + std::to_string(i); }
+template <> Pod64 make<Pod64>(size_t i) { return Pod64{{i, i, i, i, i, i, i, i}}; }
+
+uint64_t value_of(int x) { return x; }
+uint64_t value_of(const std::string& x) { return x.size(); }
+uint64_t value_of(const Pod64& x) { return x.v[0]; }
+
+// Повторы операций за O(1), чтобы на маленьких размерах замер длился заметное время
+size_t rounds(size_t n) { return n >= 1000000 ? 1 : 1000000 / n; }
+// Число операций за O(n) на один замер
+size_t linear_ops(size_t n) { return std::max<size_t>(1, std::min<size_t>(100000, 10000000 / n)); }
+
+// Лучший из трех замеров f(c) на свежем контейнере c = prepare(); подготовка не измеряется
+template <typename P, typename F>
+Result run_on(size_t ops, P&& prepare, F&& f) {
+    Result best{1e300, 0};
+    for(int r = 0; r < 3; ++r) {
+        auto c = prepare();
+        Result res = run(ops, [&] { f(c); }, 1);
+        if(res.ns_per_op < best.ns_per_op) best = res;
+    }
+    return best;
+}
+
+struct Reporter {
+    std::string siilib_group, std_group;
+    size_t n;
+    void operator()(const char* name, const Result& mine, const Result& theirs) const {
+        report(siilib_group.c_str(), name, n, mine);
+        report(std_group.c_str(), name, n, theirs);
+    }
+    void mine(const char* name, const Result& res) const { report(siilib_group.c_str(), name, n, res); }
+};
+
+Reporter reporter(const char* siilib_name, const char* std_name, const char* type, size_t n) {
+    return Reporter{std::string(siilib_name) + "<" + type + ">", std::string(std_name) + "<" + type + ">", n};
+}
+
+template <typename T>
+struct Data {
+    std::vector<T> values;
+    std::vector<T> hits;
+    std::vector<T> misses;
+
+    explicit Data(size_t n) {
+        for(size_t i = 0; i < n; ++i) values.push_back(make<T>(i));
+        for(size_t i = 0; i < linear_ops(n); ++i) {
+            hits.push_back(make<T>(i * 7919 % n));
+            misses.push_back(make<T>(n + i));
+        }
+    }
+};
+
+
+template <typename T>
+void bench_vector(const char* type, size_t n, const Data<T>& d) {
+    Reporter rep = reporter("Vector", "std::vector", type, n);
+    size_t r = rounds(n), k = linear_ops(n);
+    auto mine = [&] { Vector<T> v; for(const T& x : d.values) v.push_back(x); return v; };
+    auto theirs = [&] { return d.values; };
+
+    rep("push_back", run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Vector<T> v;
+            for(const T& x : d.values) v.push_back(x);
+            do_not_optimize(v.get_length());
+        }
+    }), run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            std::vector<T> v;
+            for(const T& x : d.values) v.push_back(x);
+            do_not_optimize(v.size());
+        }
+    }));
+    rep("pop_back", run_on(n, mine, [&](Vector<T>& v) {
+        while(!v.is_empty()) v.pop_back();
+    }), run_on(n, theirs, [&](std::vector<T>& v) {
+        while(!v.empty()) v.pop_back();
+    }));
+    // Вставка и удаление в начале сдвигают все элементы, поэтому измеряются парой с сохранением размера
+    rep("push_front+pop_front", run_on(k, mine, [&](Vector<T>& v) {
+        for(size_t j = 0; j < k; ++j) {
+            v.push_front(d.values[j % n]);
+            v.pop_front();
+        }
+    }), run_on(k, theirs, [&](std::vector<T>& v) {
+        for(size_t j = 0; j < k; ++j) {
+            v.insert(v.begin(), d.values[j % n]);
+            v.erase(v.begin());
+        }
+    }));
+    rep("insert+erase middle", run_on(k, mine, [&](Vector<T>& v) {
+        for(size_t j = 0; j < k; ++j) {
+            v.insert(static_cast<int>(n / 2), d.values[j % n]);
+            v.erase(static_cast<int>(n / 2));
+        }
+    }), run_on(k, theirs, [&](std::vector<T>& v) {
+        for(size_t j = 0; j < k; ++j) {
+            v.insert(v.begin() + n / 2, d.values[j % n]);
+            v.erase(v.begin() + n / 2);
+        }
+    }));
+
+    Vector<T> v = mine();
+    std::vector<T> sv = theirs();
+    rep("find hit", run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.hits) sum += v.try_find(key);
+        do_not_optimize(sum);
+    }), run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.hits) sum += std::find(sv.begin(), sv.end(), key) - sv.begin();
+        do_not_optimize(sum);
+    }));
+    rep("find miss", run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.misses) sum += v.try_find(key);
+        do_not_optimize(sum);
+    }), run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.misses) sum += std::find(sv.begin(), sv.end(), key) - sv.begin();
+        do_not_optimize(sum);
+    }));
+    rep("copy", run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Vector<T> copy(v);
+            do_not_optimize(copy.get_length());
+        }
+    }), run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            std::vector<T> copy(sv);
+            do_not_optimize(copy.size());
+        }
+    }));
+    rep("move", run(2000, [&] {
+        for(size_t j = 0; j < 1000; ++j) {
+            Vector<T> tmp(std::move(v));
+            v = std::move(tmp);
+        }
+    }), run(2000, [&] {
+        for(size_t j = 0; j < 1000; ++j) {
+            std::vector<T> tmp(std::move(sv));
+            sv = std::move(tmp);
+        }
+    }));
+    rep("extend", run_on(n, mine, [&](Vector<T>& a) {
+        a.extend(v);
+    }), run_on(n, theirs, [&](std::vector<T>& a) {
+        a.insert(a.end(), sv.begin(), sv.end());
+    }));
+    rep("traversal", run(n * r, [&] {
+        uint64_t sum = 0;
+        for(size_t j = 0; j < r; ++j) for(const T& x : v) sum += value_of(x);
+        do_not_optimize(sum);
+    }), run(n * r, [&] {
+        uint64_t sum = 0;
+        for(size_t j = 0; j < r; ++j) for(const T& x : sv) sum += value_of(x);
+        do_not_optimize(sum);
+    }));
+}
+
+
+template <typename T>
+void bench_array(const char* type, size_t n, const Data<T>& d) {
+    Reporter rep = reporter("Array", "std::vector", type, n);
+    size_t r = rounds(n), k = linear_ops(n);
+    auto mine = [&] { Array<T> a(n); for(size_t i = 0; i < n; ++i) a[static_cast<int>(i)] = d.values[i]; return a; };
+    auto theirs = [&] { return d.values; };
+
+    rep("fill by index", run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Array<T> a(n);
+            for(size_t i = 0; i < n; ++i) a[static_cast<int>(i)] = d.values[i];
+            do_not_optimize(a.get_length());
+        }
+    }), run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            std::vector<T> a(n);
+            for(size_t i = 0; i < n; ++i) a[i] = d.values[i];
+            do_not_optimize(a.size());
+        }
+    }));
+    // Длина Array постоянна: insert вытесняет последний элемент, erase освобождает его
+    rep("insert+erase middle", run_on(k, mine, [&](Array<T>& a) {
+        for(size_t j = 0; j < k; ++j) {
+            a.insert(static_cast<int>(n / 2), d.values[j % n]);
+            a.erase(static_cast<int>(n / 2));
+        }
+    }), run_on(k, theirs, [&](std::vector<T>& a) {
+        for(size_t j = 0; j < k; ++j) {
+            std::move_backward(a.begin() + n / 2, a.end() - 1, a.end());
+            a[n / 2] = d.values[j % n];
+            std::move(a.begin() + n / 2 + 1, a.end(), a.begin() + n / 2);
+            a.back() = T();
+        }
+    }));
+
+    Array<T> a = mine();
+    std::vector<T> sa = theirs();
+    rep("find hit", run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.hits) sum += a.try_find(key);
+        do_not_optimize(sum);
+    }), run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.hits) sum += std::find(sa.begin(), sa.end(), key) - sa.begin();
+        do_not_optimize(sum);
+    }));
+    rep("find miss", run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.misses) sum += a.try_find(key);
+        do_not_optimize(sum);
+    }), run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.misses) sum += std::find(sa.begin(), sa.end(), key) - sa.begin();
+        do_not_optimize(sum);
+    }));
+    rep("copy", run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Array<T> copy(a);
+            do_not_optimize(copy.get_length());
+        }
+    }), run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            std::vector<T> copy(sa);
+            do_not_optimize(copy.size());
+        }
+    }));
+    rep("move", run(2000, [&] {
+        for(size_t j = 0; j < 1000; ++j) {
+            Array<T> tmp(std::move(a));
+            a = std::move(tmp);
+        }
+    }), run(2000, [&] {
+        for(size_t j = 0; j < 1000; ++j) {
+            std::vector<T> tmp(std::move(sa));
+            sa = std::move(tmp);
+        }
+    }));
+    rep("traversal", run(n * r, [&] {
+        uint64_t sum = 0;
+        for(size_t j = 0; j < r; ++j) for(const T& x : a) sum += value_of(x);
+        do_not_optimize(sum);
+    }), run(n * r, [&] {
+        uint64_t sum = 0;
+        for(size_t j = 0; j < r; ++j) for(const T& x : sa) sum += value_of(x);
+        do_not_optimize(sum);
+    }));
+}
+
+
+// std::forward_list с запомненным хвостом, чтобы вставка в конец была за O(1), как в OneLinkedList
+template <typename T>
+class ForwardList {
+    using List = std::forward_list<T>;
+    List l;
+    typename List::iterator tail{l.before_begin()};
+public:
+    ForwardList() = default;
+    ForwardList(const ForwardList& right) { extend(right); }
+    ForwardList(ForwardList&& right) noexcept { *this = std::move(right); }
+    ForwardList& operator=(ForwardList&& right) noexcept {
+        bool empty = right.l.empty();
+        l = std::move(right.l);
+        tail = empty ? l.before_begin() : right.tail;
+        right.tail = right.l.before_begin();
+        return *this;
+    }
+    void push_back(const T& x) { tail = l.insert_after(tail, x); }
+    void push_front(const T& x) { l.push_front(x); if(tail == l.before_begin()) tail = l.begin(); }
+    void pop_front() { l.pop_front(); if(l.empty()) tail = l.before_begin(); }
+    // Вставка и удаление после элемента index - 1 (index > 0 и меньше длины)
+    void insert(size_t index, const T& x) { l.insert_after(std::next(l.before_begin(), index), x); }
+    void erase(size_t index) { l.erase_after(std::next(l.before_begin(), index)); }
+    bool contains(const T& key) const { return std::find(l.begin(), l.end(), key) != l.end(); }
+    void extend(const ForwardList& right) { for(const T& x : right.l) push_back(x); }
+    bool empty() const { return l.empty(); }
+};
+
+// std::list с тем же интерфейсом
+template <typename T>
+class List {
+    std::list<T> l;
+public:
+    void push_back(const T& x) { l.push_back(x); }
+    void push_front(const T& x) { l.push_front(x); }
+    void pop_front() { l.pop_front(); }
+    void pop_back() { l.pop_back(); }
+    void insert(size_t index, const T& x) { l.insert(std::next(l.begin(), index), x); }
+    void erase(size_t index) { l.erase(std::next(l.begin(), index)); }
+    bool contains(const T& key) const { return std::find(l.begin(), l.end(), key) != l.end(); }
+    void extend(const List& right) { l.insert(l.end(), right.l.begin(), right.l.end()); }
+    bool empty() const { return l.empty(); }
+};
+
+// Общие операции списков. У списков siilib нет итераторов, поэтому полный проход измеряется как find miss.
+template <typename Mine, typename Theirs, typename T>
+void bench_list(const Reporter& rep, size_t n, const Data<T>& d) {
+    size_t r = rounds(n), k = linear_ops(n);
+    auto mine = [&] { Mine l; for(const T& x : d.values) l.push_back(x); return l; };
+    auto theirs = [&] { Theirs l; for(const T& x : d.values) l.push_back(x); return l; };
+
+    rep("push_back", run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Mine l;
+            for(const T& x : d.values) l.push_back(x);
+            do_not_optimize(l.get_length());
+        }
+    }), run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Theirs l;
+            for(const T& x : d.values) l.push_back(x);
+            do_not_optimize(l.empty());
+        }
+    }));
+    rep("push_front", run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Mine l;
+            for(const T& x : d.values) l.push_front(x);
+            do_not_optimize(l.get_length());
+        }
+    }), run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Theirs l;
+            for(const T& x : d.values) l.push_front(x);
+            do_not_optimize(l.empty());
+        }
+    }));
+    rep("pop_front", run_on(n, mine, [&](Mine& l) {
+        while(!l.is_empty()) l.pop_front();
+    }), run_on(n, theirs, [&](Theirs& l) {
+        while(!l.empty()) l.pop_front();
+    }));
+    rep("insert+erase middle", run_on(k, mine, [&](Mine& l) {
+        for(size_t j = 0; j < k; ++j) {
+            l.insert(static_cast<int>(n / 2), d.values[j % n]);
+            l.erase(static_cast<int>(n / 2));
+        }
+    }), run_on(k, theirs, [&](Theirs& l) {
+        for(size_t j = 0; j < k; ++j) {
+            l.insert(n / 2, d.values[j % n]);
+            l.erase(n / 2);
+        }
+    }));
+
+    Mine l = mine();
+    Theirs sl = theirs();
+    rep("find hit", run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.hits) sum += l.try_find(key);
+        do_not_optimize(sum);
+    }), run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.hits) sum += sl.contains(key);
+        do_not_optimize(sum);
+    }));
+    rep("find miss", run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.misses) sum += l.try_find(key);
+        do_not_optimize(sum);
+    }), run(k, [&] {
+        size_t sum = 0;
+        for(const T& key : d.misses) sum += sl.contains(key);
+        do_not_optimize(sum);
+    }));
+    rep("copy", run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Mine copy(l);
+            do_not_optimize(copy.get_length());
+        }
+    }), run(n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Theirs copy(sl);
+            do_not_optimize(copy.empty());
+        }
+    }));
+    rep("move", run(2000, [&] {
+        for(size_t j = 0; j < 1000; ++j) {
+            Mine tmp(std::move(l));
+            l = std::move(tmp);
+        }
+    }), run(2000, [&] {
+        for(size_t j = 0; j < 1000; ++j) {
+            Theirs tmp(std::move(sl));
+            sl = std::move(tmp);
+        }
+    }));
+    rep("extend", run_on(n, mine, [&](Mine& a) {
+        a.extend(l);
+    }), run_on(n, theirs, [&](Theirs& a) {
+        a.extend(sl);
+    }));
+}
+
+template <typename T>
+void bench_one_linked_list(const char* type, size_t n, const Data<T>& d) {
+    Reporter rep = reporter("OneLinkedList", "std::forward_list", type, n);
+    bench_list<OneLinkedList<T>, ForwardList<T>>(rep, n, d);
+    // В std::forward_list нет удаления с конца; в OneLinkedList оно за O(n)
+    size_t k = linear_ops(n);
+    rep.mine("pop_back", run_on(k, [&] { OneLinkedList<T> l; for(const T& x : d.values) l.push_back(x); return l; }, [&](OneLinkedList<T>& l) {
+        for(size_t j = 0; j < k && !l.is_empty(); ++j) l.pop_back();
+    }));
+}
+
+template <typename T>
+void bench_double_linked_list(const char* type, size_t n, const Data<T>& d) {
+    Reporter rep = reporter("DoubleLinkedList", "std::list", type, n);
+    bench_list<DoubleLinkedList<T>, List<T>>(rep, n, d);
+    rep("pop_back", run_on(n, [&] { DoubleLinkedList<T> l; for(const T& x : d.values) l.push_back(x); return l; }, [&](DoubleLinkedList<T>& l) {
+        while(!l.is_empty()) l.pop_back();
+    }), run_on(n, [&] { List<T> l; for(const T& x : d.values) l.push_back(x); return l; }, [&](List<T>& l) {
+        while(!l.empty()) l.pop_back();
+    }));
+}
+
+
+template <typename Mine, typename Theirs, typename T>
+void bench_adapter(const Reporter& rep, size_t n, const Data<T>& d) {
+    size_t r = rounds(n);
+    rep("push+pop", run(2 * n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Mine s;
+            for(const T& x : d.values) s.push(x);
+            while(!s.is_empty()) s.pop();
+        }
+    }), run(2 * n * r, [&] {
+        for(size_t j = 0; j < r; ++j) {
+            Theirs s;
+            for(const T& x : d.values) s.push(x);
+            while(!s.empty()) s.pop();
+        }
+    }));
+}
+
+template <typename T>
+void bench_adapters(const char* type, size_t n, const Data<T>& d) {
+    bench_adapter<Stack<T>, std::stack<T>>(reporter("Stack", "std::stack", type, n), n, d);
+    bench_adapter<Stack<T, Vector<T>>, std::stack<T, std::vector<T>>>(reporter("Stack(Vector)", "std::stack(vector)", type, n), n, d);
+    bench_adapter<Queue<T>, std::queue<T>>(reporter("Queue", "std::queue", type, n), n, d);
+    bench_adapter<Queue<T, DoubleLinkedList<T>>, std::queue<T, std::list<T>>>(reporter("Queue(DoubleLinkedList)", "std::queue(list)", type, n), n, d);
+}
+
+
+template <typename T>
+void bench_all(const char* type, size_t max_n) {
+    for(size_t n : {size_t(10), size_t(1000), size_t(100000), size_t(10000000)}) {
+        if(n > max_n) break;
+        Data<T> d(n);
+        bench_vector(type, n, d);
+        bench_array(type, n, d);
+        bench_one_linked_list(type, n, d);
+        bench_double_linked_list(type, n, d);
+        bench_adapters(type, n, d);
+    }
+}
+}
+
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 100000);
+    bench_all<int>("int", n);
+    bench_all<std::string>("string", n);
+    bench_all<Pod64>("pod64", n);
+    return 0;
+}
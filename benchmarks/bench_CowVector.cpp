@@ -0,0 +1,63 @@
+#include "Bench.hpp"
+#include "../CowVector.cpp"
+#include "../Vector.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 100000);
+    size_t snapshots = 10000;
+    std::vector<uint64_t> keys = random_keys(n, 1);
+
+    Vector<uint64_t> v;
+    CowVector<uint64_t> cow;
+    for(uint64_t k : keys) {
+        v.push_back(k);
+        cow.push_back(k);
+    }
+
+    // Каждый читатель берет снимок и читает из него несколько элементов
+    report("Vector", "copy snapshot + 16 reads", snapshots, measure(snapshots, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < snapshots; ++i) {
+            Vector<uint64_t> snap(v);
+            for(size_t j = 0; j < 16; ++j) sum += snap[static_cast<int>((i * 16 + j) % n)];
+        }
+        do_not_optimize(sum);
+    }));
+    report("CowVector", "shared snapshot + 16 reads", snapshots, measure(snapshots, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < snapshots; ++i) {
+            const CowVector<uint64_t> snap(cow);
+            for(size_t j = 0; j < 16; ++j) sum += snap[static_cast<int>((i * 16 + j) % n)];
+        }
+        do_not_optimize(sum);
+    }));
+
+    // Писатель изменяет конфигурацию после каждых 100 снимков: копируется только при живом снимке
+    report("CowVector", "snapshots, write every 100", snapshots, measure(snapshots, [&] {
+        CowVector<uint64_t> held(cow);
+        for(size_t i = 0; i < snapshots; ++i) {
+            CowVector<uint64_t> snap(cow);
+            do_not_optimize(snap.read().get_length());
+            if(i % 100 == 0) {
+                held = cow;
+                cow[0] = i;
+            }
+        }
+    }));
+
+    report("Vector", "write (no snapshot)", n, measure(n, [&] {
+        for(size_t i = 0; i < n; ++i) v[static_cast<int>(i)] += 1;
+        do_not_optimize(v[0]);
+    }));
+    report("CowVector", "write (unique)", n, measure(n, [&] {
+        for(size_t i = 0; i < n; ++i) cow[static_cast<int>(i)] += 1;
+        do_not_optimize(cow.read()[0]);
+    }));
+
+    std::printf("memory per snapshot: Vector %zu bytes, CowVector %zu bytes\n", v.get_size(), sizeof(CowVector<uint64_t>));
+    return 0;
+}
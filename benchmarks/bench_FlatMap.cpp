@@ -0,0 +1,69 @@
+#include <map>
+
+#include "Bench.hpp"
+#include "../FlatMap.cpp"
+#include "../FlatSet.cpp"
+#include "../Vector.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 100000);
+    size_t queries = 1000000;
+    std::vector<uint64_t> keys = random_keys(n, 1);
+    std::vector<uint64_t> probes = random_keys(queries, 2);
+    for(size_t i = 0; i < queries; i += 2) probes[i] = keys[probes[i] % n];
+
+    Vector<uint64_t> v;
+    for(uint64_t k : keys) v.push_back(k);
+
+    report("FlatSet", "build (sort + dedup)", n, measure(n, [&] {
+        FlatSet<uint64_t> s(keys.data(), n);
+        do_not_optimize(s.get_length());
+    }));
+    report("FlatMap", "build (sort + dedup)", n, measure(n, [&] {
+        FlatMap<uint64_t, uint64_t> m(keys.data(), keys.data(), n);
+        do_not_optimize(m.get_length());
+    }));
+
+    FlatSet<uint64_t> s(keys.data(), n);
+    FlatMap<uint64_t, uint64_t> m(keys.data(), keys.data(), n);
+    std::map<uint64_t, uint64_t> sm;
+    for(uint64_t k : keys) sm[k] = k;
+
+    report("FlatSet", "lookup", queries, measure(queries, [&] {
+        size_t found = 0;
+        for(uint64_t k : probes) found += s.contains(k);
+        do_not_optimize(found);
+    }));
+    report("FlatMap", "lookup", queries, measure(queries, [&] {
+        uint64_t sum = 0;
+        for(uint64_t k : probes) if(const uint64_t* p = m.get(k)) sum += *p;
+        do_not_optimize(sum);
+    }));
+    report("std::map", "lookup", queries, measure(queries, [&] {
+        uint64_t sum = 0;
+        for(uint64_t k : probes) {
+            auto it = sm.find(k);
+            if(it != sm.end()) sum += it->second;
+        }
+        do_not_optimize(sum);
+    }));
+    size_t linear_queries = queries / 1000 ? queries / 1000 : 1;
+    report("Vector::try_find", "lookup", linear_queries, measure(linear_queries, [&] {
+        size_t found = 0;
+        for(size_t i = 0; i < linear_queries; ++i) found += v.try_find(probes[i]) != Vector<uint64_t>::npos;
+        do_not_optimize(found);
+    }));
+
+    std::vector<uint64_t> batch = random_keys(n / 10 ? n / 10 : 1, 3);
+    report("FlatSet", "batched insert (n/10)", batch.size(), measure(batch.size(), [&] {
+        FlatSet<uint64_t> copy(keys.data(), n);
+        copy.insert(batch.data(), batch.size());
+        do_not_optimize(copy.get_length());
+    }, 1));
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <unordered_map>
+
+#include "Bench.hpp"
+#include "../HashMap.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 1000000);
+    std::vector<uint64_t> keys = random_keys(n, 1);
+    std::vector<uint64_t> missing = random_keys(n, 2);
+
+    report("HashMap", "insert", n, measure(n, [&] {
+        HashMap<uint64_t, uint64_t> m;
+        for(size_t i = 0; i < n; ++i) m.insert(keys[i], i);
+        do_not_optimize(m.get_length());
+    }));
+    report("std::unordered_map", "insert", n, measure(n, [&] {
+        std::unordered_map<uint64_t, uint64_t> m;
+        for(size_t i = 0; i < n; ++i) m[keys[i]] = i;
+        do_not_optimize(m.size());
+    }));
+
+    HashMap<uint64_t, uint64_t> m;
+    std::unordered_map<uint64_t, uint64_t> um;
+    for(size_t i = 0; i < n; ++i) {
+        m.insert(keys[i], i);
+        um[keys[i]] = i;
+    }
+
+    report("HashMap", "lookup hit", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < n; ++i) sum += *m.get(keys[i]);
+        do_not_optimize(sum);
+    }));
+    report("std::unordered_map", "lookup hit", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < n; ++i) sum += um.find(keys[i])->second;
+        do_not_optimize(sum);
+    }));
+
+    report("HashMap", "lookup miss", n, measure(n, [&] {
+        size_t found = 0;
+        for(size_t i = 0; i < n; ++i) found += m.contains(missing[i]);
+        do_not_optimize(found);
+    }));
+    report("std::unordered_map", "lookup miss", n, measure(n, [&] {
+        size_t found = 0;
+        for(size_t i = 0; i < n; ++i) found += um.count(missing[i]);
+        do_not_optimize(found);
+    }));
+
+    return 0;
+}
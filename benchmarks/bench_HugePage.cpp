@@ -0,0 +1,72 @@
+#include <cstring>
+
+#include "Bench.hpp"
+#include "../Vector.cpp"
+#include "../HugePageStorage.hpp"
+
+
+// Случайный доступ к большому Vector с обычными и большими страницами (HugePageStorage),
+// а также рост push_back: перенос элементов против mremap.
+// По умолчанию 2^27 чисел uint64_t (1 ГБ); размер округляется вниз до степени двойки.
+namespace {
+using namespace siilib;
+using namespace siilib::bench;
+
+// Строка режима THP из /sys, например "always [madvise] never"
+void print_thp() {
+    char mode[128] = "unavailable";
+    if(FILE* file = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r")) {
+        if(!std::fgets(mode, sizeof(mode), file)) std::strcpy(mode, "unavailable");
+        std::fclose(file);
+    }
+    mode[std::strcspn(mode, "\n")] = 0;
+    if(!json_output) std::printf("transparent hugepages: %s\n", mode);
+}
+
+template <typename Storage>
+void run(const char* group, size_t n) {
+    Vector<uint64_t, Storage> v;
+    report(group, "push_back", n, measure(n, [&] {
+        Vector<uint64_t, Storage> tmp;
+        for(size_t i = 0; i < n; ++i) tmp.push_back(i);
+        v = std::move(tmp);
+    }, 1));
+
+    // Независимые случайные чтения: упираются в промахи TLB и кэша
+    size_t reads = n < 100000000 ? n : 100000000;
+    uint64_t* data = v.begin();
+    report(group, "random read", reads, measure(reads, [&] {
+        uint64_t x = 88172645463325252ull, sum = 0;
+        for(size_t i = 0; i < reads; ++i) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            sum += data[x & (n - 1)];
+        }
+        do_not_optimize(sum);
+    }));
+    // Зависимые чтения (следующий индекс зависит от прочитанного): чистая задержка доступа
+    report(group, "random chase", reads / 8, measure(reads / 8, [&] {
+        uint64_t pos = 0;
+        for(size_t i = 0; i < reads / 8; ++i) pos = (data[pos] * 0x9E3779B97F4A7C15ull + i) & (n - 1);
+        do_not_optimize(pos);
+    }));
+    report(group, "random write", reads, measure(reads, [&] {
+        uint64_t x = 88172645463325252ull;
+        for(size_t i = 0; i < reads; ++i) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            data[x & (n - 1)] += i;
+        }
+        do_not_optimize(data[0]);
+    }));
+}
+}
+
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, size_t(1) << 27);
+    while(n & (n - 1)) n &= n - 1;
+    print_thp();
+    run<HeapStorage>("Vector (4K pages)", n);
+    run<HugePageStorage<>>("Vector (huge pages)", n);
+    run<InterleavedStorage>("Vector (interleaved)", n);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#define SIILIB_BENCH_ALLOCATIONS
+
+#include <algorithm>
+#include <cmath>
+
+#include "Bench.hpp"
+#include "../LRUCache.cpp"
+#include "../DoubleLinkedList.cpp"
+
+
+// Трассы ключей с распределением Ципфа (s = 0.99) по 10^6 ключам, кэш на 1% ключей:
+// LRUCache и SLRUCache против LRU на DoubleLinkedList с remove по значению (O(n), кэш на 256 элементов)
+// и та же трасса с вставками однократных ключей (сканированием). По умолчанию 10^7 обращений.
+namespace {
+std::vector<uint64_t> zipf_trace(size_t n, size_t keys, double s, uint64_t seed) {
+    std::vector<double> cdf(keys);
+    double total = 0;
+    for(size_t k = 0; k < keys; ++k) cdf[k] = total += 1.0 / std::pow(static_cast<double>(k + 1), s);
+    std::vector<uint64_t> uniform = siilib::bench::random_keys(n, seed);
+    std::vector<uint64_t> res(n);
+    for(size_t i = 0; i < n; ++i) {
+        double u = static_cast<double>(uniform[i] >> 11) / 9007199254740992.0 * total;
+        res[i] = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+    }
+    return res;
+}
+}
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 10000000);
+    const size_t keys = 1000000;
+    std::vector<uint64_t> trace = zipf_trace(n, keys, 0.99, 3);
+    // Каждое четвертое обращение - к ключу, который больше не встретится
+    std::vector<uint64_t> scan = trace;
+    for(size_t i = 3; i < n; i += 4) scan[i] = keys + i;
+
+    auto replay = [&](auto& cache, const std::vector<uint64_t>& keys) {
+        for(uint64_t k : keys) {
+            if(!cache.get(k)) cache.put(k, k);
+        }
+        do_not_optimize(cache.get_length());
+    };
+    char name[64];
+    auto hit_rate = [&](const char* title, const CacheCounters& c) {
+        std::snprintf(name, sizeof(name), "%s hit %.1f%%", title, c.get_hit_rate() * 100);
+        return name;
+    };
+
+    const char* groups[] = {"zipf", "zipf + scan"};
+    const std::vector<uint64_t>* traces[] = {&trace, &scan};
+    for(int g = 0; g < 2; ++g) {
+        LRUCache<uint64_t, uint64_t> lru(keys / 100);
+        Result res = run(n, [&] { replay(lru, *traces[g]); }, 1);
+        report(groups[g], hit_rate("LRUCache", lru.get_counters()), n, res);
+
+        SLRUCache<uint64_t, uint64_t> slru(keys / 100);
+        res = run(n, [&] { replay(slru, *traces[g]); }, 1);
+        report(groups[g], hit_rate("SLRUCache", slru.get_counters()), n, res);
+    }
+
+    // Без ручек: поиск и удаление узла по значению на каждое обращение
+    size_t small = n / 100 ? n / 100 : 1;
+    report("zipf small", "LRUCache 256", small, run(small, [&] {
+        LRUCache<uint64_t, uint64_t> lru(256);
+        for(size_t i = 0; i < small; ++i) if(!lru.get(trace[i])) lru.put(trace[i], trace[i]);
+        do_not_optimize(lru.get_length());
+    }, 1));
+    report("zipf small", "DoubleLinkedList remove + push_front 256", small, run(small, [&] {
+        DoubleLinkedList<uint64_t> list;
+        for(size_t i = 0; i < small; ++i) {
+            if(list.try_find(trace[i]) != list.npos) list.remove(trace[i]);
+            else if(list.get_length() == 256) list.pop_back();
+            list.push_front(trace[i]);
+        }
+        do_not_optimize(list.get_length());
+    }, 1));
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "Bench.hpp"
+#include "../Numeric.cpp"
+#include "../Vector.cpp"
+#include "../Array.cpp"
+
+
+// Числовые операции (Numeric.cpp) против простых циклов через operator[].
+// Соберите с -mavx2 -mfma и без них, чтобы сравнить AVX2 и SSE2. По умолчанию 2^20 элементов (данные в кэше L2/L3).
+namespace {
+using namespace siilib;
+using namespace siilib::bench;
+
+template <typename Container>
+void run(const char* group, size_t n) {
+    using T = std::remove_reference_t<decltype(*std::declval<Container&>().begin())>;
+    Container a(n), b(n);
+    std::vector<uint64_t> keys = random_keys(n, 1);
+    for(size_t i = 0; i < n; ++i) {
+        a[static_cast<int>(i)] = static_cast<T>(keys[i] % 1000);
+        b[static_cast<int>(i)] = static_cast<T>(keys[i] % 7 + 1);
+    }
+    int len = static_cast<int>(n);
+    volatile int opaque = 1;
+    T one = static_cast<T>(opaque); // компилятор не должен знать, что это умножение на единицу
+
+    report(group, "sum (loop)", n, measure(n, [&] {
+        T res = 0;
+        for(int i = 0; i < len; ++i) res += a[i];
+        do_not_optimize(res);
+    }));
+    report(group, "sum", n, measure(n, [&] { do_not_optimize(sum(a)); }));
+
+    report(group, "argmax (loop)", n, measure(n, [&] {
+        int best = 0;
+        for(int i = 1; i < len; ++i) if(a[best] < a[i]) best = i;
+        do_not_optimize(best);
+    }));
+    report(group, "argmax", n, measure(n, [&] { do_not_optimize(argmax(a)); }));
+
+    report(group, "dot (loop)", n, measure(n, [&] {
+        T res = 0;
+        for(int i = 0; i < len; ++i) res += a[i] * b[i];
+        do_not_optimize(res);
+    }));
+    report(group, "dot", n, measure(n, [&] { do_not_optimize(dot(a, b)); }));
+
+    report(group, "axpy (loop)", n, measure(n, [&] {
+        for(int i = 0; i < len; ++i) a[i] += 3 * b[i];
+        do_not_optimize(a[0]);
+    }));
+    report(group, "axpy", n, measure(n, [&] { axpy(T(3), b, a); do_not_optimize(a[0]); }));
+
+    report(group, "mul scalar (loop)", n, measure(n, [&] {
+        for(int i = 0; i < len; ++i) a[i] *= one;
+        do_not_optimize(a[0]);
+    }));
+    report(group, "mul scalar", n, measure(n, [&] { mul(a, one); do_not_optimize(a[0]); }));
+
+    report(group, "add container (loop)", n, measure(n, [&] {
+        for(int i = 0; i < len; ++i) a[i] += b[i];
+        do_not_optimize(a[0]);
+    }));
+    report(group, "add container", n, measure(n, [&] { add(a, b); do_not_optimize(a[0]); }));
+
+    report(group, "prefix_sum (loop)", n, measure(n, [&] {
+        for(int i = 1; i < len; ++i) b[i] += b[i - 1];
+        do_not_optimize(b[0]);
+    }));
+    report(group, "prefix_sum", n, measure(n, [&] { prefix_sum(b); do_not_optimize(b[0]); }));
+}
+}
+
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, size_t(1) << 20);
+    run<Array<float>>("Array<float>", n);
+    run<Array<double>>("Array<double>", n);
+    run<Array<int>>("Array<int>", n);
+    run<Array<long long>>("Array<long long>", n);
+    return 0;
+}
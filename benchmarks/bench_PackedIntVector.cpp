@@ -0,0 +1,91 @@
+#include <algorithm>
+
+#include "Bench.hpp"
+#include "../Vector.cpp"
+#include "../PackedIntVector.cpp"
+#include "../DeltaVector.cpp"
+
+
+// Сжатые массивы целых против Vector<uint64_t>: память на элемент, распаковка всего массива,
+// случайный доступ и lower_bound. По умолчанию 2^24 значений: случайные 20-битные числа
+// и упорядоченные идентификаторы со средним шагом 16.
+namespace {
+using namespace siilib;
+using namespace siilib::bench;
+
+void print_memory(const char* name, size_t bytes, size_t n) {
+    if(!json_output) std::printf("%-40s %8.2f bytes/value (%.1f%% of Vector<uint64_t>)\n", name, double(bytes) / n, 100.0 * bytes / (n * 8.0));
+}
+}
+
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, size_t(1) << 24);
+    std::vector<uint64_t> keys = random_keys(n, 1);
+
+    Vector<uint64_t> plain;
+    PackedIntVector packed(20);
+    for(size_t i = 0; i < n; ++i) {
+        plain.push_back(keys[i] & 0xFFFFF);
+        packed.push_back(keys[i] & 0xFFFFF);
+    }
+    Vector<uint64_t> plain_sorted;
+    DeltaVector delta;
+    uint64_t cur = 1000000000;
+    for(size_t i = 0; i < n; ++i) {
+        cur += keys[i] % 32;
+        plain_sorted.push_back(cur);
+        delta.push_back(cur);
+    }
+    print_memory("PackedIntVector (20 bits)", packed.get_word_count() * sizeof(uint64_t), n);
+    print_memory("DeltaVector (sorted, gap < 32)", delta.get_size(), n);
+
+    std::vector<uint64_t> out(n);
+    report("decode all", "Vector<uint64_t> copy", n, measure(n, [&] {
+        std::copy(plain.begin(), plain.end(), out.begin());
+        do_not_optimize(out[n - 1]);
+    }));
+    report("decode all", "PackedIntVector::unpack", n, measure(n, [&] {
+        packed.unpack(0, n, out.data());
+        do_not_optimize(out[n - 1]);
+    }));
+    report("decode all", "DeltaVector::unpack", n, measure(n, [&] {
+        delta.unpack(out.data());
+        do_not_optimize(out[n - 1]);
+    }));
+    report("decode all", "DeltaVector::for_each sum", n, measure(n, [&] {
+        uint64_t sum = 0;
+        delta.for_each([&](uint64_t x) { sum += x; });
+        do_not_optimize(sum);
+    }));
+
+    size_t reads = n < 10000000 ? n : 10000000;
+    report("random access", "Vector<uint64_t>", reads, measure(reads, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < reads; ++i) sum += plain.begin()[keys[i] % n];
+        do_not_optimize(sum);
+    }));
+    report("random access", "PackedIntVector", reads, measure(reads, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < reads; ++i) sum += packed[keys[i] % n];
+        do_not_optimize(sum);
+    }));
+    report("random access", "DeltaVector", reads / 16, measure(reads / 16, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < reads / 16; ++i) sum += delta[keys[i] % n];
+        do_not_optimize(sum);
+    }));
+
+    size_t queries = reads / 16;
+    report("lower_bound", "Vector<uint64_t> + lower_bound", queries, measure(queries, [&] {
+        size_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += std::lower_bound(plain_sorted.begin(), plain_sorted.end(), 1000000000 + keys[i] % (cur - 1000000000)) - plain_sorted.begin();
+        do_not_optimize(sum);
+    }));
+    report("lower_bound", "DeltaVector", queries, measure(queries, [&] {
+        size_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += delta.lower_bound(1000000000 + keys[i] % (cur - 1000000000));
+        do_not_optimize(sum);
+    }));
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <thread>
+
+#include "Bench.hpp"
+#include "../Parallel.cpp"
+#include "../Vector.cpp"
+
+
+// Ускорение параллельных алгоритмов относительно одного потока: ./bench_Parallel [n] [max_threads]
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 10000000);
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    if(max_threads == 0) max_threads = 1;
+
+    std::vector<uint64_t> input = random_keys(n, 5);
+    Vector<uint64_t> v;
+    for(uint64_t x : input) v.push_back(x);
+    Vector<uint64_t> out;
+    for(size_t i = 0; i < n; ++i) out.push_back(0);
+
+    const char* names[] = {"parallel_for_each", "parallel_transform", "parallel_reduce", "parallel_find miss", "parallel_sort"};
+    double base[5] = {};
+    char group[32];
+    for(size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        double ns[5];
+        ns[0] = measure(n, [&] { parallel_for_each(v, [](uint64_t& x) { x = x * 2654435761u + 1; }, PARALLEL_DEFAULT_GRAIN, pool); });
+        ns[1] = measure(n, [&] { parallel_transform(v, out, [](uint64_t x) { return x >> 3; }, PARALLEL_DEFAULT_GRAIN, pool); });
+        ns[2] = measure(n, [&] {
+            do_not_optimize(parallel_reduce(v, uint64_t(0), [](uint64_t a, uint64_t b) { return a + b; }, PARALLEL_DEFAULT_GRAIN, pool));
+        });
+        ns[3] = measure(n, [&] { do_not_optimize(parallel_find(v, uint64_t(0), PARALLEL_DEFAULT_GRAIN, pool)); });
+        ns[4] = measure(n, [&] {
+            for(size_t i = 0; i < n; ++i) v.begin()[i] = input[i];
+            parallel_sort(v, std::less<uint64_t>(), PARALLEL_DEFAULT_GRAIN, pool);
+        }, 1);
+        std::snprintf(group, sizeof(group), "threads=%zu", threads);
+        for(int k = 0; k < 5; ++k) {
+            if(threads == 1) base[k] = ns[k];
+            report(group, names[k], n, ns[k]);
+            std::printf("%-24s %-32s speedup x%.2f\n", group, names[k], base[k] / ns[k]);
+        }
+    }
+    return 0;
+}
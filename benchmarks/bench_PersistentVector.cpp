@@ -0,0 +1,78 @@
+#include "Bench.hpp"
+#include "../PersistentVector.cpp"
+#include "../Vector.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 100000);
+    size_t versions = 1000;
+    std::vector<uint64_t> keys = random_keys(n + versions, 1);
+
+    Vector<uint64_t> base;
+    for(size_t i = 0; i < n; ++i) base.push_back(keys[i]);
+    PersistentVector<uint64_t> pbase(base.begin(), n);
+
+    // Каждая новая версия - одно изменение, все старые версии остаются доступными
+    report("Vector copy", "set, keep version", versions, measure(versions, [&] {
+        std::vector<Vector<uint64_t>> history;
+        history.reserve(versions);
+        history.push_back(base);
+        for(size_t i = 1; i < versions; ++i) {
+            history.push_back(history.back());
+            history.back()[static_cast<int>(keys[n + i] % n)] = i;
+        }
+        do_not_optimize(history.back()[0]);
+    }, 1));
+    report("PersistentVector", "set, keep version", versions, measure(versions, [&] {
+        std::vector<PersistentVector<uint64_t>> history;
+        history.reserve(versions);
+        history.push_back(pbase);
+        for(size_t i = 1; i < versions; ++i) history.push_back(history.back().set(static_cast<int>(keys[n + i] % n), i));
+        do_not_optimize(history.back()[0]);
+    }));
+    report("PersistentVector", "push_back, keep version", versions, measure(versions, [&] {
+        std::vector<PersistentVector<uint64_t>> history;
+        history.reserve(versions);
+        history.push_back(pbase);
+        for(size_t i = 1; i < versions; ++i) history.push_back(history.back().push_back(i));
+        do_not_optimize(history.back().get_length());
+    }));
+
+    report("Vector", "push_back", n, measure(n, [&] {
+        Vector<uint64_t> v;
+        for(size_t i = 0; i < n; ++i) v.push_back(keys[i]);
+        do_not_optimize(v.get_length());
+    }));
+    report("PersistentVector", "push_back (transient)", n, measure(n, [&] {
+        auto builder = PersistentVector<uint64_t>().transient();
+        for(size_t i = 0; i < n; ++i) builder.push_back(keys[i]);
+        do_not_optimize(builder.persistent().get_length());
+    }));
+    report("PersistentVector", "push_back (persistent)", n, measure(n, [&] {
+        PersistentVector<uint64_t> v;
+        for(size_t i = 0; i < n; ++i) v = v.push_back(keys[i]);
+        do_not_optimize(v.get_length());
+    }));
+
+    size_t queries = 1000000;
+    report("Vector", "random read", queries, measure(queries, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += base[static_cast<int>(keys[i % n] % n)];
+        do_not_optimize(sum);
+    }));
+    report("PersistentVector", "random read", queries, measure(queries, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += pbase[static_cast<int>(keys[i % n] % n)];
+        do_not_optimize(sum);
+    }));
+    report("PersistentVector", "scan", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(uint64_t x : pbase) sum += x;
+        do_not_optimize(sum);
+    }));
+
+    return 0;
+}
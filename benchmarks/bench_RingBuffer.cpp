@@ -0,0 +1,75 @@
+#define SIILIB_BENCH_ALLOCATIONS
+
+#include "Bench.hpp"
+#include "../RingBuffer.cpp"
+#include "../Queue.cpp"
+#include "../Numeric.cpp"
+
+
+// Окно последних N значений: Queue на списке (pop перед push) против RingBuffer с перезаписью,
+// очередь на RingBuffer против очереди на списке и сумма окна. По умолчанию 10^7 значений в окне из 1024.
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 10000000);
+    const size_t window = 1024;
+
+    report("window", "Queue<OneLinkedList> pop + push", n, run(n, [&] {
+        Queue<double> q(window);
+        for(size_t i = 0; i < n; ++i) {
+            if(q.get_length() == window) q.pop();
+            q.push(static_cast<double>(i));
+        }
+        do_not_optimize(q.back());
+    }, 1));
+    report("window", "RingBuffer overwrite push_back", n, run(n, [&] {
+        RingBuffer<double> rb(window, true);
+        for(size_t i = 0; i < n; ++i) rb.push_back(static_cast<double>(i));
+        do_not_optimize(rb.back());
+    }, 1));
+
+    report("queue", "Queue<OneLinkedList> push + pop", n, run(n, [&] {
+        Queue<size_t> q;
+        for(size_t i = 0; i < n; ++i) {
+            q.push(i);
+            if(i % 4 == 3) { q.pop(); q.pop(); }
+        }
+        do_not_optimize(q.get_length());
+    }, 1));
+    report("queue", "Queue<RingBuffer> push + pop", n, run(n, [&] {
+        Queue<size_t, RingBuffer<size_t>> q;
+        for(size_t i = 0; i < n; ++i) {
+            q.push(i);
+            if(i % 4 == 3) { q.pop(); q.pop(); }
+        }
+        do_not_optimize(q.get_length());
+    }, 1));
+
+    // Сумма полного окна: по индексу, итератором и по двум непрерывным частям (SIMD)
+    RingBuffer<double> rb(window, true);
+    for(size_t i = 0; i < window + window / 3; ++i) rb.push_back(static_cast<double>(i));
+    size_t reps = n / window ? n / window : 1;
+    report("window sum", "operator[]", reps * window, measure(reps * window, [&] {
+        for(size_t r = 0; r < reps; ++r) {
+            double total = 0;
+            for(int i = 0; i < static_cast<int>(window); ++i) total += rb[i];
+            do_not_optimize(total);
+        }
+    }));
+    report("window sum", "iterator", reps * window, measure(reps * window, [&] {
+        for(size_t r = 0; r < reps; ++r) {
+            double total = 0;
+            for(double x : rb) total += x;
+            do_not_optimize(total);
+        }
+    }));
+    report("window sum", "get_spans + sum", reps * window, measure(reps * window, [&] {
+        for(size_t r = 0; r < reps; ++r) {
+            auto [older, newer] = rb.get_spans();
+            do_not_optimize(sum(older.get_data(), older.get_data() + older.get_length())
+                            + sum(newer.get_data(), newer.get_data() + newer.get_length()));
+        }
+    }));
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "Bench.hpp"
+#include "../Array.cpp"
+#include "../FenwickTree.cpp"
+#include "../SegmentTree.cpp"
+
+
+// Запросы суммы и минимума по случайным диапазонам Array<int64_t> из 10^6 элементов вперемешку с изменениями:
+// проход по operator[] и sum из Numeric.cpp против FenwickTree и SegmentTree (в том числе с прибавлением
+// к диапазону). ns/op - на один запрос. По умолчанию 10^6 запросов; линейный проход - на n / 1000 запросах.
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 1000000);
+    const size_t length = 1000000;
+    std::vector<uint64_t> random = random_keys(3 * n, 9);
+    Array<int64_t> a(length);
+    for(size_t i = 0; i < length; ++i) a[i] = static_cast<int64_t>(random[i % random.size()] % 1000);
+
+    std::vector<size_t> from(n), to(n);
+    for(size_t i = 0; i < n; ++i) {
+        size_t l = random[2 * i] % length, r = random[2 * i + 1] % length;
+        from[i] = l < r ? l : r;
+        to[i] = (l < r ? r : l) + 1;
+    }
+    size_t scan = n / 1000 ? n / 1000 : 1;
+
+    report("build", "FenwickTree", length, measure(length, [&] { do_not_optimize(FenwickTree<int64_t>(a).get_length()); }));
+    report("build", "SegmentTree sum", length, measure(length, [&] { do_not_optimize(SegmentTree<int64_t>(a).query()); }));
+
+    report("range sum", "Array operator[] loop", scan, measure(scan, [&] {
+        for(size_t q = 0; q < scan; ++q) {
+            int64_t total = 0;
+            for(size_t i = from[q]; i < to[q]; ++i) total += a[static_cast<int>(i)];
+            do_not_optimize(total);
+        }
+    }));
+    report("range sum", "Numeric sum", scan, measure(scan, [&] {
+        for(size_t q = 0; q < scan; ++q) do_not_optimize(sum(a.begin() + from[q], a.begin() + to[q]));
+    }));
+    FenwickTree<int64_t> fenwick(a);
+    report("range sum", "FenwickTree sum", n, measure(n, [&] {
+        for(size_t q = 0; q < n; ++q) do_not_optimize(fenwick.sum(from[q], to[q]));
+    }));
+    std::vector<int64_t> out(n);
+    report("range sum", "FenwickTree batch", n, measure(n, [&] {
+        fenwick.sum(from.data(), to.data(), n, out.data());
+        do_not_optimize(out[n - 1]);
+    }));
+    SegmentTree<int64_t> sums(a);
+    report("range sum", "SegmentTree query", n, measure(n, [&] {
+        for(size_t q = 0; q < n; ++q) do_not_optimize(sums.query(from[q], to[q]));
+    }));
+
+    report("range min", "Numeric min", scan, measure(scan, [&] {
+        for(size_t q = 0; q < scan; ++q) do_not_optimize(min(a.begin() + from[q], a.begin() + to[q]));
+    }));
+    SegmentTree<int64_t, MinOp<int64_t>> mins(a);
+    report("range min", "SegmentTree query", n, measure(n, [&] {
+        for(size_t q = 0; q < n; ++q) do_not_optimize(mins.query(from[q], to[q]));
+    }));
+
+    // Половина операций - изменение: точечное для Фенвика, прибавление к диапазону для дерева отрезков
+    report("update + sum", "Array range add + loop", scan, measure(scan, [&] {
+        for(size_t q = 0; q < scan; ++q) {
+            if(q % 2) {
+                for(size_t i = from[q]; i < to[q]; ++i) a[static_cast<int>(i)] += 1;
+            }
+            else do_not_optimize(sum(a.begin() + from[q], a.begin() + to[q]));
+        }
+    }));
+    report("update + sum", "FenwickTree point add", n, measure(n, [&] {
+        for(size_t q = 0; q < n; ++q) {
+            if(q % 2) fenwick.add(from[q], 1);
+            else do_not_optimize(fenwick.sum(from[q], to[q]));
+        }
+    }));
+    report("update + sum", "SegmentTree range add", n, measure(n, [&] {
+        for(size_t q = 0; q < n; ++q) {
+            if(q % 2) sums.update(from[q], to[q], 1);
+            else do_not_optimize(sums.query(from[q], to[q]));
+        }
+    }));
+    return 0;
+}
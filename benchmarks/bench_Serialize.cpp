@@ -0,0 +1,97 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include "Bench.hpp"
+#include "../Vector.cpp"
+#include "../OneLinkedList.cpp"
+
+
+// Сохранение и загрузка: поэлементно через operator[] и push_back против save/load.
+// По умолчанию 2^27 чисел uint64_t (1 ГБ). Файл после записи лежит в кэше страниц, поэтому
+// измеряется сама загрузка, а не скорость диска.
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, size_t(1) << 27);
+    const char* path = "bench_Serialize.bin";
+    std::vector<uint64_t> keys = random_keys(n < 1000000 ? n : 1000000, 1);
+
+    Vector<uint64_t> v;
+    for(size_t i = 0; i < n; ++i) v.push_back(keys[i % keys.size()]);
+
+    report("element by element", "save (ofstream)", n, measure(n, [&] {
+        std::ofstream out(path, std::ios::binary);
+        for(size_t i = 0; i < n; ++i) out.write(reinterpret_cast<const char*>(&v[static_cast<int>(i)]), sizeof(uint64_t));
+    }, 1));
+    report("element by element", "load (ifstream)", n, measure(n, [&] {
+        std::ifstream in(path, std::ios::binary);
+        Vector<uint64_t> res;
+        uint64_t x;
+        while(in.read(reinterpret_cast<char*>(&x), sizeof(x))) res.push_back(x);
+        do_not_optimize(res.get_length());
+    }, 1));
+
+    report("Vector", "save (ofstream)", n, measure(n, [&] {
+        std::ofstream out(path, std::ios::binary);
+        v.save(out);
+    }, 1));
+    report("Vector", "load (ifstream)", n, measure(n, [&] {
+        std::ifstream in(path, std::ios::binary);
+        do_not_optimize(Vector<uint64_t>::load(in).get_length());
+    }, 1));
+
+    report("Vector", "save (fd, writev)", n, measure(n, [&] {
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        v.save(fd);
+        close(fd);
+    }, 1));
+    report("Vector", "load (fd)", n, measure(n, [&] {
+        int fd = open(path, O_RDONLY);
+        do_not_optimize(Vector<uint64_t>::load(fd).get_length());
+        close(fd);
+    }, 1));
+
+    // Без копирования: mmap и проверка заголовка, затем один проход по данным
+    report("load_view", "mmap + view", n, measure(n, [&] {
+        int fd = open(path, O_RDONLY);
+        size_t size = lseek(fd, 0, SEEK_END);
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ConstSpan<uint64_t> view = load_view<uint64_t>(mapped, size);
+        do_not_optimize(view.get_length());
+        munmap(mapped, size);
+        close(fd);
+    }));
+    report("load_view", "mmap + view + scan", n, measure(n, [&] {
+        int fd = open(path, O_RDONLY);
+        size_t size = lseek(fd, 0, SEEK_END);
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        uint64_t sum = 0;
+        for(uint64_t x : load_view<uint64_t>(mapped, size)) sum += x;
+        do_not_optimize(sum);
+        munmap(mapped, size);
+        close(fd);
+    }, 1));
+
+    // Строки и список: длина и байты каждой строки, узлы собираются в пакеты для writev
+    size_t m = n / 32;
+    OneLinkedList<std::string> list;
+    for(size_t i = 0; i < m; ++i) list.push_back(std::to_string(keys[i % keys.size()]));
+    report("OneLinkedList<string>", "save (fd, writev)", m, measure(m, [&] {
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        list.save(fd);
+        close(fd);
+    }, 1));
+    report("OneLinkedList<string>", "load (fd)", m, measure(m, [&] {
+        int fd = open(path, O_RDONLY);
+        do_not_optimize(OneLinkedList<std::string>::load(fd).get_length());
+        close(fd);
+    }, 1));
+
+    std::remove(path);
+    return 0;
+}
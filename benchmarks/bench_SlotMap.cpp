@@ -0,0 +1,79 @@
+#define SIILIB_BENCH_ALLOCATIONS
+
+#include "Bench.hpp"
+#include "../Vector.cpp"
+#include "../SlotMap.cpp"
+
+
+// Набор сущностей с постоянным обновлением: SlotMap против Vector с удалением через erase.
+// Обход всех значений и "текучка" (удалить случайную сущность, добавить новую). По умолчанию 10^5 сущностей.
+namespace {
+using namespace siilib;
+using namespace siilib::bench;
+
+struct Entity {
+    double x, y, vx, vy;
+    uint64_t id;
+};
+}
+
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 100000);
+    std::vector<uint64_t> keys = random_keys(n * 4, 1);
+
+    SlotMap<Entity> slots;
+    Vector<SlotHandle> handles;
+    Vector<Entity> plain;
+    for(size_t i = 0; i < n; ++i) {
+        Entity e{double(i), double(i), 1, 1, i};
+        handles.push_back(slots.insert(e));
+        plain.push_back(e);
+    }
+
+    size_t rounds = 10000000 / n ? 10000000 / n : 1;
+    report("iterate", "Vector<Entity>", n * rounds, measure(n * rounds, [&] {
+        for(size_t r = 0; r < rounds; ++r) {
+            for(Entity& e : plain) { e.x += e.vx; e.y += e.vy; }
+        }
+        do_not_optimize(plain.begin()[0].x);
+    }));
+    report("iterate", "SlotMap<Entity>", n * rounds, measure(n * rounds, [&] {
+        for(size_t r = 0; r < rounds; ++r) {
+            for(Entity& e : slots) { e.x += e.vx; e.y += e.vy; }
+        }
+        do_not_optimize(slots.begin()[0].x);
+    }));
+
+    // Удаление по ручке: O(1) вместо сдвига хвоста; ручка новой сущности занимает место удаленной в handles
+    size_t churn = n * 4;
+    report("churn", "SlotMap remove + insert", churn, run(churn, [&] {
+        for(size_t i = 0; i < churn; ++i) {
+            size_t victim = keys[i] % n;
+            slots.remove(handles.begin()[victim]);
+            handles.begin()[victim] = slots.insert(Entity{0, 0, 1, 1, n + i});
+        }
+        do_not_optimize(slots.get_length());
+    }, 1));
+    size_t vector_churn = churn / 64 ? churn / 64 : 1;
+    report("churn", "Vector erase + push_back", vector_churn, run(vector_churn, [&] {
+        for(size_t i = 0; i < vector_churn; ++i) {
+            plain.erase(static_cast<int>(keys[i] % n));
+            plain.push_back(Entity{0, 0, 1, 1, n + i});
+        }
+        do_not_optimize(plain.get_length());
+    }, 1));
+
+    size_t lookups = n * 4;
+    report("lookup", "SlotMap get", lookups, measure(lookups, [&] {
+        double sum = 0;
+        for(size_t i = 0; i < lookups; ++i) sum += slots.get(handles.begin()[keys[i] % n])->x;
+        do_not_optimize(sum);
+    }));
+    report("lookup", "Vector operator[]", lookups, measure(lookups, [&] {
+        double sum = 0;
+        for(size_t i = 0; i < lookups; ++i) sum += plain[static_cast<int>(keys[i] % n)].x;
+        do_not_optimize(sum);
+    }));
+    return 0;
+}
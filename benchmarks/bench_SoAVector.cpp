@@ -0,0 +1,71 @@
+#include "Bench.hpp"
+#include "../SoAVector.cpp"
+#include "../Vector.cpp"
+
+
+struct Record {
+    uint64_t id;
+    double price;
+    double weight;
+    uint32_t flags;
+    char name[36];
+};
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 1000000);
+    std::vector<uint64_t> keys = random_keys(n, 1);
+
+    Vector<Record> aos;
+    SoAVector<uint64_t, double, double, uint32_t> soa;
+    report("Vector<Record>", "push_back", n, measure(n, [&] {
+        Vector<Record> v;
+        for(size_t i = 0; i < n; ++i) v.push_back(Record{keys[i], static_cast<double>(keys[i] % 1000), 1.0, static_cast<uint32_t>(keys[i]), {}});
+        aos = std::move(v);
+    }));
+    report("SoAVector", "emplace_back", n, measure(n, [&] {
+        SoAVector<uint64_t, double, double, uint32_t> v;
+        for(size_t i = 0; i < n; ++i) v.emplace_back(keys[i], static_cast<double>(keys[i] % 1000), 1.0, static_cast<uint32_t>(keys[i]));
+        soa = std::move(v);
+    }));
+
+    report("Vector<Record>", "sum of one field", n, measure(n, [&] {
+        double sum = 0;
+        for(const Record& r : aos) sum += r.price;
+        do_not_optimize(sum);
+    }));
+    report("SoAVector", "sum of one column", n, measure(n, [&] {
+        double sum = 0;
+        for(double p : soa.column<1>()) sum += p;
+        do_not_optimize(sum);
+    }));
+
+    report("Vector<Record>", "sum price*weight", n, measure(n, [&] {
+        double sum = 0;
+        for(const Record& r : aos) sum += r.price * r.weight;
+        do_not_optimize(sum);
+    }));
+    report("SoAVector", "sum price*weight", n, measure(n, [&] {
+        const double* price = soa.column<1>().get_data();
+        const double* weight = soa.column<2>().get_data();
+        double sum = 0;
+        for(size_t i = 0; i < n; ++i) sum += price[i] * weight[i];
+        do_not_optimize(sum);
+    }));
+
+    report("Vector<Record>", "count flags", n, measure(n, [&] {
+        size_t count = 0;
+        for(const Record& r : aos) count += r.flags & 1;
+        do_not_optimize(count);
+    }));
+    report("SoAVector", "count flags", n, measure(n, [&] {
+        size_t count = 0;
+        for(uint32_t f : soa.column<3>()) count += f & 1;
+        do_not_optimize(count);
+    }));
+
+    return 0;
+}
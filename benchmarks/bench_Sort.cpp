@@ -0,0 +1,69 @@
+#include <algorithm>
+
+#include "Bench.hpp"
+#include "../Sort.cpp"
+#include "../Vector.cpp"
+
+
+template <typename T>
+std::vector<T> make_input(size_t n, int pattern) {
+    std::vector<uint64_t> r = siilib::bench::random_keys(n, 3);
+    std::vector<T> res(n);
+    for(size_t i = 0; i < n; ++i) {
+        switch(pattern) {
+            case 0: res[i] = static_cast<T>(r[i] >> 1); break;
+            case 1: res[i] = static_cast<T>(i); break;
+            case 2: res[i] = static_cast<T>(n - i); break;
+            default: res[i] = static_cast<T>(r[i] % 16); break;
+        }
+    }
+    return res;
+}
+
+// Лучший из трех замеров f(c) на свежей копии входных данных c = prepare(); копирование не измеряется
+template <typename P, typename F>
+double measure_on(size_t n, P&& prepare, F&& f) {
+    double best = 1e300;
+    for(int r = 0; r < 3; ++r) {
+        auto c = prepare();
+        double ns = siilib::bench::measure(n, [&] { f(c); }, 1);
+        if(ns < best) best = ns;
+    }
+    return best;
+}
+
+template <typename T>
+void run(const char* type, size_t n) {
+    using namespace siilib;
+    using namespace siilib::bench;
+    const char* patterns[] = {"random", "sorted", "reversed", "few unique"};
+    char name[64];
+    auto less = [](const T& a, const T& b) { return a < b; };
+    for(int p = 0; p < 4; ++p) {
+        std::vector<T> input = make_input<T>(n, p);
+        auto mine = [&] {
+            Vector<T> v;
+            for(const T& x : input) v.push_back(x);
+            return v;
+        };
+        auto theirs = [&] { return input; };
+
+        std::snprintf(name, sizeof(name), "%s %s", type, patterns[p]);
+        // Сравнение по умолчанию (std::less) включает поразрядную сортировку, лямбда - сортировку сравнениями
+        report("siilib::sort", name, n, measure_on(n, mine, [](Vector<T>& v) { sort(v); }));
+        report("siilib::sort comp", name, n, measure_on(n, mine, [&](Vector<T>& v) { sort(v, less); }));
+        report("siilib::radix_sort", name, n, measure_on(n, mine, [](Vector<T>& v) { radix_sort(v); }));
+        report("siilib::stable_sort", name, n, measure_on(n, mine, [](Vector<T>& v) { stable_sort(v); }));
+        report("siilib::stable_sort comp", name, n, measure_on(n, mine, [&](Vector<T>& v) { stable_sort(v, less); }));
+        report("std::sort", name, n, measure_on(n, theirs, [](std::vector<T>& v) { std::sort(v.begin(), v.end()); }));
+        report("std::stable_sort", name, n, measure_on(n, theirs, [](std::vector<T>& v) { std::stable_sort(v.begin(), v.end()); }));
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = siilib::bench::arg_size(argc, argv, 1000000);
+    run<uint32_t>("uint32", n);
+    run<int64_t>("int64", n);
+    run<double>("double", n);
+    return 0;
+}
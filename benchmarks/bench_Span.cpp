@@ -0,0 +1,41 @@
+#include "Bench.hpp"
+#include "../Span.cpp"
+#include "../Vector.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 1000000);
+    Vector<int32_t> v;
+    std::vector<uint64_t> keys = random_keys(n, 1);
+    for(size_t i = 0; i < n; ++i) v.push_back(static_cast<int32_t>(keys[i] & 0x7fffffff));
+    int32_t missing = -1;
+    size_t half = n / 2;
+
+    report("Vector copy", "half of vector", half, measure(half, [&] {
+        Vector<int32_t> part;
+        for(size_t i = 0; i < half; ++i) part.push_back(v[static_cast<int>(i)]);
+        do_not_optimize(part.get_length());
+    }));
+    report("Span", "slice half of vector", 1, measure(1, [&] {
+        Span<int32_t> part = Span<int32_t>(v).slice(0, static_cast<int>(half));
+        do_not_optimize(part.get_data());
+    }));
+
+    report("scalar loop", "find missing (per elem)", n, measure(n, [&] {
+        const int32_t* ptr = v.begin();
+        size_t i = 0;
+        while(i < n && ptr[i] != missing) ++i;
+        do_not_optimize(i);
+    }));
+    report("Vector::try_find", "find missing (per elem)", n, measure(n, [&] { do_not_optimize(v.try_find(missing)); }));
+    report("Vector::try_rfind", "find missing (per elem)", n, measure(n, [&] { do_not_optimize(v.try_rfind(missing)); }));
+    ConstSpan<int32_t> s(v);
+    report("ConstSpan::try_find", "find missing (per elem)", n, measure(n, [&] { do_not_optimize(s.try_find(missing)); }));
+    ConstSpan<int32_t> strided = s.slice(0, static_cast<int>(n), 2);
+    report("ConstSpan::try_find", "step 2, missing (per elem)", n / 2, measure(n / 2, [&] { do_not_optimize(strided.try_find(missing)); }));
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "Bench.hpp"
+#include "../StableVector.cpp"
+#include "../Vector.cpp"
+#include "../DoubleLinkedList.cpp"
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+    using namespace siilib::bench;
+
+    size_t n = arg_size(argc, argv, 1000000);
+    std::vector<uint64_t> keys = random_keys(n, 1);
+
+    Vector<uint64_t> v;
+    StableVector<uint64_t> sv;
+    DoubleLinkedList<uint64_t> list;
+    report("Vector", "push_back", n, measure(n, [&] {
+        Vector<uint64_t> tmp;
+        for(size_t i = 0; i < n; ++i) tmp.push_back(keys[i]);
+        v = std::move(tmp);
+    }));
+    report("StableVector", "push_back", n, measure(n, [&] {
+        StableVector<uint64_t> tmp;
+        for(size_t i = 0; i < n; ++i) tmp.push_back(keys[i]);
+        sv = std::move(tmp);
+    }));
+    report("DoubleLinkedList", "push_back", n, measure(n, [&] {
+        DoubleLinkedList<uint64_t> tmp;
+        for(size_t i = 0; i < n; ++i) tmp.push_back(keys[i]);
+        list = std::move(tmp);
+    }, 1));
+
+    report("Vector", "scan", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(uint64_t x : v) sum += x;
+        do_not_optimize(sum);
+    }));
+    report("StableVector", "scan (iterator)", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(uint64_t x : sv) sum += x;
+        do_not_optimize(sum);
+    }));
+    report("StableVector", "scan (chunks)", n, measure(n, [&] {
+        uint64_t sum = 0;
+        for(size_t b = 0; b < sv.get_chunk_count(); ++b) {
+            Span<uint64_t> part = sv.chunk(b);
+            const uint64_t* ptr = part.get_data();
+            for(size_t i = 0; i < part.get_length(); ++i) sum += ptr[i];
+        }
+        do_not_optimize(sum);
+    }));
+    // У списка нет итераторов: полный проход - поиск отсутствующего ключа
+    uint64_t missing = 0;
+    report("Vector", "try_find missing", n, measure(n, [&] { do_not_optimize(v.try_find(missing)); }));
+    report("StableVector", "try_find missing", n, measure(n, [&] { do_not_optimize(sv.try_find(missing)); }));
+    report("DoubleLinkedList", "try_find missing", n, measure(n, [&] { do_not_optimize(list.try_find(missing)); }));
+
+    size_t queries = 1000000;
+    report("Vector", "random operator[]", queries, measure(queries, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += v[static_cast<int>(keys[i] % n)];
+        do_not_optimize(sum);
+    }));
+    report("StableVector", "random operator[]", queries, measure(queries, [&] {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < queries; ++i) sum += sv[static_cast<int>(keys[i] % n)];
+        do_not_optimize(sum);
+    }));
+
+    return 0;
+}
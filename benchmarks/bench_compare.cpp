@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "../HashMap.cpp"
+#include "../Vector.cpp"
+
+
+// Сравнение двух результатов бенчмарков, сохраненных с флагом --json:
+//     bench_compare old.json new.json [порог в процентах, по умолчанию 10]
+// Печатает изменение ns/op и allocs/op для каждого замера, который есть в обоих файлах; строки, замедлившиеся
+// больше порога, помечаются. Код возврата 1, если такие есть (для проверки регрессий в скриптах).
+namespace {
+struct Row {
+    std::string group;
+    std::string name;
+    size_t n{0};
+    double ns_per_op{0};
+    double allocs_per_op{-1};
+};
+
+// Значение поля "key" из строки вида {"key": value, ...}; nullptr, если поля нет
+const char* field(const std::string& line, const char* key) {
+    std::string pattern = std::string("\"") + key + "\": ";
+    size_t pos = line.find(pattern);
+    return pos == std::string::npos ? nullptr : line.c_str() + pos + pattern.size();
+}
+
+std::string string_field(const std::string& line, const char* key) {
+    const char* p = field(line, key);
+    if(!p || *p != '"') return "";
+    const char* end = std::strchr(p + 1, '"');
+    return end ? std::string(p + 1, end) : "";
+}
+
+bool parse(const std::string& line, Row& row) {
+    const char* n = field(line, "n");
+    const char* ns = field(line, "ns_per_op");
+    if(!n || !ns) return false;
+    row.group = string_field(line, "group");
+    row.name = string_field(line, "name");
+    row.n = std::strtoull(n, nullptr, 10);
+    row.ns_per_op = std::strtod(ns, nullptr);
+    const char* allocs = field(line, "allocs_per_op");
+    row.allocs_per_op = allocs ? std::strtod(allocs, nullptr) : -1;
+    return true;
+}
+
+std::string key_of(const Row& row) { return row.group + "|" + row.name + "|" + std::to_string(row.n); }
+
+bool load(const char* path, siilib::Vector<Row>& rows) {
+    std::ifstream in(path);
+    if(!in) return false;
+    std::string line;
+    Row row;
+    while(std::getline(in, line)) {
+        if(parse(line, row)) rows.push_back(row);
+    }
+    return true;
+}
+}
+
+
+int main(int argc, char** argv) {
+    using namespace siilib;
+
+    if(argc < 3) {
+        std::fprintf(stderr, "usage: %s old.json new.json [threshold_percent]\n", argv[0]);
+        return 2;
+    }
+    double threshold = argc > 3 ? std::strtod(argv[3], nullptr) : 10.0;
+
+    Vector<Row> old_rows, new_rows;
+    if(!load(argv[1], old_rows) || !load(argv[2], new_rows)) {
+        std::fprintf(stderr, "cannot read %s or %s\n", argv[1], argv[2]);
+        return 2;
+    }
+    HashMap<std::string, size_t> old_index;
+    for(size_t i = 0; i < old_rows.get_length(); ++i) old_index.insert(key_of(old_rows[static_cast<int>(i)]), i);
+
+    size_t regressions = 0, improvements = 0, compared = 0;
+    std::printf("%-32s %-28s %-10s %12s %12s %9s %12s\n", "group", "name", "n", "old ns/op", "new ns/op", "change", "allocs/op");
+    for(const Row& row : new_rows) {
+        const size_t* index = old_index.get(key_of(row));
+        if(!index) continue;
+        const Row& old = old_rows[static_cast<int>(*index)];
+        double change = old.ns_per_op > 0 ? (row.ns_per_op / old.ns_per_op - 1) * 100 : 0;
+        const char* mark = "";
+        if(change > threshold) { mark = "  SLOWER"; regressions++; }
+        else if(change < -threshold) { mark = "  faster"; improvements++; }
+        char allocs[32] = "";
+        if(row.allocs_per_op >= 0 && old.allocs_per_op >= 0) std::snprintf(allocs, sizeof(allocs), "%.2f->%.2f", old.allocs_per_op, row.allocs_per_op);
+        std::printf("%-32s %-28s %-10zu %12.2f %12.2f %+8.1f%% %12s%s\n",
+            row.group.c_str(), row.name.c_str(), row.n, old.ns_per_op, row.ns_per_op, change, allocs, mark);
+        compared++;
+    }
+    std::printf("\ncompared %zu, slower %zu, faster %zu (threshold %.1f%%)\n", compared, regressions, improvements, threshold);
+    return regressions ? 1 : 0;
+}
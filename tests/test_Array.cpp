@@ -27,6 +27,9 @@ int main() {
         std::cout << e.what() << std::endl;
     }
 
+    if(ar2.try_find(-7) == Array<int>::npos) std::cout << "not found" << std::endl;
+    if(!ar2.get(54)) std::cout << "bad index" << std::endl;
+
     ar1 = ar4;
     ar4 = {5, 4, 3, 2, 1};
     return 0;
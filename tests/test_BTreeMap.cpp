@@ -0,0 +1,81 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../BTreeMap.cpp"
+
+
+// Копирование бросает исключение, когда счетчик copies_left доходит до нуля
+struct Fragile {
+    static int copies_left;
+    int x{0};
+
+    Fragile() = default;
+    Fragile(int x) : x(x) { }
+    Fragile(const Fragile& right) : x(right.x) { _count(); }
+    Fragile& operator=(const Fragile& right) { _count(); x = right.x; return *this; }
+
+    static void _count() {
+        if(copies_left == 0) throw std::runtime_error("copy failed");
+        copies_left--;
+    }
+};
+int Fragile::copies_left = -1;
+
+
+int main() {
+    using namespace siilib;
+
+    BTreeMap<int, std::string> m; // упорядоченный словарь на B+-дереве
+
+    m.insert(5, "five");  // добавление пары (значение существующего ключа перезаписывается)
+    m.insert(1, "one");
+    m.insert(3, "three");
+    m.insert(3, "THREE");
+
+    std::cout << m.at(3) << " " << m.get_length() << std::endl;
+
+    // доступ по позиции в отсортированном порядке (отрицательные индексы - с конца)
+    std::cout << m[0].key << " " << m[-1].value << std::endl;
+    std::cout << m.find(5) << " " << m.rank(4) << std::endl;
+
+    for(auto e : m) std::cout << e.key << ": " << e.value << std::endl;
+
+    for(int i = 10; i < 100; ++i) m.insert(i, std::to_string(i));
+    for(auto e : m.range(40, 45)) std::cout << e.key << " ";  // ключи из [40, 45)
+    std::cout << std::endl;
+
+    auto it = m.upper_bound(45);
+    std::cout << it.key() << std::endl;
+
+    m.remove(1);
+    m.erase(-1); // удаление по позиции
+
+    int keys[] = {1, 2, 3, 4, 5};
+    std::string values[] = {"a", "b", "c", "d", "e"};
+    BTreeMap<int, std::string> bulk(keys, values, 5); // построение из отсортированных данных за O(n)
+    std::cout << bulk[2].value << std::endl;
+
+    // Присваивание копии, прерванное исключением, оставляет прежнее содержимое
+    BTreeMap<int, Fragile> small, large;
+    for(int i = 0; i < 3; ++i) small.insert(i, Fragile(i));
+    for(int i = 0; i < 1000; ++i) large.insert(i, Fragile(i));
+    Fragile::copies_left = 500;
+    try { small = large; }
+    catch(const std::runtime_error&) { std::cout << "copy failed: " << small.get_length() << " " << small.at(2).x << std::endl; }
+    Fragile::copies_left = -1;
+
+    try {
+        m.at(1);
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        m[1000];
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
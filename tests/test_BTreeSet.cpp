@@ -0,0 +1,30 @@
+#include <iostream>
+
+#include "../BTreeSet.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    BTreeSet<int> s = {7, 3, 9, 1}; // упорядоченное множество на B+-дереве
+
+    s.insert(5);
+    if(!s.insert(5)) std::cout << "already exists" << std::endl;
+    s.remove(9);
+
+    for(int x : s) std::cout << x << " ";
+    std::cout << std::endl;
+
+    std::cout << s[1] << " " << *s.lower_bound(4) << " " << s.find(7) << std::endl;
+
+    for(int x : s.range(2, 7)) std::cout << x << " ";
+    std::cout << std::endl;
+
+    try {
+        s.remove(100);
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
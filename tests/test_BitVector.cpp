@@ -0,0 +1,37 @@
+#include <iostream>
+
+#include "../BitVector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    BitVector bits(100); // 100 нулевых битов
+    bits.set(3);
+    bits.set(64);
+    bits.set(99);
+    bits.push_back(true);
+
+    std::cout << bits.get_length() << " " << bits.count() << " " << bits[64] << std::endl;
+
+    // Перебор установленных битов
+    for(size_t i = bits.find_first(); i != BitVector::npos; i = bits.find_next(i + 1)) std::cout << i << " ";
+    std::cout << std::endl;
+
+    BitVector mask(bits.get_length(), true);
+    mask.reset(64);
+    std::cout << (bits & mask).count() << " " << (bits | mask).count() << " " << (~bits).count() << std::endl;
+
+    // rank - число единиц до позиции, select - позиция k-й единицы
+    bits.build_rank_index();
+    std::cout << bits.rank(64) << " " << bits.rank(65) << " " << bits.select(2) << std::endl;
+    std::cout << "size in bytes: " << bits.get_size() << std::endl;
+
+    try {
+        bits.test(1000);
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <iostream>
+
+#include "../Vector.cpp"
+#include "../Array.cpp"
+#include "../DoubleLinkedList.cpp"
+#include "../Stack.cpp"
+#include "../StableVector.cpp"
+#include "../CowVector.cpp"
+#include "../SoAVector.cpp"
+#include "../PersistentVector.cpp"
+#include "../SortedVector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<int> v{1, 2, 3};
+    try { v[3]; }
+    catch(const IndexError&) { std::cout << "index out of range" << std::endl; }
+
+    Vector<int> empty;
+    try { empty.back(); } // front и back у Vector тоже проверяют пустоту
+    catch(const EmptyError&) { std::cout << "empty" << std::endl; }
+
+    // Без проверок: тот же интерфейс, но индекс обязан быть верным
+    Vector<int, HeapStorage, Unchecked> fast{1, 2, 3};
+    int sum = 0;
+    for(int i = 0; i < static_cast<int>(fast.get_length()); ++i) sum += fast[i];
+    std::cout << sum << " " << fast[-1] << std::endl;
+
+    // assert в отладочной сборке, ничего - с NDEBUG
+    Array<int, HeapStorage, Asserted> ar(4);
+    ar[0] = 10;
+    std::cout << ar[0] << " " << (ar.get(10) == nullptr) << std::endl; // get и try_* проверяют всегда
+
+    DoubleLinkedList<int, Unchecked> list{5, 6, 7};
+    std::cout << list.erase(-1) << " " << list.back() << std::endl;
+
+    // Вставка в список проверяет индекс до выделения узла; отрицательный индекс - как у Vector
+    DoubleLinkedList<int> checked{1, 2, 3};
+    checked.insert(-1, 9);
+    try { checked.insert(10, 0); }
+    catch(const IndexError&) { std::cout << checked[2] << " " << checked.get_length() << std::endl; }
+
+    Stack<int, Vector<int, HeapStorage, Unchecked>, Unchecked> stack;
+    stack.push(1);
+    std::cout << stack.pop() << std::endl;
+
+    // Политику принимают и остальные последовательные контейнеры и представления
+    StableVector<int, Unchecked> stable{1, 2, 3};
+    Span<int, Unchecked> span(stable.chunk(0));
+    CowVector<int, Unchecked> cow{4, 5};
+    BasicSoAVector<Unchecked, int, double> soa;
+    soa.emplace_back(6, 0.5);
+    PersistentVector<int, Unchecked> pv = PersistentVector<int, Unchecked>().push_back(7);
+    SortedVector<int, std::less<int>, false, Unchecked> sorted{9, 8};
+    std::cout << stable[-1] << span[0] << cow.back() << std::get<0>(soa[0]) << pv[0] << sorted.front() << std::endl;
+
+    StableVector<int> checked_stable;
+    try { checked_stable.front(); }
+    catch(const EmptyError&) { std::cout << "empty" << std::endl; }
+}
@@ -0,0 +1,45 @@
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../ConcurrentHashMap.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    ConcurrentHashMap<std::string, int> m(8); // 8 независимо блокируемых частей
+
+    std::cout << m.insert_or_assign("one", 1) << " ";  // 1 - ключ добавлен
+    std::cout << m.insert_or_assign("one", 11) << " "; // 0 - значение заменено
+    std::cout << m.try_insert("one", 100) << std::endl; // ключ уже есть, значение не меняется
+    m.insert_or_assign("two", 2);
+
+    if(std::optional<int> x = m.find("one")) std::cout << *x << std::endl; // копия значения
+    m.visit("two", [](const int& x) { std::cout << x << std::endl; });   // без копирования, под блокировкой
+    m.update("two", [](int& x) { x *= 10; });
+    std::cout << m.at("two") << " " << m.contains("three") << " " << m.get_length() << std::endl;
+
+    m.remove("two");
+    try {
+        m.remove("two");
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    // Четыре потока считают одни и те же слова через upsert
+    ConcurrentHashMap<int, long> counts;
+    std::thread threads[4];
+    for(int t = 0; t < 4; ++t) {
+        threads[t] = std::thread([&] {
+            for(int i = 0; i < 100000; ++i) counts.upsert(i % 1000, 1, [](long& c) { ++c; });
+        });
+    }
+    for(std::thread& th : threads) th.join();
+    long total = 0;
+    counts.for_each([&](const auto& e) { total += e.value; });
+    std::cout << counts.get_length() << " " << total << " " << counts.at(7) << std::endl;
+
+    return 0;
+}
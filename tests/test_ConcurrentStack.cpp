@@ -0,0 +1,98 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../ConcurrentStack.cpp"
+#include "../ThreadPool.cpp"
+
+
+// Копирование бросает исключение, пока fail == true
+struct Fragile {
+    static bool fail;
+    int x{0};
+
+    Fragile() = default;
+    Fragile(int x) : x(x) { }
+    Fragile(const Fragile& right) : x(right.x) { if(fail) throw std::runtime_error("copy failed"); }
+    Fragile& operator=(const Fragile& right) {
+        if(fail) throw std::runtime_error("copy failed");
+        x = right.x;
+        return *this;
+    }
+};
+bool Fragile::fail = false;
+
+// Статический пул: его потоки завершаются уже после статических деструкторов и освобождают свои записи эпох
+static siilib::ThreadPool pool(4);
+
+int main() {
+    using namespace siilib;
+
+    ConcurrentStack<std::string> st(3); // стек не больше чем на 3 элемента
+
+    st.push("abc");
+    st.push("GDZ");
+    std::cout << st.top() << " " << st.get_length() << std::endl; // копия вершины
+    st.push("ZZZZZ");
+
+    try {
+        st.push("overflow");
+    }
+    catch(const OverflowError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    if(!st.try_push("x")) std::cout << "full" << std::endl;
+
+    while(std::optional<std::string> x = st.try_pop()) std::cout << *x << " ";
+    std::cout << std::endl;
+
+    try {
+        st.pop();
+    }
+    catch(const EmptyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    // Четыре потока кладут и снимают числа одновременно; сумма снятого совпадает с суммой положенного
+    ConcurrentStack<long> shared;
+    const long n = 100000;
+    std::atomic<long> total{0};
+    std::thread threads[4];
+    for(int t = 0; t < 4; ++t) {
+        threads[t] = std::thread([&, t] {
+            long local = 0;
+            for(long i = 0; i < n; ++i) {
+                shared.push(t * n + i);
+                if(i % 2) local += shared.pop();
+            }
+            total += local;
+        });
+    }
+    for(std::thread& th : threads) th.join();
+    while(std::optional<long> x = shared.try_pop()) total += *x;
+    std::cout << (total == 4 * n * (4 * n - 1) / 2) << " " << shared.is_empty() << std::endl;
+
+    // Неудачная копия при pop: элемент уже снят со стека, а его узел не теряется
+    ConcurrentStack<Fragile> fragile;
+    fragile.push(Fragile(1));
+    fragile.push(Fragile(2));
+    Fragile::fail = true;
+    try { fragile.pop(); }
+    catch(const std::runtime_error&) { std::cout << "copy failed: " << fragile.get_length() << std::endl; }
+    try { fragile.push(Fragile(3)); }
+    catch(const std::runtime_error&) { std::cout << "copy failed: " << fragile.get_length() << std::endl; }
+    Fragile::fail = false;
+    std::cout << fragile.pop().x << std::endl;
+
+    ConcurrentStack<int> from_pool;
+    pool.run(16, [&](size_t chunk) {
+        for(int i = 0; i < 1000; ++i) {
+            from_pool.push(static_cast<int>(chunk) * 1000 + i);
+            from_pool.pop();
+        }
+    });
+    std::cout << from_pool.is_empty() << std::endl;
+
+    return 0;
+}
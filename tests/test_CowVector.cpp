@@ -0,0 +1,37 @@
+#include <iostream>
+
+#include "../CowVector.cpp"
+#include "../CowArray.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    CowVector<int> config = {1, 2, 3, 4};
+    CowVector<int> snapshot = config; // элементы не копируются, буфер общий
+    std::cout << config.use_count() << " " << snapshot.unique() << std::endl;
+
+    config.push_back(5); // первое изменение: config получает собственную копию
+    std::cout << config.get_length() << " " << snapshot.get_length() << " " << snapshot.unique() << std::endl;
+
+    const CowVector<int>& reader = snapshot;
+    for(int x : reader) std::cout << x << " ";
+    std::cout << std::endl;
+
+    CowVector<int> other = snapshot;
+    other.detach(); // явное копирование заранее, например до передачи в другой поток
+    std::cout << other.unique() << " " << snapshot.unique() << std::endl;
+
+    CowArray<int> a = {7, 8, 9};
+    CowArray<int> b = a;
+    b[0] = 70;
+    std::cout << a.read()[0] << " " << b.read()[0] << " " << a.find(9) << std::endl;
+
+    try {
+        reader[10];
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
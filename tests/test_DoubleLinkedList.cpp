@@ -44,5 +44,9 @@ int main() {
     catch(const IndexError& e) {
         std::cout << e.what() << std::endl;
     }
+    std::cout << lst_int.try_rfind(2) << " " << lst_int.try_find(100) << std::endl;
+    if(!lst.get(10)) std::cout << "bad index" << std::endl;
+    while(lst_int.try_pop_back()) { }
+
     return 0;
 }
@@ -0,0 +1,40 @@
+#include <iostream>
+
+#include "../FenwickTree.cpp"
+#include "../Array.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Array<int64_t> a(8);
+    for(int i = 0; i < 8; ++i) a[i] = i + 1; // 1 2 3 4 5 6 7 8
+
+    FenwickTree<int64_t> f(a); // построение за O(n)
+    std::cout << f.prefix_sum(4) << " " << f.sum(2, 6) << std::endl; // 1+2+3+4, 3+4+5+6
+
+    f.add(0, 10);  // a[0] += 10
+    f.set(7, 0);   // a[7] = 0
+    std::cout << f.get(0) << " " << f.get(7) << " " << f.sum(0, 8) << std::endl;
+
+    f.push_back(100);
+    std::cout << f.get_length() << " " << f.prefix_sum(9) << std::endl;
+
+    // Несколько диапазонов за один вызов
+    size_t from[3] = {0, 3, 5}, to[3] = {2, 3, 9};
+    int64_t out[3];
+    f.sum(from, to, 3, out);
+    std::cout << out[0] << " " << out[1] << " " << out[2] << std::endl;
+
+    // Выбор по весам: первый элемент, на котором сумма префикса достигает 20
+    std::cout << f.lower_bound(20) << " " << (f.lower_bound(1000) == f.npos) << std::endl;
+
+    try {
+        f.sum(5, 20);
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    return 0;
+}
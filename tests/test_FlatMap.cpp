@@ -0,0 +1,34 @@
+#include <iostream>
+#include <string>
+
+#include "../FlatMap.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    int keys[] = {30, 10, 20, 10};
+    std::string values[] = {"c", "a", "b", "A"};
+    FlatMap<int, std::string> m(keys, values, 4); // из повторяющихся ключей остается последнее значение
+
+    m.insert(25, "x");
+    m[5] = "first";
+
+    int more_keys[] = {40, 20};
+    std::string more_values[] = {"d", "B"};
+    m.insert(more_keys, more_values, 2); // пакетная вставка
+
+    for(size_t i = 0; i < m.get_length(); ++i) std::cout << m.key(i) << ": " << m.value(i) << std::endl;
+
+    if(std::string* p = m.get(20)) std::cout << *p << std::endl;
+    m.remove(25);
+    std::cout << m.find(30) << " " << m.contains(25) << std::endl;
+
+    try {
+        m.at(25);
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
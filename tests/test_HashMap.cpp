@@ -0,0 +1,53 @@
+#include <iostream>
+#include <string>
+
+#include "../HashMap.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    HashMap<std::string, int> m; // пустая хэш-таблица (ключ - строка, значение - int)
+
+    m.insert("one", 1); // добавление пары (если ключ уже есть, значение перезаписывается)
+    m.insert("two", 2);
+    m["three"] = 3;     // доступ по ключу с созданием значения по умолчанию
+    m.insert("one", 11);
+
+    std::cout << m.at("one") << " " << m["three"] << " " << m.get_length() << std::endl;
+
+    if(int* p = m.get("two")) std::cout << *p << std::endl; // nullptr, если ключа нет
+    if(!m.contains("four")) std::cout << "no key" << std::endl;
+
+    m.remove("two");
+    m.try_remove("two"); // без исключения KeyError
+
+    for(auto e : m) std::cout << e.key << ": " << e.value << std::endl;
+
+    HashMap<int, int> big;
+    big.set_max_load_factor(0.75f);
+    big.reserve(1000);
+    for(int i = 0; i < 100000; ++i) big.insert(i, i * 2);
+    for(int i = 0; i < 100000; i += 2) big.remove(i);
+    for(int i = 0; i < 100000; ++i) {
+        if(big.contains(i) != (i % 2 == 1)) std::cout << "error " << i << std::endl;
+    }
+    std::cout << big.get_length() << " " << big.get_capacity() << std::endl;
+
+    HashMap<int, int> copy = big;
+    std::cout << copy.at(99999) << std::endl;
+
+    try {
+        m.at("two");
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    // После перемещения таблица пуста, но пригодна к работе
+    HashMap<std::string, int> moved = std::move(m);
+    m.clear();
+    m.insert("again", 1);
+    std::cout << m.get_length() << " " << m.contains("one") << " " << moved.at("one") << std::endl;
+    return 0;
+}
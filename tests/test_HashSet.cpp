@@ -0,0 +1,27 @@
+#include <iostream>
+
+#include "../HashSet.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    HashSet<int> s = {1, 2, 3}; // хэш-множество
+
+    s.insert(4);
+    if(!s.insert(4)) std::cout << "already exists" << std::endl; // false, если ключ уже есть
+    s.remove(1);
+
+    std::cout << s.contains(2) << " " << s.contains(1) << " " << s.get_length() << std::endl;
+
+    for(int x : s) std::cout << x << " ";
+    std::cout << std::endl;
+
+    try {
+        s.remove(100);
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
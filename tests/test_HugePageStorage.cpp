@@ -0,0 +1,37 @@
+#include <iostream>
+#include <string>
+
+#include "../Vector.cpp"
+#include "../Array.cpp"
+#include "../HugePageStorage.hpp"
+
+
+int main() {
+    using namespace siilib;
+
+    // Большой буфер выделяется через mmap с большими страницами, рост - через mremap без копирования
+    Vector<uint64_t, HugePageStorage<>> v;
+    for(uint64_t i = 0; i < 1000000; ++i) v.push_back(i);
+    std::cout << v.get_length() << " " << v[-1] << std::endl;
+    // Буфер выровнен по большой странице и после переноса через mremap
+    std::cout << (reinterpret_cast<uintptr_t>(v.begin()) % HUGEPAGE_SIZE == 0) << std::endl;
+
+    // Страницы по очереди на всех узлах NUMA (на машине с одним узлом - как обычно)
+    Array<double, InterleavedStorage> a(1 << 20);
+    a[0] = 1.5;
+    std::cout << a.get_length() << " " << a[0] << std::endl;
+
+    // Части буфера сразу размещаются потоками ThreadPool::global()
+    Vector<int, FirstTouchStorage> parts(1 << 22);
+    parts.push_back(7);
+    std::cout << parts.get_capacity() << " " << parts.back() << std::endl;
+
+    // Нетривиальные элементы тоже можно хранить, но при росте они переносятся по одному
+    Vector<std::string, HugePageStorage<>> names;
+    for(int i = 0; i < 100000; ++i) names.push_back("name " + std::to_string(i));
+    std::cout << names[99999] << std::endl;
+
+    // Небольшие буферы (меньше HUGEPAGE_THRESHOLD) выделяются как обычно
+    Vector<int, NodeStorage<0>> small{1, 2, 3};
+    std::cout << small.get_length() << std::endl;
+}
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <string>
+
+#include "../LRUCache.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    // Кэш на 3 элемента; при вытеснении печатается ключ
+    LRUCache<std::string, int> cache(3, [](const std::string& key, int& value) {
+        std::cout << "evict " << key << "=" << value << std::endl;
+    });
+
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.put("c", 3);
+    if(int* x = cache.get("a")) std::cout << *x << std::endl; // "a" становится самым свежим
+    cache.put("d", 4);                                        // вытесняется "b"
+    std::cout << cache.contains("b") << " " << cache.get_length() << std::endl;
+    if(!cache.get("b")) std::cout << "miss" << std::endl;
+
+    cache.put("c", 30); // замена значения без вытеснения
+    cache.remove("a");
+    cache.for_each([](const auto& e) { std::cout << e.key << "=" << e.value << " "; });
+    std::cout << std::endl;
+
+    const CacheCounters& c = cache.get_counters();
+    std::cout << c.hits << " " << c.misses << " " << c.evictions << " " << c.get_hit_rate() << std::endl;
+
+    try {
+        cache.at("zzz");
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    // Сегментированный LRU: сканирование новых ключей не вытесняет часто используемый
+    SLRUCache<int, int> slru(4);
+    slru.put(1, 10);
+    slru.get(1); // 1 переходит в защищенный сегмент
+    for(int i = 100; i < 110; ++i) slru.put(i, i);
+    std::cout << slru.contains(1) << " " << slru.get_length() << " " << slru.get_protected_length() << std::endl;
+
+    // Копия независима от исходного кэша: ее индекс указывает на ее собственные узлы
+    LRUCache<std::string, int>* original = new LRUCache<std::string, int>(2);
+    original->put("x", 1);
+    original->put("y", 2);
+    LRUCache<std::string, int> copy = *original;
+    SLRUCache<int, int> slru_copy(1);
+    slru_copy = slru;
+    delete original;
+    copy.get("x");
+    copy.put("z", 3); // вытесняется "y"
+    slru_copy.get(1);
+    std::cout << copy.contains("y") << " " << *copy.peek("x") << " " << slru_copy.get_protected_length() << std::endl;
+
+    // Ручки DoubleLinkedList: перестановка и удаление за O(1)
+    DoubleLinkedList<int> list = {1, 2, 3, 4};
+    DoubleLinkedList<int>::Handle h = list.next(list.front_handle()); // элемент 2
+    list.move_to_back(h);
+    list.erase(list.front_handle());
+    for(int i = 0; i < static_cast<int>(list.get_length()); ++i) std::cout << list[i] << " ";
+    std::cout << *h << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <iostream>
+
+#include "../Numeric.cpp"
+#include "../Vector.cpp"
+#include "../Array.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<float> v;
+    for(int i = 0; i < 100; ++i) v.push_back(static_cast<float>(i % 17));
+    std::cout << sum(v) << " " << min(v) << " " << max(v) << std::endl;
+    std::cout << argmin(v) << " " << argmax(v) << std::endl; // индекс первого наименьшего и наибольшего
+
+    Vector<float> ones;
+    for(int i = 0; i < 100; ++i) ones.push_back(1);
+    std::cout << dot(v, ones) << std::endl;
+    axpy(2.0f, ones, v); // v[i] += 2 * ones[i]
+    std::cout << v[0] << std::endl;
+
+    // Поэлементно на месте: с числом или с контейнером той же длины
+    Array<int> ar(8);
+    for(int i = 0; i < 8; ++i) ar[i] = i;
+    mul(ar, 3);
+    add(ar, ar);
+    sub(ar, 1);
+    std::cout << ar[7] << std::endl;
+
+    prefix_sum(ar);
+    std::cout << ar[-1] << std::endl;
+
+    // Целые переполняются по модулю - и в регистрах, и в обычных циклах; беззнаковые тоже идут через регистры
+    Vector<int64_t> big;
+    for(int i = 0; i < 7; ++i) big.push_back(INT64_MAX);
+    std::cout << sum(big) << std::endl;
+    Vector<uint64_t> deltas;
+    for(int i = 0; i < 11; ++i) deltas.push_back(i ? 1 : UINT64_MAX - 4);
+    prefix_sum(deltas);
+    std::cout << deltas[4] << " " << deltas[10] << std::endl;
+
+    try { dot(v, Vector<float>{1, 2}); }
+    catch(const ValueError&) { std::cout << "different lengths" << std::endl; }
+    try { max(Vector<double>()); }
+    catch(const EmptyError&) { std::cout << "empty" << std::endl; }
+}
@@ -34,5 +34,9 @@ int main() {
     catch(const IndexError& e) {
         std::cout << e.what() << std::endl;
     }
+    int pos = lst_int.try_find(-5); // индекс или OneLinkedList<int>::npos
+    if(int* p = lst_int.get(pos)) std::cout << *p << std::endl;
+    while(lst_int.try_pop_front()) { }
+
     return 0;
 }
@@ -0,0 +1,44 @@
+#include <iostream>
+
+#include "../PackedIntVector.cpp"
+#include "../DeltaVector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    PackedIntVector ids(20); // 20 бит на число вместо 64
+    for(uint64_t i = 0; i < 1000; ++i) ids.push_back(i * 1000);
+    std::cout << ids[999] << " " << ids.get_size() << std::endl;
+    ids.set(0, 1048575);
+    std::cout << ids.front() << " " << ids.get_max_value() << std::endl;
+    try { ids.push_back(1 << 20); }
+    catch(const ValueError&) { std::cout << "does not fit" << std::endl; }
+
+    PackedIntVector small{3, 1, 4, 1, 5}; // ширина по наибольшему значению
+    std::cout << small.get_bits() << " " << small.find(4) << " " << (small.try_find(100) == PackedIntVector::npos) << std::endl;
+
+    uint64_t out[3];
+    ids.unpack(1, 3, out);
+    std::cout << out[0] << " " << out[2] << std::endl;
+
+    // Упорядоченные значения с малыми разностями: блоки по 128 разностей фиксированной ширины
+    DeltaVector sorted;
+    for(uint64_t i = 0; i < 1000; ++i) sorted.push_back(1000000 + i * 3);
+    std::cout << sorted.get_length() << " " << sorted.get_block_count() << " " << sorted[500] << std::endl;
+    std::cout << sorted.lower_bound(1000100) << " " << sorted.contains(1000101) << " " << sorted.find(1000300) << std::endl;
+    try { sorted.find(1000101); }
+    catch(const KeyError&) { std::cout << "not found" << std::endl; }
+
+    uint64_t total = 0;
+    sorted.for_each([&](uint64_t x) { total += x; });
+    std::cout << total << std::endl;
+
+    try { sorted.push_back(5); }
+    catch(const ValueError&) { std::cout << "not sorted" << std::endl; }
+
+    // Значения выше 2^63 распаковываются в беззнаковой арифметике
+    DeltaVector large;
+    for(uint64_t i = 0; i < 256; ++i) large.push_back(UINT64_MAX / 2 - 100 + i);
+    std::cout << (large[255] == UINT64_MAX / 2 + 155) << std::endl;
+}
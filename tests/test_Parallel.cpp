@@ -0,0 +1,42 @@
+#include <iostream>
+
+#include "../Parallel.cpp"
+#include "../Vector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<long long> v;
+    for(long long i = 0; i < 1000000; ++i) v.push_back((i * 7919) % 1000003);
+
+    ThreadPool pool(4); // собственный пул из 4 потоков (вызывающий поток - один из них)
+
+    // каждая операция делит данные на части не короче grain; короткие массивы обрабатываются последовательно
+    parallel_for_each(v, [](long long& x) { x *= 2; }, 4096, pool);
+
+    long long sum = parallel_reduce(v, 0LL, [](long long a, long long b) { return a + b; }, 4096, pool);
+    std::cout << sum << std::endl;
+
+    Vector<double> halves;
+    for(size_t i = 0; i < v.get_length(); ++i) halves.push_back(0);
+    parallel_transform(v, halves, [](long long x) { return x / 2.0; }, 4096, pool);
+    std::cout << halves[10] << std::endl;
+
+    std::cout << parallel_find(v, v[12345], 4096, pool) << " " << (parallel_find(v, -1LL, 4096, pool) == Vector<long long>::npos) << std::endl;
+    std::cout << parallel_count_if(v, [](long long x) { return x % 2 == 0; }, 4096, pool) << std::endl;
+
+    parallel_sort(v, std::less<long long>(), 4096, pool);
+    std::cout << is_sorted(v) << std::endl;
+
+    parallel_sort(v, std::greater<long long>()); // общий пул ThreadPool::global()
+    std::cout << v[0] << " " << v[-1] << std::endl;
+
+    try {
+        parallel_for_each(v, [](long long& x) { if(x == 0) throw ValueError(); }, 4096, pool);
+    }
+    catch(const ValueError& e) {
+        std::cout << e.what() << std::endl; // исключение из потока пула передается вызывающему
+    }
+    return 0;
+}
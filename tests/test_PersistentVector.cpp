@@ -0,0 +1,35 @@
+#include <iostream>
+
+#include "../PersistentVector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    PersistentVector<int> v0 = {1, 2, 3};
+    PersistentVector<int> v1 = v0.push_back(4); // новая версия, v0 не меняется
+    PersistentVector<int> v2 = v1.set(0, 100);
+    PersistentVector<int> v3 = v2.pop_back();
+
+    for(const PersistentVector<int>* v : {&v0, &v1, &v2, &v3}) {
+        for(int x : *v) std::cout << x << " ";
+        std::cout << std::endl;
+    }
+
+    // Серия изменений без копирования путей
+    auto builder = v0.transient();
+    for(int i = 0; i < 10000; ++i) builder.push_back(i);
+    builder.set(-1, -1);
+    PersistentVector<int> big = builder.persistent();
+    std::cout << big.get_length() << " " << big[3] << " " << big[-1] << " " << v0.get_length() << std::endl;
+
+    std::cout << big.find(5000) << " " << big.try_find(123456) << std::endl;
+
+    try {
+        v0[3];
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
@@ -25,6 +25,10 @@ int main() {
         std::cout << e.what() << std::endl;
     }
 
+    if(!st.try_push(100.0)) std::cout << "full" << std::endl; // без исключения OverflowError
+    while(std::optional<double> x = st.try_pop()) std::cout << *x << " ";
+    std::cout << std::endl;
+
     Queue<std::string, Vector<std::string>> stv;
     stv.push("abc");
     stv.push("GDZ");
@@ -0,0 +1,42 @@
+#include <iostream>
+
+#include "../RingBuffer.cpp"
+#include "../Queue.cpp"
+#include "../Numeric.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    RingBuffer<double> window(5, true); // окно последних 8 значений: емкость округляется до степени двойки
+    for(int i = 0; i < 20; ++i) window.push_back(i * 0.5);
+    std::cout << window.get_length() << " " << window.get_capacity() << std::endl;
+    std::cout << window[0] << " " << window[-1] << std::endl; // самое старое и самое новое
+
+    // Не больше двух непрерывных частей - их можно обрабатывать как обычные массивы
+    auto [older, newer] = window.get_spans();
+    double total = sum(older.get_data(), older.get_data() + older.get_length())
+                 + sum(newer.get_data(), newer.get_data() + newer.get_length());
+    std::cout << total << std::endl;
+
+    double copy[8];
+    window.copy_to(copy);
+    std::cout << copy[7] << std::endl;
+
+    for(double x : window) std::cout << x << " ";
+    std::cout << std::endl;
+
+    // Без overwrite буфер растет, поэтому годится как контейнер Queue
+    Queue<int, RingBuffer<int>> q;
+    for(int i = 0; i < 100; ++i) q.push(i);
+    std::cout << q.pop() << " " << q.get_length() << std::endl;
+
+    // Очередь последних 4 элементов без OverflowError и без выделений памяти на элемент
+    Queue<int, RingBuffer<int>> last(RingBuffer<int>(4, true));
+    for(int i = 0; i < 10; ++i) last.push(i);
+    std::cout << last.front() << " " << last.back() << std::endl;
+
+    RingBuffer<int> empty;
+    try { empty.pop_front(); }
+    catch(const EmptyError&) { std::cout << "empty" << std::endl; }
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+
+#include "../SegmentTree.cpp"
+#include "../Vector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<int64_t> v = {5, 3, 8, 1, 9, 2, 7};
+
+    SegmentTree<int64_t> sums(v);              // сумма диапазона, изменение - прибавление к диапазону
+    SegmentTree<int64_t, MinOp<int64_t>> mins(v);
+
+    std::cout << sums.query(1, 4) << " " << mins.query(1, 4) << " " << sums.query() << std::endl;
+
+    sums.update(0, 7, 10); // +10 ко всем элементам за O(log n)
+    mins.update(0, 7, 10);
+    sums.update(3, -1);    // +(-1) к одному элементу
+    mins.update(3, -1);
+    std::cout << sums.query(0, 7) << " " << mins.query(2, 5) << " " << sums.get(3) << std::endl;
+
+    mins.set(6, -100);
+    std::cout << mins.query() << " " << mins.query(0, 6) << std::endl;
+
+    // Пакет запросов
+    size_t from[2] = {0, 4}, to[2] = {3, 7};
+    int64_t out[2];
+    mins.query(from, to, 2, out);
+    std::cout << out[0] << " " << out[1] << std::endl;
+
+    // Пустой диапазон - нейтральный элемент операции
+    SegmentTree<double, MaxOp<double>> maxs(4, 0.5);
+    std::cout << maxs.query(2, 2) << " " << maxs.query(0, 4) << std::endl;
+
+    try {
+        sums.query(3, 100);
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    return 0;
+}
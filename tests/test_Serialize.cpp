@@ -0,0 +1,97 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+
+#include <sys/mman.h>
+
+#include "../Vector.cpp"
+#include "../Array.cpp"
+#include "../OneLinkedList.cpp"
+#include "../DoubleLinkedList.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<int> v{1, 2, 3, 4, 5};
+    OneLinkedList<std::string> names{"one", "two", "three"};
+
+    std::stringstream stream;
+    v.save(stream);     // заголовок и все элементы одним блоком
+    names.save(stream); // строки - длина и байты
+
+    Vector<int> v2 = Vector<int>::load(stream);
+    OneLinkedList<std::string> names2 = OneLinkedList<std::string>::load(stream);
+    std::cout << v2.get_length() << " " << v2[4] << " " << names2[2] << std::endl;
+
+    try { Vector<double>::load(stream); }
+    catch(const FormatError&) { std::cout << "no more data" << std::endl; }
+
+    // Заголовок с невозможной длиной
+    std::stringstream corrupt;
+    Vector<int>().save(corrupt);
+    std::string bytes = corrupt.str();
+    for(int i = 16; i < 24; ++i) bytes[i] = static_cast<char>(0xFF);
+    std::stringstream corrupt2(bytes);
+    try { Vector<int>::load(corrupt2); }
+    catch(const FormatError&) { std::cout << "corrupt length" << std::endl; }
+
+    std::stringstream wrong;
+    v.save(wrong);
+    try { Array<double>::load(wrong); }
+    catch(const TypeError&) { std::cout << "other element type" << std::endl; }
+
+    // Тот же размер, другой вид: int64_t и double, int и unsigned
+    std::stringstream same_size;
+    Vector<int64_t>{1, 2}.save(same_size);
+    Vector<int>{3}.save(same_size);
+    try { Vector<double>::load(same_size); }
+    catch(const TypeError&) { std::cout << "integer is not double" << std::endl; }
+    std::stringstream same_size2(same_size.str().substr(sizeof(SerialHeader) + 2 * sizeof(int64_t)));
+    try { Vector<unsigned>::load(same_size2); }
+    catch(const TypeError&) { std::cout << "signed is not unsigned" << std::endl; }
+
+    // Строка с поврежденной длиной: конец данных, а не попытка выделить память под всю длину
+    std::stringstream long_string;
+    Vector<std::string>{"abc"}.save(long_string);
+    bytes = long_string.str();
+    for(int i = 24; i < 31; ++i) bytes[i] = static_cast<char>(0xFF);
+    bytes[31] = 0x0F;
+    std::stringstream long_string2(bytes);
+    try { Vector<std::string>::load(long_string2); }
+    catch(const FormatError&) { std::cout << "corrupt string length" << std::endl; }
+
+    // Файловый дескриптор: запись через writev, чтение через read
+    FILE* file = std::tmpfile();
+    int fd = fileno(file);
+    DoubleLinkedList<double> list{0.5, 1.5, 2.5};
+    list.save(fd);
+    lseek(fd, 0, SEEK_SET);
+    std::cout << DoubleLinkedList<double>::load(fd).back() << std::endl;
+
+    // Чтение на месте: элементы не копируются, представление указывает в отображенный файл
+    Array<int> squares(1000);
+    for(int i = 0; i < 1000; ++i) squares[i] = i * i;
+    ftruncate(fd, 0);
+    lseek(fd, 0, SEEK_SET);
+    squares.save(fd);
+    size_t size = lseek(fd, 0, SEEK_END);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ConstSpan<int> view = load_view<int>(mapped, size);
+    std::cout << view.get_length() << " " << view[999] << std::endl;
+    munmap(mapped, size);
+
+    // Больше SERIALIZE_IOV блоков за пакет: короткие строки копируются в буфер, длинные пишутся с места
+    Vector<std::string> words;
+    for(int i = 0; i < 1000; ++i) words.push_back(std::string((i * 7919) % 2000, static_cast<char>('a' + i % 26)));
+    ftruncate(fd, 0);
+    lseek(fd, 0, SEEK_SET);
+    words.save(fd);
+    lseek(fd, 0, SEEK_SET);
+    Vector<std::string> words2 = Vector<std::string>::load(fd);
+    bool same = words2.get_length() == words.get_length();
+    for(size_t i = 0; same && i < words.get_length(); ++i) same = words2.begin()[i] == words.begin()[i];
+    std::cout << same << std::endl;
+    std::fclose(file);
+}
@@ -0,0 +1,58 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../SlotMap.cpp"
+
+
+// Копирование бросает исключение, пока fail == true
+struct Fragile {
+    static bool fail;
+    std::string s;
+
+    Fragile() = default;
+    Fragile(const char* s) : s(s) { }
+    Fragile(const Fragile& right) : s(right.s) { if(fail) throw std::runtime_error("copy failed"); }
+    Fragile& operator=(const Fragile& right) {
+        if(fail) throw std::runtime_error("copy failed");
+        s = right.s;
+        return *this;
+    }
+};
+bool Fragile::fail = false;
+
+
+int main() {
+    using namespace siilib;
+
+    SlotMap<std::string> names;
+    SlotHandle a = names.insert("alpha");
+    SlotHandle b = names.insert("beta");
+    SlotHandle c = names.insert("gamma");
+    std::cout << names.at(b) << " " << names.get_length() << std::endl;
+
+    names.remove(a); // последнее значение переносится на место удаленного
+    std::cout << names.at(c) << " " << names.contains(a) << std::endl;
+
+    // Ручка удаленного элемента не действует, даже если ее ячейка снова занята
+    SlotHandle d = names.insert("delta");
+    std::cout << d.index << " " << (names.get(a) == nullptr) << " " << names.try_remove(a) << std::endl;
+    try { names.at(a); }
+    catch(const KeyError&) { std::cout << "stale handle" << std::endl; }
+
+    // Значения лежат подряд
+    for(const std::string& name : names) std::cout << name << " ";
+    std::cout << std::endl;
+    std::cout << names.at(names.get_handle(0)) << std::endl;
+
+    // Неудачная вставка ничего не меняет: свободная ячейка остается в списке и занимается следующей вставкой
+    SlotMap<Fragile> fragile;
+    fragile.remove(fragile.insert("x"));
+    Fragile value("y");
+    Fragile::fail = true;
+    try { fragile.insert(value); }
+    catch(const std::runtime_error&) { std::cout << "copy failed: " << fragile.get_length() << std::endl; }
+    Fragile::fail = false;
+    SlotHandle y = fragile.insert(value);
+    std::cout << fragile.get_length() << " " << fragile.get_capacity() << " " << fragile.at(y).s << std::endl;
+}
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <string>
+
+#include "../SoAVector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    // Каждое поле - отдельный столбец: id, имя, цена
+    SoAVector<int, std::string, double> items;
+    items.push_back({1, "apple", 0.5});
+    items.emplace_back(2, "pear", 0.75);
+    items.emplace_back(3, "plum", 1.25);
+    items.emplace_back(4, "kiwi", 2.0);
+
+    auto [id, name, price] = items[1]; // строка - кортеж ссылок
+    price *= 2;
+    std::cout << id << " " << name << " " << std::get<2>(items[1]) << std::endl;
+
+    // Просмотр одного столбца без остальных полей
+    double total = 0;
+    for(double p : items.column<2>()) total += p;
+    std::cout << total << std::endl;
+
+    items.swap_erase(0); // на место первой строки встает последняя
+    for(int i = 0; i < static_cast<int>(items.get_length()); ++i) std::cout << std::get<1>(items[i]) << " ";
+    std::cout << std::endl;
+
+    auto last = items.pop_back();
+    std::cout << std::get<1>(last) << " " << items.get_length() << std::endl;
+
+    try {
+        items[10];
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
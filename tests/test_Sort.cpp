@@ -0,0 +1,49 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "../Sort.cpp"
+#include "../Vector.cpp"
+#include "../Array.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<int> v = {5, -3, 8, 1, 0, 7};
+    sort(v); // pattern-defeating quicksort (для больших массивов чисел - поразрядная сортировка)
+    for(int x : v) std::cout << x << " ";
+    std::cout << std::endl;
+
+    sort(v, std::greater<int>()); // сортировка с компаратором
+    std::cout << v[0] << " " << is_sorted(v, std::greater<int>()) << std::endl;
+
+    Array<std::string> ar = {"pear", "apple", "fig", "kiwi"};
+    stable_sort(ar, [](const std::string& a, const std::string& b) { return a.size() < b.size(); });
+    for(const std::string& s : ar) std::cout << s << " ";
+    std::cout << std::endl;
+
+    Array<double> d = {3.5, -1.25, 9.0, 0.5, -7.0};
+    partial_sort(d, 2); // два наименьших элемента в начале массива
+    std::cout << d[0] << " " << d[1] << std::endl;
+
+    Vector<long long> keys = {30, -10, 20, -10};
+    Vector<char> values = {'c', 'a', 'b', 'z'};
+    radix_sort(keys, values); // поразрядная сортировка пар "ключ-значение" (устойчивая)
+    for(size_t i = 0; i < keys.get_length(); ++i) std::cout << keys[i] << ":" << values[i] << " ";
+    std::cout << std::endl;
+
+    // stable_sort сохраняет порядок равных 0.0 и -0.0 и на больших массивах
+    Vector<double> zeros;
+    for(int i = 0; i < 2000; ++i) zeros.push_back(i % 2 ? -0.0 : 0.0);
+    stable_sort(zeros);
+    std::cout << std::signbit(zeros[0]) << std::signbit(zeros[1]) << std::endl;
+
+    try {
+        partial_sort(d, 10);
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
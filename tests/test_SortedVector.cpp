@@ -0,0 +1,34 @@
+#include <iostream>
+
+#include "../SortedVector.cpp"
+#include "../FlatSet.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    int raw[] = {9, 2, 7, 2, 5};
+    SortedVector<int> sv(raw, 5); // построение из неупорядоченных данных (одна сортировка)
+
+    sv.insert(4);
+    int batch[] = {8, 1, 2};
+    sv.insert(batch, 3); // пакетная вставка слиянием за один проход
+
+    for(int x : sv) std::cout << x << " ";
+    std::cout << std::endl;
+    std::cout << sv.count(2) << " " << sv.find(7) << " " << sv.lower_bound(6) << std::endl;
+
+    FlatSet<int> fs = {3, 1, 3, 2}; // повторы удаляются
+    fs.insert(batch, 3);
+    for(int x : fs) std::cout << x << " ";
+    std::cout << std::endl;
+    std::cout << fs.contains(8) << " " << fs.try_find(100) << std::endl;
+
+    try {
+        sv.remove(100);
+    }
+    catch(const KeyError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
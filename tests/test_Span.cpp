@@ -0,0 +1,49 @@
+#include <iostream>
+
+#include "../Span.cpp"
+#include "../Vector.cpp"
+#include "../Array.cpp"
+
+
+// Функция принимает часть контейнера без копирования
+int sum(siilib::ConstSpan<int> s) {
+    int res = 0;
+    for(int x : s) res += x;
+    return res;
+}
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<int> v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    Span<int> s(v);
+
+    std::cout << s[0] << " " << s[-1] << " " << s.get_length() << std::endl;
+    std::cout << sum(s.slice(2, -2)) << std::endl; // 2 + ... + 7
+
+    Span<int> evens = s.slice(0, 10, 2);
+    for(int& x : evens) x *= 10; // изменения видны в v
+    for(int x : v) std::cout << x << " ";
+    std::cout << std::endl;
+
+    for(int x : s.slice(-1, -11, -3)) std::cout << x << " "; // шаг назад, как v[-1:-11:-3] в Python
+    std::cout << std::endl;
+
+    std::cout << s.find(7) << " " << s.subspan(3, 4).try_find(1) << " " << evens.rfind(80) << std::endl;
+
+    Array<int> a = {5, 6, 7};
+    ConstSpan<int> ca(a);
+    std::cout << sum(ca) << " " << ca.reversed()[0] << std::endl;
+
+    int raw[] = {1, 2, 3};
+    std::cout << sum(raw) << std::endl;
+
+    try {
+        s.subspan(8, 5);
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
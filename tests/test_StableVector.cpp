@@ -0,0 +1,38 @@
+#include <iostream>
+#include <string>
+
+#include "../StableVector.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    StableVector<std::string> names;
+    std::string& first = names.push_back("alpha");
+    for(int i = 0; i < 1000; ++i) names.push_back("name" + std::to_string(i));
+
+    // После тысячи вставок ссылка на первый элемент все еще действительна
+    first += "!";
+    std::cout << names[0] << " " << names[-1] << " " << names.get_length() << std::endl;
+
+    std::cout << names.find("name500") << " " << names.try_find("missing") << std::endl;
+
+    // Поблочный обход: блоки растут как 16, 32, 64, ...
+    for(size_t b = 0; b < names.get_chunk_count(); ++b) std::cout << names.chunk(b).get_length() << " ";
+    std::cout << std::endl;
+
+    size_t total = 0;
+    for(const std::string& s : names) total += s.size();
+    std::cout << total << std::endl;
+
+    while(names.get_length() > 1) names.pop_back();
+    std::cout << names.back() << " " << names.get_capacity() << std::endl;
+
+    try {
+        names[5];
+    }
+    catch(const IndexError& e) {
+        std::cout << e.what() << std::endl;
+    }
+    return 0;
+}
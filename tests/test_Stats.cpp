@@ -0,0 +1,40 @@
+#define SIILIB_STATS // счетчики включаются до подключения контейнеров (или флагом -DSIILIB_STATS)
+
+#include <iostream>
+
+#include "../Vector.cpp"
+#include "../HashMap.cpp"
+#include "../BTreeMap.cpp"
+
+
+int main() {
+    using namespace siilib;
+
+    Vector<int> v;
+    for(int i = 0; i < 1000; ++i) v.push_back(i);
+    v.push_front(-1); // сдвиг всех элементов учитывается в moved
+
+    // выделения памяти, перераспределения, перемещенные и скопированные элементы
+    std::cout << v.get_stats().to_json() << std::endl;
+
+    Vector<int> copy(v); // копия начинает счет с нуля
+    std::cout << copy.get_stats().copied << std::endl;
+
+    v.reset_stats();
+    std::cout << v.get_stats().allocations << std::endl;
+
+    HashMap<int, int> m;
+    for(int i = 0; i < 1000; ++i) m.insert(i, i);
+    std::cout << m.get_stats().reallocations << " " << m.get_stats().peak_bytes << std::endl;
+
+    BTreeMap<int, int> t;
+    for(int i = 0; i < 1000; ++i) t.insert(i, i);
+    std::cout << t.get_stats().allocations - t.get_stats().frees << std::endl; // число узлов дерева
+
+    try { v[5000]; }
+    catch(const IndexError&) { }
+
+    // сумма по всем контейнерам программы, включая число выброшенных исключений
+    std::cout << global_stats().snapshot().to_json() << std::endl;
+    global_stats().reset();
+}
@@ -83,5 +83,12 @@ int main() {
         std::cout << e.what() << std::endl;
     } 
 
+    // не бросающие исключений аналоги
+    if(ar_d.try_find(1000) == Vector<short>::npos) std::cout << "not found" << std::endl;
+    if(short* p = ar_d.get(-1)) std::cout << *p << std::endl;
+    if(!ar_d.get(100)) std::cout << "bad index" << std::endl;
+    while(std::optional<short> x = ar_d.try_pop_back()) std::cout << *x << " ";
+    std::cout << std::endl;
+
     return 0;
 }